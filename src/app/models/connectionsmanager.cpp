@@ -392,6 +392,8 @@ void ConnectionsManager::createServerItemForConnection(
 
             emit connectionAboutToBeEdited(treeModel->config().name());
 
+            treeModel->removeKeysCache();
+
             if (group) {
               group->removeConnection(serverItem);
             } else {
@@ -5,7 +5,11 @@
 #include <QCoreApplication>
 #include <QDebug>
 
+#include <QHash>
+#include <QMap>
 #include <QPair>
+#include <QSet>
+#include <QSettings>
 #include <QSharedPointer>
 #include <QString>
 #include <QVariant>
@@ -28,8 +32,20 @@ class KeyModel : public ValueEditor::Model {
         m_isMultiRow(!rowsCountCmd.isEmpty()),
         m_rowsCountCmd(rowsCountCmd),
         m_rowsLoadCmd(rowsLoadCmd),
-        m_scanCursor(0),
-        m_notifier(new ValueEditor::ModelSignals(), &QObject::deleteLater) {}
+        m_matchGeneration(0),
+        m_matchedRowsMemory(0),
+        m_notifier(new ValueEditor::ModelSignals(), &QObject::deleteLater) {
+    QSettings settings;
+    m_rowsCache.setMemoryLimit(
+        settings.value("app/valueEditorCacheMemory", 256).toLongLong() * 1024 *
+        1024);
+
+    // Collections loaded with SCAN are filtered with MATCH by the server
+    if (m_rowsLoadCmd.mid(1, 4).toLower() == "scan")
+      m_rowsMatchCmd = m_rowsLoadCmd;
+
+    resetScanCheckpoints();
+  }
 
   virtual QString getKeyName() override {
     return printableString(m_keyFullPath);
@@ -58,6 +74,8 @@ class KeyModel : public ValueEditor::Model {
     return m_rowsCache.isRowLoaded(rowIndex);
   }
 
+  virtual QObject* getStreamedValue(int) override { return nullptr; }
+
   virtual unsigned long rowsCount() override {
     if (isMultiRow())
       return m_rowCount;
@@ -146,45 +164,13 @@ class KeyModel : public ValueEditor::Model {
 
   virtual void loadRows(QVariant rowStart, unsigned long count,
                         LoadRowsCallback callback) override {
-    if (m_rowsLoadCmd.mid(1, 4).toLower() == "scan") {
-      QList<QByteArray> cmdParts = {m_rowsLoadCmd, m_keyFullPath,
-                                    QString::number(m_scanCursor).toLatin1(),
-                                    "COUNT", QString::number(count).toLatin1()};
-
-      auto self = ValueEditor::Model::sharedFromThis().toWeakRef();
-
-      m_connection->cmd(
-          cmdParts, m_notifier.data(), -1,
-          [this, callback, rowStart, self](RedisClient::Response r) {
-            if (!r.isValidScanResponse()) {
-              callback(QCoreApplication::translate(
-                           "RESP", "Cannot parse scan response"),
-                       0);
-              return;
-            }
-
-            if (r.getCursor() > 0) {
-              m_scanCursor = r.getCursor();
-            }
+    if (isScanLoaded()) {
+      RowIndex start = rowStart.toLongLong();
 
-            try {
-              unsigned long addedRows =
-                  addLoadedRowsToCache(r.getCollection(), rowStart);
-              callback(QString(), addedRows);
-            } catch (const std::runtime_error& e) {
-              callback(QString(e.what()), 0);
-            }
-          },
-          [self, callback](QString err) {
-            if (!self) {
-              return;
-            }
-
-            return callback(
-                QCoreApplication::translate("RESP", "Connection error: ") + err,
-                0);
-          });
+      // Checkpoint of the first row always exists
+      auto checkpoint = m_scanCheckpoints.upperBound(start) - 1;
 
+      scanRows(checkpoint.key(), checkpoint.value(), start, count, callback);
     } else {
       getRowsRange(
           getRangeCmd(rowStart, count),
@@ -197,8 +183,17 @@ class KeyModel : public ValueEditor::Model {
     }
   }
 
+  // NOTE: SCAN checkpoints are kept, reloaded pages are loaded directly
   virtual void clearRowCache() override { m_rowsCache.clear(); }
 
+  virtual qint64 rowsCacheMemory() override {
+    return m_rowsCache.usedMemory() + m_matchedRowsMemory;
+  }
+
+  virtual qint64 rowsCacheMemoryLimit() override {
+    return m_rowsCache.memoryLimit();
+  }
+
   virtual QSharedPointer<ValueEditor::ModelSignals> getConnector()
       const override {
     return m_notifier;
@@ -225,10 +220,17 @@ class KeyModel : public ValueEditor::Model {
       return c(QString());
     }
 
+    if (isMatchFiltered()) return scanMatches(c);
+
     executeCmd(
         {m_rowsCountCmd, m_keyFullPath}, c,
         [this](RedisClient::Response r, Callback c) {
-          m_rowCount = r.value().toUInt();
+          unsigned long rowCount = r.value().toUInt();
+
+          // Offsets of SCAN checkpoints are stale if the key was modified
+          if (rowCount != m_rowCount) resetScanCheckpoints();
+
+          m_rowCount = rowCount;
           c(QString());
         },
         RedisClient::Response::Type::Integer);
@@ -236,6 +238,259 @@ class KeyModel : public ValueEditor::Model {
 
  protected:
   // multi row internal operations
+  bool isScanLoaded() const {
+    return isMatchFiltered() || m_rowsLoadCmd.mid(1, 4).toLower() == "scan";
+  }
+
+  QByteArray matchPattern() const {
+    if (m_rowsMatchCmd.isEmpty()) return QByteArray();
+
+    return m_filters.value("match").toByteArray();
+  }
+
+  bool isMatchFiltered() const { return !matchPattern().isEmpty(); }
+
+  QList<QByteArray> getScanCmd(long long cursor, RowIndex count) const {
+    QList<QByteArray> cmd;
+
+    if (isMatchFiltered()) {
+      cmd << m_rowsMatchCmd << m_keyFullPath
+          << QString::number(cursor).toLatin1() << "MATCH" << matchPattern();
+    } else {
+      cmd << m_rowsLoadCmd << m_keyFullPath
+          << QString::number(cursor).toLatin1();
+    }
+
+    cmd << "COUNT" << QString::number(count).toLatin1();
+    return cmd;
+  }
+
+  // Amount of items in SCAN response which form a row
+  virtual int scanItemsPerRow() const { return 2; }
+
+  // Continues SCAN from the checkpoint at the offset until rows of the
+  // frame starting at rowStart are loaded. Rows before the frame are
+  // loaded in bigger batches and cached too.
+  void scanRows(RowIndex offset, long long cursor, RowIndex rowStart,
+                unsigned long count, LoadRowsCallback callback) {
+    // COUNT limits scanned elements, not matched ones
+    RowIndex batch =
+        isMatchFiltered()
+            ? MAX_SCAN_COUNT
+            : qMin<RowIndex>(rowStart - offset + static_cast<RowIndex>(count),
+                             MAX_SCAN_COUNT);
+
+    auto self = ValueEditor::Model::sharedFromThis().toWeakRef();
+
+    m_connection->cmd(
+        getScanCmd(cursor, batch), m_notifier.data(), -1,
+        [this, callback, offset, rowStart, count,
+         self](RedisClient::Response r) {
+          if (!r.isValidScanResponse()) {
+            callback(QCoreApplication::translate(
+                         "RESP", "Cannot parse scan response"),
+                     0);
+            return;
+          }
+
+          RowIndex nextOffset = offset;
+
+          // Pages reloaded after eviction skip duplicates like the MATCH
+          // scan did, so rows keep their positions
+          QVariantList rows = isMatchFiltered()
+                                  ? takeNewMatches(r.getCollection(), offset)
+                                  : r.getCollection();
+
+          try {
+            if (rows.size() > 0)
+              nextOffset += addLoadedRowsToCache(rows, offset);
+          } catch (const std::runtime_error& e) {
+            callback(QString(e.what()), 0);
+            return;
+          }
+
+          long long nextCursor = r.getCursor();
+
+          if (nextCursor > 0) m_scanCheckpoints[nextOffset] = nextCursor;
+
+          if (nextOffset > rowStart || nextCursor == 0) {
+            return callback(QString(),
+                            qMax<RowIndex>(0, nextOffset - rowStart));
+          }
+
+          scanRows(nextOffset, nextCursor, rowStart, count, callback);
+        },
+        [self, callback](QString err) {
+          if (!self) {
+            return;
+          }
+
+          return callback(
+              QCoreApplication::translate("RESP", "Connection error: ") + err,
+              0);
+        });
+  }
+
+  void resetScanCheckpoints() {
+    m_scanCheckpoints.clear();
+    m_scanCheckpoints.insert(0, 0);
+  }
+
+  // Scans the whole collection with MATCH and appends new matches to the
+  // cache. The callback is called once the first matches are loaded, every
+  // scanned batch is reported with ModelSignals::matchesLoaded().
+  void scanMatches(Callback c) {
+    int generation = ++m_matchGeneration;
+
+    m_rowCount = 0;
+    m_rowsCache.clear();
+    clearMatchedRows();
+    resetScanCheckpoints();
+
+    executeCmd(
+        {m_rowsCountCmd, m_keyFullPath}, c,
+        [this, generation](RedisClient::Response r, Callback c) {
+          if (generation != m_matchGeneration) return;
+
+          scanMatchesBatch(0, r.value().toLongLong(), 0, generation, c);
+        },
+        RedisClient::Response::Type::Integer);
+  }
+
+  void scanMatchesBatch(long long cursor, qlonglong collectionSize,
+                        qlonglong scanned, int generation, Callback c) {
+    auto self = ValueEditor::Model::sharedFromThis().toWeakRef();
+
+    auto onError = [this, c](const QString& err) {
+      if (c) return c(err);
+
+      emit m_notifier->error(err);
+    };
+
+    m_connection->cmd(
+        getScanCmd(cursor, MAX_SCAN_COUNT), m_notifier.data(), -1,
+        [this, self, collectionSize, scanned, generation, c,
+         onError](RedisClient::Response r) {
+          if (!self || generation != m_matchGeneration) return;
+
+          if (!r.isValidScanResponse()) {
+            return onError(QCoreApplication::translate(
+                "RESP", "Cannot parse scan response"));
+          }
+
+          QVariantList matches = takeNewMatches(r.getCollection(), m_rowCount);
+
+          try {
+            if (matches.size() > 0)
+              m_rowCount += addLoadedRowsToCache(matches, m_rowCount);
+          } catch (const std::runtime_error& e) {
+            return onError(QString(e.what()));
+          }
+
+          long long nextCursor = r.getCursor();
+
+          if (nextCursor > 0) m_scanCheckpoints[m_rowCount] = nextCursor;
+
+          // SCAN examines about COUNT elements per call
+          qlonglong nextScanned = scanned + MAX_SCAN_COUNT;
+          double progress =
+              nextCursor == 0
+                  ? 1.0
+                  : qMin(0.99, static_cast<double>(nextScanned) /
+                                   qMax<qlonglong>(collectionSize, 1));
+
+          emit m_notifier->matchesLoaded(progress);
+
+          Callback next = c;
+
+          if (next && (m_rowCount > 0 || nextCursor == 0)) {
+            next(QString());
+            next = Callback();
+          }
+
+          if (nextCursor == 0) return;
+
+          scanMatchesBatch(nextCursor, collectionSize, nextScanned, generation,
+                           next);
+        },
+        [self, onError](QString err) {
+          if (!self) return;
+
+          onError(QCoreApplication::translate("RESP", "Connection error: ") +
+                  err);
+        });
+  }
+
+  // SCAN may return an element more than once. Members are kept with the
+  // row of their first occurrence, items placed at offset are skipped if
+  // the member is shown in another row.
+  QVariantList takeNewMatches(const QVariantList& items, RowIndex offset) {
+    QVariantList result;
+    int itemsPerRow = scanItemsPerRow();
+    RowIndex row = offset;
+
+    for (int i = 0; i + itemsPerRow <= items.size(); i += itemsPerRow) {
+      QByteArray member = items.at(i).toByteArray();
+      auto matched = m_matchedRows.constFind(member);
+
+      if (matched != m_matchedRows.constEnd() && matched.value() != row)
+        continue;
+
+      if (matched == m_matchedRows.constEnd()) {
+        m_matchedRows.insert(member, row);
+        m_matchedRowsMemory += matchedRowMemory(member);
+      }
+
+      for (int item = i; item < i + itemsPerRow; item++)
+        result.append(items.at(item));
+
+      row++;
+    }
+
+    m_rowsCache.setReservedMemory(m_matchedRowsMemory);
+    return result;
+  }
+
+  static qint64 matchedRowMemory(const QByteArray& member) {
+    // Hash node with the key, row index and bucket pointer
+    return RowCacheMemory::estimate(member) + sizeof(QByteArray) +
+           sizeof(RowIndex) + 3 * sizeof(void*);
+  }
+
+  void clearMatchedRows() {
+    m_matchedRows.clear();
+    m_matchedRowsMemory = 0;
+    m_rowsCache.setReservedMemory(0);
+  }
+
+  // Following rows, SCAN checkpoints and matched rows are shifted
+  void removeCachedRow(RowIndex index) {
+    m_rowsCache.removeAt(index);
+
+    for (auto it = m_matchedRows.begin(); it != m_matchedRows.end();) {
+      if (it.value() == index) {
+        m_matchedRowsMemory -= matchedRowMemory(it.key());
+        it = m_matchedRows.erase(it);
+        continue;
+      }
+
+      if (it.value() > index) it.value()--;
+      ++it;
+    }
+
+    m_rowsCache.setReservedMemory(m_matchedRowsMemory);
+
+    QMap<RowIndex, long long> checkpoints;
+
+    for (auto it = m_scanCheckpoints.constBegin();
+         it != m_scanCheckpoints.constEnd(); ++it) {
+      checkpoints.insert(it.key() > index ? it.key() - 1 : it.key(),
+                         it.value());
+    }
+
+    m_scanCheckpoints = checkpoints;
+  }
+
   virtual QList<QByteArray> getRangeCmd(QVariant rowStartId,
                                         unsigned long count) {
     QList<QByteArray> cmd;
@@ -350,6 +605,14 @@ class KeyModel : public ValueEditor::Model {
   };
 
   void setFilter(const QString& k, QVariant v) override {
+      if (k == "match" && m_filters.value(k) != v) {
+        // Rows and checkpoints of the previous pattern are stale
+        m_matchGeneration++;
+        clearMatchedRows();
+        m_rowsCache.clear();
+        resetScanCheckpoints();
+      }
+
       m_filters[k] = v;
       qDebug() << "filter:" << k << v;
   }
@@ -365,9 +628,24 @@ class KeyModel : public ValueEditor::Model {
   // CMD strings
   QByteArray m_rowsCountCmd;
   QByteArray m_rowsLoadCmd;
+  QByteArray m_rowsMatchCmd;
+
+  PagedRowCache<T> m_rowsCache;
+
+  // SCAN cursor which continues the scan from the row offset
+  QMap<RowIndex, long long> m_scanCheckpoints;
+
+  // Rows before the requested page are scanned in batches of this size
+  static const int MAX_SCAN_COUNT = 10000;
+
+  // Running MATCH scan is abandoned when the generation is changed
+  int m_matchGeneration;
+
+  // Row of each member matched by the MATCH scan, the index shares the
+  // memory limit with the rows cache
+  QHash<QByteArray, RowIndex> m_matchedRows;
+  qint64 m_matchedRowsMemory;
 
-  MappedCache<T> m_rowsCache;
-  long long m_scanCursor;
   QSharedPointer<ValueEditor::ModelSignals> m_notifier;
 
   QVariantMap m_filters;
@@ -52,8 +52,14 @@ void HashKeyModel::updateRow(int rowIndex, const QVariantMap &row, Callback c) {
       (keyChanged) ? row["key"].toByteArray() : cachedRow.first,
       (valueChanged) ? row["value"].toByteArray() : cachedRow.second);
 
-  auto afterValueUpdate = [this, c, rowIndex, newRow](const QString &err) {
-    if (err.isEmpty()) m_rowsCache.replace(rowIndex, newRow);
+  auto afterValueUpdate = [this, c, rowIndex, newRow,
+                           keyChanged](const QString &err) {
+    if (err.isEmpty()) {
+      m_rowsCache.replace(rowIndex, newRow);
+
+      // Renamed field may be returned by SCAN at another position
+      if (keyChanged) resetScanCheckpoints();
+    }
 
     return c(err);
   };
@@ -79,7 +85,10 @@ void HashKeyModel::addRow(const QVariantMap &row, Callback c) {
   setHashRow(
       row["key"].toByteArray(), row["value"].toByteArray(),
       [this, c](const QString &err) {
-        if (err.isEmpty()) m_rowCount++;
+        if (err.isEmpty()) {
+          m_rowCount++;
+          resetScanCheckpoints();
+        }
         return c(err);
       },
       false);
@@ -93,7 +102,7 @@ void HashKeyModel::removeRow(int i, Callback c) {
   deleteHashRow(row.first, [this, i, c](const QString &err) {
     if (err.isEmpty()) {
       m_rowCount--;
-      m_rowsCache.removeAt(i);
+      removeCachedRow(i);
       setRemovedIfEmpty();
     }
 
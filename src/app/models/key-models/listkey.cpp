@@ -55,7 +55,7 @@ void ListKeyModel::removeRow(int i, ValueEditor::Model::Callback c) {
   auto onItemRemoval = [this, c, i](const QString &err) {
     if (err.isEmpty()) {
       m_rowCount--;
-      m_rowsCache.removeAt(i);
+      removeCachedRow(i);
       setRemovedIfEmpty();
     };
 
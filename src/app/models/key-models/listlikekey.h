@@ -17,4 +17,6 @@ class ListLikeKeyModel : public KeyModel<QByteArray> {
  protected:
   int addLoadedRowsToCache(const QVariantList& rows,
                            QVariant rowStart) override;
+
+  int scanItemsPerRow() const override { return 1; }
 };
@@ -1,8 +1,13 @@
 #pragma once
-#include <QHash>
+#include <QBitArray>
+#include <QByteArray>
 #include <QList>
 #include <QPair>
-#include <exception>
+#include <QSharedPointer>
+#include <QVariant>
+#include <QVector>
+#include <algorithm>
+#include <stdexcept>
 
 typedef qlonglong RowIndex;
 
@@ -14,99 +19,303 @@ class CacheRange : public QPair<RowIndex, RowIndex> {
   bool isEmpty() const { return first == -1 && second == -1; }
 };
 
+namespace RowCacheMemory {
+
+// Heap memory owned by the row, size of the row itself is counted by page
+const qint64 ARRAY_HEADER_BYTES = 24;
+
+inline qint64 estimate(const QByteArray& row) {
+  return row.isNull() ? 0 : ARRAY_HEADER_BYTES + row.size();
+}
+
+inline qint64 estimate(const QVariant& row) {
+  switch (row.type()) {
+    case QVariant::ByteArray:
+      return estimate(row.toByteArray());
+    case QVariant::String:
+      return ARRAY_HEADER_BYTES + row.toString().size() * 2;
+    case QVariant::List: {
+      qint64 result = ARRAY_HEADER_BYTES;
+      for (const auto& item : row.toList())
+        result += sizeof(QVariant) + estimate(item);
+      return result;
+    }
+    case QVariant::Map: {
+      qint64 result = ARRAY_HEADER_BYTES;
+      const auto map = row.toMap();
+      for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+        result += ARRAY_HEADER_BYTES + it.key().size() * 2 + sizeof(QVariant) +
+                  estimate(it.value());
+      return result;
+    }
+    default:
+      return 0;
+  }
+}
+
+template <typename F, typename S>
+qint64 estimate(const QPair<F, S>& row) {
+  return estimate(row.first) + estimate(row.second);
+}
+
+}  // namespace RowCacheMemory
+
+/*
+ * Rows of a key value split into pages of PAGE_ROWS rows. The page table is
+ * indexed by row number, so lookup of a row costs O(1). When used memory
+ * exceeds the limit least recently used pages are evicted, rows of evicted
+ * pages are reported as not loaded and are loaded again by the view.
+ */
 template <typename T>
-class MappedCache {
+class PagedRowCache {
  public:
-  MappedCache() : m_valid(false) {}
+  static const int PAGE_SHIFT = 8;
+  static const RowIndex PAGE_ROWS = 1 << PAGE_SHIFT;
+
+ public:
+  // Zero memory limit disables eviction
+  explicit PagedRowCache(qint64 memoryLimit = 0)
+      : m_memoryLimit(memoryLimit),
+        m_usedMemory(0),
+        m_reservedMemory(0),
+        m_rowsCount(0),
+        m_lastRow(-1),
+        m_clock(0),
+        m_valid(false) {}
 
   bool isValid() const { return m_valid; }
 
+  void setMemoryLimit(qint64 limit) {
+    m_memoryLimit = limit;
+    evict(CacheRange());
+  }
+
+  qint64 memoryLimit() const { return m_memoryLimit; }
+
+  qint64 usedMemory() const { return m_usedMemory; }
+
+  // Memory used outside of the cache by indexes of the cached rows, it
+  // shares the limit with rows and is reclaimed when next range is loaded
+  void setReservedMemory(qint64 bytes) { m_reservedMemory = bytes; }
+
   void addLoadedRange(const CacheRange& range, const QList<T>& dataForRange) {
     if (!isValid()) clear();
 
-    m_mapping[range] = dataForRange;
+    for (int i = 0; i < dataForRange.size(); i++) {
+      setRow(range.first + i, dataForRange.at(i));
+    }
+
+    // Pages of the loaded range are shown by the view right now
+    evict(range);
   }
 
-  bool isRowLoaded(RowIndex index) {
-    CacheRange i = findTargetRange(index);
-    return !i.isEmpty();
+  bool isRowLoaded(RowIndex index) const {
+    auto p = page(index);
+    return p && p->loaded.testBit(index & PAGE_MASK);
   }
 
-  T getRow(RowIndex index) {
-    if (!isRowLoaded(index)) return T();
+  const T& getRow(RowIndex index) {
+    auto p = page(index);
 
-    CacheRange i = findTargetRange(index);
-    return m_mapping[i].at(index - i.first);
+    if (!p || !p->loaded.testBit(index & PAGE_MASK)) return emptyRow();
+
+    p->lastAccess = ++m_clock;
+    return p->rows.at(index & PAGE_MASK);
   }
 
-  T operator[](RowIndex index) { return getRow(index); }
+  const T& operator[](RowIndex index) { return getRow(index); }
 
   void replace(RowIndex index, T row) {
     if (!isRowLoaded(index)) {
       throw std::out_of_range("Invalid row");
     }
-    CacheRange i = findTargetRange(index);
-    return m_mapping[i].replace(index - i.first, row);
+    setRow(index, row);
   }
 
   void removeAt(RowIndex index) {
     if (!isRowLoaded(index)) {
       throw std::out_of_range("Invalid row");
     }
-    CacheRange i = findTargetRange(index);
 
-    m_mapping[i].removeAt(index - i.first);
-    CacheRange newKey{i.first, i.second - 1};
-    replaceRangeInMapping(newKey, i);
+    // Following rows are shifted, pages missing on both sides are skipped
+    for (RowIndex row = index; row < m_lastRow; row++) {
+      if (!page(row) && !page(row + 1)) {
+        row = (((row + 1) >> PAGE_SHIFT) << PAGE_SHIFT) + PAGE_ROWS - 2;
+        continue;
+      }
+
+      if (isRowLoaded(row + 1)) {
+        setRow(row, page(row + 1)->rows.at((row + 1) & PAGE_MASK));
+      } else {
+        unsetRow(row);
+      }
+    }
+
+    unsetRow(m_lastRow);
     m_valid = false;
   }
 
-  void push_back(const T& row) {
-    CacheRange newKey{0, 1};
+  void push_back(const T& row) { setRow(m_lastRow + 1, row); }
+
+  // Amount of loaded rows
+  unsigned long long size() const { return m_rowsCount; }
+
+  void clear() {
+    m_pages.clear();
+    m_usedMemory = 0;
+    m_rowsCount = 0;
+    m_lastRow = -1;
+    m_valid = true;
+  }
+
+ private:
+  static const RowIndex PAGE_MASK = PAGE_ROWS - 1;
+
+  struct Page {
+    QVector<T> rows;
+    QBitArray loaded;
+    qint64 usedMemory;
+    quint64 lastAccess;
+  };
+
+  static const T& emptyRow() {
+    static const T empty = T();
+    return empty;
+  }
+
+  static qint64 pageOverhead() {
+    return sizeof(Page) + PAGE_ROWS * sizeof(T) + PAGE_ROWS / 8;
+  }
+
+  Page* page(RowIndex index) const {
+    if (index < 0) return nullptr;
+
+    RowIndex pageIndex = index >> PAGE_SHIFT;
+
+    if (pageIndex >= m_pages.size()) return nullptr;
+
+    return m_pages.at(pageIndex).data();
+  }
+
+  void setRow(RowIndex index, const T& row) {
+    if (index < 0) return;
+
+    RowIndex pageIndex = index >> PAGE_SHIFT;
+
+    if (pageIndex >= m_pages.size()) m_pages.resize(pageIndex + 1);
 
-    if (m_mapping.size() > 0) {
-      newKey.first += m_mapping.lastKey().first;
-      newKey.second += m_mapping.lastKey().second;
+    auto& p = m_pages[pageIndex];
 
-      m_mapping.last().push_back(row);
-      replaceRangeInMapping(newKey);
+    if (!p) {
+      p = QSharedPointer<Page>(
+          new Page{QVector<T>(PAGE_ROWS), QBitArray(PAGE_ROWS), 0, 0});
+      p->usedMemory = pageOverhead();
+      m_usedMemory += p->usedMemory;
+    }
+
+    int offset = index & PAGE_MASK;
+    qint64 rowMemory = RowCacheMemory::estimate(row);
+
+    if (p->loaded.testBit(offset)) {
+      rowMemory -= RowCacheMemory::estimate(p->rows.at(offset));
     } else {
-      m_mapping.insert(newKey, QList<T>{row});
+      p->loaded.setBit(offset);
+      m_rowsCount++;
     }
+
+    p->rows[offset] = row;
+    p->usedMemory += rowMemory;
+    p->lastAccess = ++m_clock;
+    m_usedMemory += rowMemory;
+    m_lastRow = qMax(m_lastRow, index);
   }
 
-  unsigned long long size() const {
-    unsigned long long cacheSize = 0;
-    for (auto cachePage : m_mapping) {
-      cacheSize += cachePage.size();
+  void unsetRow(RowIndex index) {
+    auto p = page(index);
+    int offset = index & PAGE_MASK;
+
+    if (!p || !p->loaded.testBit(offset)) return;
+
+    qint64 rowMemory = RowCacheMemory::estimate(p->rows.at(offset));
+
+    p->rows[offset] = T();
+    p->loaded.clearBit(offset);
+    p->usedMemory -= rowMemory;
+    m_usedMemory -= rowMemory;
+    m_rowsCount--;
+
+    if (p->loaded.count(true) == 0) {
+      dropPage(index >> PAGE_SHIFT);
+      trimPageTable();
     }
-    return cacheSize;
+
+    if (index == m_lastRow) updateLastRow();
   }
 
-  void clear() {
-    m_mapping.clear();
-    m_valid = true;
+  void dropPage(RowIndex pageIndex) {
+    auto& p = m_pages[pageIndex];
+
+    m_usedMemory -= p->usedMemory;
+    m_rowsCount -= p->loaded.count(true);
+    p.clear();
   }
 
- private:
-  CacheRange findTargetRange(RowIndex index) {
-    for (auto i = m_mapping.constBegin(); i != m_mapping.constEnd(); ++i) {
-      if (i.key().first <= index && index <= i.key().second) {
-        return i.key();
+  void trimPageTable() {
+    while (!m_pages.isEmpty() && !m_pages.last()) m_pages.removeLast();
+  }
+
+  void updateLastRow() {
+    m_lastRow = -1;
+
+    if (m_pages.isEmpty()) return;
+
+    RowIndex pageIndex = m_pages.size() - 1;
+    const auto& loaded = m_pages.last()->loaded;
+
+    for (int offset = PAGE_ROWS - 1; offset >= 0; offset--) {
+      if (loaded.testBit(offset)) {
+        m_lastRow = (pageIndex << PAGE_SHIFT) + offset;
+        return;
       }
     }
-    return CacheRange();
   }
 
-  void replaceRangeInMapping(const CacheRange& newRange,
-                             const CacheRange& current = CacheRange()) {
-    CacheRange replaceKey = current.isEmpty() ? m_mapping.lastKey() : current;
+  void evict(const CacheRange& keep) {
+    if (m_memoryLimit <= 0 || m_usedMemory + m_reservedMemory <= m_memoryLimit)
+      return;
+
+    RowIndex keepFirst = keep.isEmpty() ? -1 : keep.first >> PAGE_SHIFT;
+    RowIndex keepLast = keep.isEmpty() ? -1 : keep.second >> PAGE_SHIFT;
+
+    QVector<RowIndex> candidates;
+
+    for (RowIndex i = 0; i < m_pages.size(); i++) {
+      if (m_pages.at(i) && (i < keepFirst || i > keepLast))
+        candidates.append(i);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [this](RowIndex a, RowIndex b) {
+                return m_pages.at(a)->lastAccess < m_pages.at(b)->lastAccess;
+              });
+
+    for (RowIndex pageIndex : qAsConst(candidates)) {
+      if (m_usedMemory + m_reservedMemory <= m_memoryLimit) break;
+
+      dropPage(pageIndex);
+    }
 
-    m_mapping[newRange] = m_mapping[replaceKey];
-    m_mapping.remove(replaceKey);
+    trimPageTable();
+    updateLastRow();
   }
 
  private:
-  QMap<CacheRange, QList<T>> m_mapping;
+  QVector<QSharedPointer<Page>> m_pages;
+  qint64 m_memoryLimit;
+  qint64 m_usedMemory;
+  qint64 m_reservedMemory;
+  unsigned long long m_rowsCount;
+  RowIndex m_lastRow;
+  quint64 m_clock;
   bool m_valid;
 };
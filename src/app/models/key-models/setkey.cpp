@@ -17,7 +17,11 @@ void SetKeyModel::updateRow(int rowIndex, const QVariantMap &row, Callback c) {
   QByteArray newRow(row["value"].toByteArray());
 
   auto onRowAdded = [this, c, rowIndex, newRow](const QString &err) {
-    if (err.isEmpty()) m_rowsCache.replace(rowIndex, newRow);
+    if (err.isEmpty()) {
+      m_rowsCache.replace(rowIndex, newRow);
+      // Re-added member may be returned by SCAN at another position
+      resetScanCheckpoints();
+    }
     return c(err);
   };
 
@@ -36,6 +40,7 @@ void SetKeyModel::addRow(const QVariantMap &row, Callback c) {
   addSetRow(row["value"].toByteArray(), [this, c](const QString &err) {
     if (err.isEmpty()) {
       m_rowCount++;
+      resetScanCheckpoints();
     }
 
     return c(err);
@@ -49,7 +54,7 @@ void SetKeyModel::removeRow(int i, Callback c) {
   deleteSetRow(value, [this, c, i](const QString &err) {
     if (err.isEmpty()) {
       m_rowCount--;
-      m_rowsCache.removeAt(i);
+      removeCachedRow(i);
 
       setRemovedIfEmpty();
     }
@@ -5,7 +5,10 @@ SortedSetKeyModel::SortedSetKeyModel(
     QSharedPointer<RedisClient::Connection> connection, QByteArray fullPath,
     int dbIndex, long long ttl)
     : KeyModel(connection, fullPath, dbIndex, ttl, "ZCARD",
-               "ZRANGE WITHSCORES") {}
+               "ZRANGE WITHSCORES") {
+  // Rows are ordered by score until MATCH filter is applied
+  m_rowsMatchCmd = "ZSCAN";
+}
 
 QString SortedSetKeyModel::type() { return "zset"; }
 
@@ -54,8 +57,14 @@ void SortedSetKeyModel::updateRow(int rowIndex, const QVariantMap &row,
       (valueChanged) ? row["value"].toByteArray() : cachedRow.first,
       (scoreChanged) ? row["score"].toByteArray() : cachedRow.second);
 
-  auto onRowAdded = [this, c, rowIndex, newRow](const QString &err) {
-    if (err.isEmpty()) m_rowsCache.replace(rowIndex, newRow);
+  auto onRowAdded = [this, c, rowIndex, newRow,
+                     valueChanged](const QString &err) {
+    if (err.isEmpty()) {
+      m_rowsCache.replace(rowIndex, newRow);
+
+      // Re-added member may be returned by SCAN at another position
+      if (valueChanged) resetScanCheckpoints();
+    }
 
     return c(err);
   };
@@ -78,7 +87,10 @@ void SortedSetKeyModel::addRow(const QVariantMap &row, Callback c) {
   }
 
   auto onAdded = [this, c](const QString &err) {
-    if (err.isEmpty()) m_rowCount++;
+    if (err.isEmpty()) {
+      m_rowCount++;
+      resetScanCheckpoints();
+    }
 
     return c(err);
   };
@@ -95,7 +107,7 @@ void SortedSetKeyModel::removeRow(int i, Callback c) {
   executeCmd({"ZREM", m_keyFullPath, value}, [this, c, i](const QString &err) {
     if (err.isEmpty()) {
       m_rowCount--;
-      m_rowsCache.removeAt(i);
+      removeCachedRow(i);
       setRemovedIfEmpty();
     }
 
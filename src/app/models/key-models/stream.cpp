@@ -9,7 +9,11 @@
 StreamKeyModel::StreamKeyModel(
     QSharedPointer<RedisClient::Connection> connection, QByteArray fullPath,
     int dbIndex, long long ttl)
-    : KeyModel(connection, fullPath, dbIndex, ttl, "XLEN", QByteArray()) {}
+    : KeyModel(connection, fullPath, dbIndex, ttl, "XLEN", QByteArray()) {
+  // XREVRANGE continues from the ID of the previous row, rows after an
+  // evicted page would be loaded from the newest entry again
+  m_rowsCache.setMemoryLimit(0);
+}
 
 QString StreamKeyModel::type() { return "stream"; }
 
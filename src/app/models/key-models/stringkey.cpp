@@ -1,6 +1,13 @@
 #include "stringkey.h"
 #include <qredisclient/connection.h>
 
+namespace {
+// Size of GETRANGE window, it matches chunks of LargeTextWrappingModel
+const uint STREAMED_WINDOW_SIZE = 50000;
+// Windows kept in memory by the view of a streamed value
+const int STREAMED_WINDOWS_LIMIT = 20;
+}  // namespace
+
 StringKeyModel::StringKeyModel(
     QSharedPointer<RedisClient::Connection> connection, QByteArray fullPath,
     int dbIndex, long long ttl)
@@ -15,16 +22,25 @@ QStringList StringKeyModel::getColumnNames() {
 QHash<int, QByteArray> StringKeyModel::getRoles() {
   QHash<int, QByteArray> roles;
   roles[Roles::Value] = "value";
+  roles[Roles::StreamedSize] = "streamedSize";
   return roles;
 }
 
 QVariant StringKeyModel::getData(int rowIndex, int dataRole) {
   if (rowIndex > 0 || !isRowLoaded(rowIndex)) return QVariant();
   if (dataRole == Roles::Value) return m_rowsCache[rowIndex];
+  if (dataRole == Roles::StreamedSize)
+    return m_streamedValue ? m_streamedValue->size() : 0;
 
   return QVariant();
 }
 
+QObject* StringKeyModel::getStreamedValue(int rowIndex) {
+  if (rowIndex > 0) return nullptr;
+
+  return m_streamedValue.data();
+}
+
 void StringKeyModel::updateRow(int rowIndex, const QVariantMap& row,
                                Callback c) {
   if (rowIndex > 0 || !isRowValid(row)) {
@@ -37,6 +53,7 @@ void StringKeyModel::updateRow(int rowIndex, const QVariantMap& row,
   executeCmd(
       {"SET", m_keyFullPath, value}, [this, c, value](const QString& err) {
         if (err.isEmpty()) {
+          m_streamedValue.clear();
           m_rowsCache.clear();
           m_rowsCache.addLoadedRange({0, 0}, (QList<QByteArray>() << value));
         }
@@ -61,11 +78,79 @@ void StringKeyModel::addRow(const QVariantMap& row, Callback c) {
 
 void StringKeyModel::loadRows(QVariant, unsigned long,
                               LoadRowsCallback callback) {
+  QSettings settings;
+  qint64 threshold =
+      settings.value("app/valueEditorStreamingThreshold", 16).toLongLong() *
+      1024 * 1024;
+
+  auto onConnectionError = [callback](const QString& err) {
+    return callback(err, 0);
+  };
+
+  executeCmd(
+      {"STRLEN", m_keyFullPath}, onConnectionError,
+      [this, callback, threshold](RedisClient::Response r, Callback) {
+        qint64 size = r.value().toLongLong();
+
+        if (threshold > 0 && size > threshold) {
+          loadStreamedValue(size, callback);
+        } else {
+          loadValue(callback);
+        }
+      },
+      RedisClient::Response::Integer);
+}
+
+void StringKeyModel::loadStreamedValue(qint64 size,
+                                       LoadRowsCallback callback) {
+  auto self = sharedFromThis().toWeakRef();
+
+  m_streamedValue = QSharedPointer<ValueEditor::PagedTextModel>(
+      new ValueEditor::PagedTextModel(
+          size,
+          [this, self](qint64 windowOffset, qint64 windowSize,
+                       ValueEditor::PagedTextModel::WindowCallback c) {
+            // Model of the value is deleted later than the key model
+            if (!self) return;
+
+            loadValueWindow(windowOffset, windowSize, c);
+          },
+          STREAMED_WINDOW_SIZE, STREAMED_WINDOWS_LIMIT),
+      &QObject::deleteLater);
+
+  loadValueWindow(
+      0, STREAMED_WINDOW_SIZE,
+      [this, callback](const QString& err, const QByteArray& preview) {
+        if (!err.isEmpty()) return callback(err, 0);
+
+        m_rowsCache.clear();
+        m_rowsCache.push_back(preview);
+        m_rowCount = 1;
+
+        callback(QString(), 1);
+      });
+}
+
+void StringKeyModel::loadValueWindow(
+    qint64 offset, qint64 size,
+    ValueEditor::PagedTextModel::WindowCallback callback) {
+  executeCmd(
+      {"GETRANGE", m_keyFullPath, QString::number(offset).toLatin1(),
+       QString::number(offset + size - 1).toLatin1()},
+      [callback](const QString& err) { callback(err, QByteArray()); },
+      [callback](RedisClient::Response r, Callback) {
+        callback(QString(), r.value().toByteArray());
+      },
+      RedisClient::Response::String);
+}
+
+void StringKeyModel::loadValue(LoadRowsCallback callback) {
   auto onConnectionError = [callback](const QString& err) {
     return callback(err, 0);
   };
 
   auto responseHandler = [this, callback](RedisClient::Response r, Callback) {
+    m_streamedValue.clear();
     m_rowsCache.clear();
 
     QByteArray value = r.value().toByteArray();
@@ -1,5 +1,6 @@
 #pragma once
 #include "abstractkey.h"
+#include "modules/value-editor/pagedtextmodel.h"
 
 class StringKeyModel : public KeyModel<QByteArray> {
  public:
@@ -16,6 +17,7 @@ class StringKeyModel : public KeyModel<QByteArray> {
                          Callback c) override;
   void loadRows(QVariant, unsigned long, LoadRowsCallback callback) override;
   void removeRow(int, Callback c) override;
+  QObject* getStreamedValue(int rowIndex) override;
 
   virtual unsigned long rowsCount() override {
       return m_rowCount;
@@ -25,7 +27,16 @@ class StringKeyModel : public KeyModel<QByteArray> {
   int addLoadedRowsToCache(const QVariantList&, QVariant) override { return 1; }
 
  private:
-  enum Roles { Value = Qt::UserRole + 1 };
+  enum Roles { Value = Qt::UserRole + 1, StreamedSize };
+
+  void loadValue(LoadRowsCallback callback);
+  void loadStreamedValue(qint64 size, LoadRowsCallback callback);
+  void loadValueWindow(qint64 offset, qint64 size,
+                       ValueEditor::PagedTextModel::WindowCallback callback);
 
   QString m_type;
+
+  // Values larger than the threshold are read with GETRANGE in windows,
+  // the first window is cached as a preview
+  QSharedPointer<ValueEditor::PagedTextModel> m_streamedValue;
 };
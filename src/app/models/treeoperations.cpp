@@ -2,24 +2,32 @@
 
 #include <asyncfuture.h>
 #include <qredisclient/redisclient.h>
+#include <QCryptographicHash>
+#include <QDir>
 #include <QRegExp>
 #include <QRegularExpression>
 #include <QRegularExpressionMatchIterator>
 #include <QSet>
+#include <QThread>
 #include <QtConcurrent>
 #include <algorithm>
 
 #include "app/events.h"
+#include "app/models/configmanager.h"
 #include "connections-tree/items/serveritem.h"
 #include "connections-tree/items/databaseitem.h"
 #include "connections-tree/items/namespaceitem.h"
+#include "connections-tree/keysdiskcache.h"
 #include "connections-tree/keysrendering.h"
+#include "modules/common/clusterkeysloader.h"
+#include "modules/common/keyspacenotifications.h"
 
 TreeOperations::TreeOperations(const ServerConfig &config,
     QSharedPointer<Events> events)
     : m_events(events), m_dbCount(0),
       m_connectionMode(RedisClient::Connection::Mode::Normal),
-      m_config(config){
+      m_config(config),
+      m_scanResults(new ConnectionsTree::ScanResultsCache()) {
   m_connection = QSharedPointer<RedisClient::Connection>(
               new RedisClient::Connection(config));
   m_events->registerLoggerForConnection(*m_connection);
@@ -203,9 +211,7 @@ QFuture<void> TreeOperations::getDatabases(
   return m_dbScanOp->future();
 }
 
-void TreeOperations::loadNamespaceItems(
-    uint dbIndex, const QString& filter,
-    QSharedPointer<LoadNamespaceItemsCallback> callback) {
+QString TreeOperations::updateFilterHistory(const QString& filter) {
   QString keyPattern = filter.isEmpty() ? m_config.keysPattern() : filter;
 
   if (m_filterHistory.contains(keyPattern)) {
@@ -216,11 +222,52 @@ void TreeOperations::loadNamespaceItems(
   m_config.setFilterHistory(m_filterHistory);
   emit filterHistoryUpdated();
 
+  return keyPattern;
+}
+
+void TreeOperations::loadNamespaceItems(
+    uint dbIndex, const QString& filter,
+    QSharedPointer<LoadNamespaceItemsCallback> callback,
+    QSharedPointer<ScanProgressCallback> progress) {
+  QString keyPattern = updateFilterHistory(filter);
+
+  if (m_scanResults->contains(dbIndex, keyPattern)) {
+    auto scanResults = m_scanResults;
+
+    // Keys are filtered from the previous SCAN result outside of UI thread
+    auto future = QtConcurrent::run([scanResults, dbIndex, keyPattern]() {
+      RedisClient::Connection::RawKeysList keys;
+      bool found = scanResults->lookup(dbIndex, keyPattern, keys);
+      return qMakePair(found, keys);
+    });
+
+    AsyncFuture::observe(future).subscribe(
+        [this, future, dbIndex, keyPattern, callback, progress]() {
+          auto result = future.result();
+
+          if (result.first) return callback->call(result.second, QString());
+
+          // Cached result has expired meanwhile
+          scanNamespaceItems(dbIndex, keyPattern, callback, progress);
+        });
+    return;
+  }
+
+  scanNamespaceItems(dbIndex, keyPattern, callback, progress);
+}
+
+void TreeOperations::scanNamespaceItems(
+    uint dbIndex, const QString& keyPattern,
+    QSharedPointer<LoadNamespaceItemsCallback> callback,
+    QSharedPointer<ScanProgressCallback> progress) {
   QSettings settings;
   qlonglong scanLimit = settings.value("app/scanLimit", DEFAULT_SCAN_LIMIT).toLongLong();
 
-  getReadyConnection([this, dbIndex, filter, callback,
-                      keyPattern, scanLimit](QSharedPointer<RedisClient::Connection> c) {
+  // Frequently used filters stay in the cache longer
+  int priority = m_filterHistory.value(keyPattern).toInt();
+
+  getReadyConnection([this, dbIndex, callback, progress, keyPattern,
+                      scanLimit, priority](QSharedPointer<RedisClient::Connection> c) {
     if (!connect(c)) return;
 
     auto processErr = [callback](const QString& err) {
@@ -229,14 +276,31 @@ void TreeOperations::loadNamespaceItems(
           QCoreApplication::translate("RESP", "Cannot load keys: %1").arg(err));
     };
 
-    auto callbackWrapper = [callback](const RedisClient::Connection::RawKeysList &keys,
-        const QString &err) {
+    auto scanResults = m_scanResults;
+
+    // All keys are kept by the tree, narrower filters are applied to them
+    // without a second copy in the cache
+    bool cacheResult =
+        !ConnectionsTree::GlobMatcher(keyPattern.toUtf8()).isMatchAll();
+
+    auto callbackWrapper = [callback, scanResults, dbIndex, keyPattern,
+                            priority, cacheResult](
+        const RedisClient::Connection::RawKeysList &keys, const QString &err) {
+      if (err.isEmpty() && cacheResult)
+        scanResults->insert(dbIndex, keyPattern, keys, priority);
+
       return callback->call(keys, err);
     };
 
     try {
       if (m_connection->mode() == RedisClient::Connection::Mode::Cluster) {
-        m_connection->getClusterKeys(callbackWrapper, keyPattern, scanLimit);
+        auto loader =
+            new ClusterKeysLoader(m_connection, keyPattern, scanLimit);
+
+        loader->load(callbackWrapper, [progress](const QString& node,
+                                                 qlonglong keys, bool finished) {
+          if (progress) progress->call(node, keys, finished);
+        });
       } else {
         m_connection->cmd(
             {"ping"}, this, dbIndex,
@@ -256,11 +320,299 @@ void TreeOperations::loadNamespaceItems(
   });
 }
 
-void TreeOperations::disconnect() { m_connection->disconnect(); }
+QFuture<void> TreeOperations::loadNamespaceItemsIncrementally(
+    uint dbIndex, const QString& filter,
+    QSharedPointer<LoadNamespaceItemsBatchCallback> callback) {
+  QString keyPattern = updateFilterHistory(filter);
+
+  QSettings settings;
+  qlonglong scanLimit = settings.value("app/scanLimit", DEFAULT_SCAN_LIMIT).toLongLong();
+
+  auto d = QSharedPointer<AsyncFuture::Deferred<void>>(
+      new AsyncFuture::Deferred<void>());
+
+  getReadyConnection([this, dbIndex, callback, keyPattern, scanLimit,
+                      d](QSharedPointer<RedisClient::Connection> c) {
+    if (!connect(c)) return;
+
+    try {
+      if (m_connection->mode() == RedisClient::Connection::Mode::Cluster) {
+        // NOTE: cluster keys are collected from all master nodes at once
+        auto loader =
+            new ClusterKeysLoader(m_connection, keyPattern, scanLimit);
+
+        loader->load(
+            [callback, d](const RedisClient::Connection::RawKeysList& keys,
+                          const QString& err) {
+              d->complete();
+              callback->call(
+                  keys,
+                  err.isEmpty() ? err
+                                : QCoreApplication::translate(
+                                      "RESP", "Cannot load keys: %1")
+                                      .arg(err),
+                  true);
+            });
+      } else {
+        scanKeysBatch(dbIndex, keyPattern, scanLimit, 0, callback, d);
+      }
+    } catch (const RedisClient::Connection::Exception& error) {
+      d->complete();
+      callback->call(
+          RedisClient::Connection::RawKeysList(),
+          QCoreApplication::translate("RESP", "Cannot load keys: %1")
+              .arg(error.what()),
+          true);
+    }
+  });
+
+  return d->future();
+}
+
+void TreeOperations::scanKeysBatch(
+    uint dbIndex, const QString& keyPattern, qlonglong scanLimit,
+    qlonglong cursor, QSharedPointer<LoadNamespaceItemsBatchCallback> callback,
+    QSharedPointer<AsyncFuture::Deferred<void>> d) {
+  if (d->future().isCanceled() || !callback->isValid()) return;
+
+  auto processErr = [callback, d](const QString& err) {
+    d->complete();
+    return callback->call(
+        RedisClient::Connection::RawKeysList(),
+        QCoreApplication::translate("RESP", "Cannot load keys: %1").arg(err),
+        true);
+  };
+
+  m_connection->cmd(
+      {"SCAN", QByteArray::number(cursor), "MATCH", keyPattern.toUtf8(),
+       "COUNT", QByteArray::number(scanLimit)},
+      this, dbIndex,
+      [this, dbIndex, keyPattern, scanLimit, callback, d,
+       processErr](const RedisClient::Response& r) {
+        if (d->future().isCanceled()) return;
+
+        if (!r.isValidScanResponse()) {
+          return processErr(r.isErrorMessage()
+                                ? r.value().toString()
+                                : QCoreApplication::translate(
+                                      "RESP", "Cannot parse scan response"));
+        }
+
+        RedisClient::Connection::RawKeysList keys;
+        auto collection = r.getCollection();
+        keys.reserve(collection.size());
+
+        for (const auto& key : qAsConst(collection)) {
+          keys.append(key.toByteArray());
+        }
+
+        qlonglong nextCursor = r.getCursor();
+        bool finished = nextCursor <= 0;
+
+        if (finished) d->complete();
+
+        callback->call(keys, QString(), finished);
+
+        if (!finished) {
+          scanKeysBatch(dbIndex, keyPattern, scanLimit, nextCursor, callback,
+                        d);
+        }
+      },
+      processErr);
+}
+
+// Counts keys of nested namespaces on the server side, returns the next
+// cursor, keys placed directly in the namespace and flat list of namespace
+// and keys counter pairs
+static const QByteArray NAMESPACES_SUMMARY_SCRIPT = R"(
+local cursor = ARGV[1]
+local pattern = ARGV[2]
+local scanLimit = tonumber(ARGV[3])
+local iterations = tonumber(ARGV[4])
+local separator = ARGV[5]
+local prefixLength = tonumber(ARGV[6])
+local depth = tonumber(ARGV[7])
+
+if separator == '' then depth = 0 end
+
+local keys = {}
+local counters = {}
+local iteration = 0
+
+repeat
+  local result = redis.call('SCAN', cursor, 'MATCH', pattern, 'COUNT', scanLimit)
+  cursor = result[1]
+
+  for _, key in ipairs(result[2]) do
+    local pos = prefixLength + 1
+    local level = 0
+
+    while level < depth do
+      local sep = string.find(key, separator, pos, true)
+      if not sep then break end
+
+      local ns = string.sub(key, 1, sep - 1)
+      counters[ns] = (counters[ns] or 0) + 1
+      pos = sep + #separator
+      level = level + 1
+    end
+
+    if level == 0 then table.insert(keys, key) end
+  end
+
+  iteration = iteration + 1
+until cursor == '0' or iteration >= iterations
+
+local namespaces = {}
+for ns, count in pairs(counters) do
+  table.insert(namespaces, ns)
+  table.insert(namespaces, count)
+end
+
+return {cursor, keys, namespaces}
+)";
+
+// SCAN calls per script execution, server is blocked while script is running
+static const int NAMESPACES_SUMMARY_SCAN_ITERATIONS = 10;
+
+QFuture<void> TreeOperations::loadNamespacesSummary(
+    uint dbIndex, const QString& filter, int prefixLength, int depth,
+    QSharedPointer<LoadNamespacesSummaryCallback> callback) {
+  QString keyPattern = updateFilterHistory(filter);
+
+  QSettings settings;
+  qlonglong scanLimit = settings.value("app/scanLimit", DEFAULT_SCAN_LIMIT).toLongLong();
+
+  auto d = QSharedPointer<AsyncFuture::Deferred<void>>(
+      new AsyncFuture::Deferred<void>());
+
+  getReadyConnection([this, dbIndex, callback, keyPattern, prefixLength, depth,
+                      scanLimit, d](QSharedPointer<RedisClient::Connection> c) {
+    if (!connect(c)) return;
+
+    try {
+      if (m_connection->mode() == RedisClient::Connection::Mode::Cluster) {
+        // NOTE: scripts are executed on one node, load all keys of master
+        // nodes concurrently instead
+        auto loader =
+            new ClusterKeysLoader(m_connection, keyPattern, scanLimit);
+
+        loader->load(
+            [callback, d](const RedisClient::Connection::RawKeysList& keys,
+                          const QString& err) {
+              d->complete();
+              callback->call(
+                  keys, NamespacesSummary(),
+                  err.isEmpty() ? err
+                                : QCoreApplication::translate(
+                                      "RESP", "Cannot load keys: %1")
+                                      .arg(err));
+            });
+      } else {
+        aggregateKeysBatch(dbIndex, keyPattern, prefixLength, depth, scanLimit,
+                           "0",
+                           QSharedPointer<NamespacesSummaryResult>(
+                               new NamespacesSummaryResult()),
+                           callback, d);
+      }
+    } catch (const RedisClient::Connection::Exception& error) {
+      d->complete();
+      callback->call(
+          RedisClient::Connection::RawKeysList(), NamespacesSummary(),
+          QCoreApplication::translate("RESP", "Cannot load keys: %1")
+              .arg(error.what()));
+    }
+  });
+
+  return d->future();
+}
+
+void TreeOperations::aggregateKeysBatch(
+    uint dbIndex, const QString& keyPattern, int prefixLength, int depth,
+    qlonglong scanLimit, const QByteArray& cursor,
+    QSharedPointer<NamespacesSummaryResult> result,
+    QSharedPointer<LoadNamespacesSummaryCallback> callback,
+    QSharedPointer<AsyncFuture::Deferred<void>> d) {
+  if (d->future().isCanceled() || !callback->isValid()) return;
+
+  auto processErr = [callback, d](const QString& err) {
+    d->complete();
+    return callback->call(
+        RedisClient::Connection::RawKeysList(), NamespacesSummary(),
+        QCoreApplication::translate("RESP", "Cannot load keys: %1").arg(err));
+  };
+
+  bool firstBatch = cursor == "0" && result->keys.isEmpty() &&
+                    result->namespaces.isEmpty();
+
+  m_connection->cmd(
+      {"EVAL", NAMESPACES_SUMMARY_SCRIPT, "0", cursor, keyPattern.toUtf8(),
+       QByteArray::number(scanLimit),
+       QByteArray::number(NAMESPACES_SUMMARY_SCAN_ITERATIONS),
+       getNamespaceSeparator().toUtf8(), QByteArray::number(prefixLength),
+       QByteArray::number(depth)},
+      this, dbIndex,
+      [this, dbIndex, keyPattern, prefixLength, depth, scanLimit, result,
+       callback, d, processErr, firstBatch](const RedisClient::Response& r) {
+        if (d->future().isCanceled()) return;
+
+        if (r.isErrorMessage() && firstBatch) {
+          // Scripting is disabled or not permitted, load all keys instead
+          qDebug() << "Cannot aggregate keys on server:" << r.value().toString();
+
+          m_connection->getDatabaseKeys(
+              [callback, d](const RedisClient::Connection::RawKeysList& keys,
+                            const QString& err) {
+                d->complete();
+                callback->call(keys, NamespacesSummary(), err);
+              },
+              keyPattern, -1, scanLimit);
+          return;
+        }
+
+        QVariantList reply = r.value().toList();
+
+        if (r.isErrorMessage() || reply.size() != 3) {
+          return processErr(r.isErrorMessage()
+                                ? r.value().toString()
+                                : QCoreApplication::translate(
+                                      "RESP", "Cannot parse scan response"));
+        }
+
+        QByteArray nextCursor = reply[0].toByteArray();
+
+        const auto keys = reply[1].toList();
+        for (const auto& key : keys) {
+          result->keys.append(key.toByteArray());
+        }
+
+        const auto namespaces = reply[2].toList();
+        for (int i = 0; i + 1 < namespaces.size(); i += 2) {
+          result->namespaces[namespaces[i].toByteArray()] +=
+              namespaces[i + 1].toLongLong();
+        }
+
+        if (nextCursor == "0" || nextCursor.isEmpty()) {
+          d->complete();
+          return callback->call(result->keys, result->namespaces, QString());
+        }
+
+        aggregateKeysBatch(dbIndex, keyPattern, prefixLength, depth, scanLimit,
+                           nextCursor, result, callback, d);
+      },
+      processErr);
+}
+
+void TreeOperations::disconnect() {
+  resetMemoryConnectionsPool();
+  m_scanResults->clear();
+  m_connection->disconnect();
+}
 
 void TreeOperations::resetConnection() {
   auto oldConnection = m_connection;
   setConnection(oldConnection->clone());
+  m_scanResults->clear();
 
   QtConcurrent::run([oldConnection]() { oldConnection->disconnect(); });
 }
@@ -325,6 +677,7 @@ void TreeOperations::deleteDbKey(ConnectionsTree::KeyItem& key,
         c->cmd(
             {"DEL", key.getFullPath()}, this, key.getDbIndex(),
             [this, &key](RedisClient::Response) {
+              invalidateScanResults(key.getDbIndex());
               key.setRemoved();
               QRegExp filter(key.getFullPath(), Qt::CaseSensitive,
                              QRegExp::Wildcard);
@@ -350,6 +703,7 @@ void TreeOperations::deleteDbKeys(ConnectionsTree::DatabaseItem& db) {
           return;
         }
         uint dbIndex = db.getDbIndex();
+        invalidateScanResults(dbIndex);
         db.reload();
 
         if (m_events && m_connection) {
@@ -370,6 +724,7 @@ void TreeOperations::deleteDbNamespace(ConnectionsTree::NamespaceItem& ns) {
           return;
         }
         uint dbIndex = ns.getDbIndex();
+        invalidateScanResults(dbIndex);
         ns.setRemoved();
 
         if (m_events && m_connection) {
@@ -382,13 +737,24 @@ void TreeOperations::deleteDbNamespace(ConnectionsTree::NamespaceItem& ns) {
 }
 
 void TreeOperations::setTTL(ConnectionsTree::AbstractNamespaceItem& ns) {
+  auto scanResults = m_scanResults;
+  uint dbIndex = ns.getDbIndex();
+
+  // Keys can expire right away
   requestBulkOperation(ns, BulkOperations::Manager::Operation::TTL,
-                       [](QRegExp, int, const QStringList&) {});
+                       [scanResults, dbIndex](QRegExp, int, const QStringList&) {
+                         scanResults->invalidate(dbIndex);
+                       });
 }
 
 void TreeOperations::copyKeys(ConnectionsTree::AbstractNamespaceItem& ns) {
+  auto scanResults = m_scanResults;
+
+  // Keys can be copied to any database of the connection
   requestBulkOperation(ns, BulkOperations::Manager::Operation::COPY_KEYS,
-                       [](QRegExp, int, const QStringList&) {});
+                       [scanResults](QRegExp, int, const QStringList&) {
+                         scanResults->clear();
+                       });
 }
 
 void TreeOperations::importKeysFromRdb(ConnectionsTree::DatabaseItem& db) {
@@ -396,13 +762,18 @@ void TreeOperations::importKeysFromRdb(ConnectionsTree::DatabaseItem& db) {
     emit m_events->requestBulkOperation(
         c->clone(), db.getDbIndex(),
         BulkOperations::Manager::Operation::IMPORT_RDB_KEYS, QRegExp(".*"),
-        [&db](QRegExp, int, const QStringList&) { db.reload(); });
+        [this, &db](QRegExp, int, const QStringList&) {
+          invalidateScanResults(db.getDbIndex());
+          db.reload();
+        });
   });
 }
 
 void TreeOperations::flushDb(int dbIndex,
                              QSharedPointer<FlushDbCallback> callback) {
 
+  invalidateScanResults(dbIndex);
+
   auto callbackWrapper = [callback](const QString &err) {
     callback->call(err);
   };
@@ -420,7 +791,13 @@ void TreeOperations::flushDb(int dbIndex,
 }
 
 QFuture<bool> TreeOperations::connectionSupportsMemoryOperations() {
-    return m_connection->isCommandSupported({"MEMORY", "HELP"});
+  // Cached until connection is replaced, failed checks are repeated
+  if (m_memoryOperationsSupport.isCanceled()) {
+    m_memoryOperationsSupport =
+        m_connection->isCommandSupported({"MEMORY", "HELP"});
+  }
+
+  return m_memoryOperationsSupport;
 }
 
 void TreeOperations::openKeyIfExists(const QByteArray& fullPath,
@@ -455,52 +832,378 @@ void TreeOperations::openKeyIfExists(const QByteArray& fullPath,
   });
 }
 
-void TreeOperations::getUsedMemory(const QList<QByteArray>& keys, int dbIndex,
+static const int MEMORY_CONNECTIONS_LIMIT = 4;
+static const int MEMORY_USAGE_PROGRESS_STEP = 1000;
+static const int MEMORY_USAGE_PARALLEL_THRESHOLD = 10000;
+
+void TreeOperations::getUsedMemory(const ConnectionsTree::RawKeys& keys, int dbIndex,
                                    QSharedPointer<GetUsedMemoryCallback> result,
                                    QSharedPointer<GetUsedMemoryCallback> progress) {
-  QList<QList<QByteArray>> commands;
+  auto totalMemory = QSharedPointer<qlonglong>(new qlonglong(0));
+  auto processedKeys = QSharedPointer<int>(new int(0));
+
+  runMemoryUsage(
+      keys, dbIndex,
+      [totalMemory, processedKeys, progress](int, qlonglong memory) {
+        (*totalMemory) += memory;
+        (*processedKeys)++;
 
-  for (int index = 0; index < keys.size(); ++index) {
-    commands.append({"MEMORY", "USAGE", keys[index]});
+        if (progress && (*processedKeys) % MEMORY_USAGE_PROGRESS_STEP == 0)
+          progress->call(*totalMemory);
+      },
+      [totalMemory, result]() {
+        if (result) result->call(*totalMemory);
+      });
+}
+
+void TreeOperations::getKeysMemory(
+    const RedisClient::Connection::RawKeysList& keys, int dbIndex,
+    QSharedPointer<GetKeysMemoryCallback> result) {
+  auto memory =
+      QSharedPointer<QVector<qlonglong>>(new QVector<qlonglong>(keys.size()));
+
+  runMemoryUsage(
+      ConnectionsTree::RawKeys(keys), dbIndex,
+      [memory](int index, qlonglong value) { (*memory)[index] = value; },
+      [memory, result]() {
+        if (result) result->call(*memory);
+      });
+}
+
+void TreeOperations::getKeysMetadata(
+    const RedisClient::Connection::RawKeysList& keys, int dbIndex,
+    QSharedPointer<GetKeysMetadataCallback> result) {
+  if (keys.isEmpty()) return;
+
+  AsyncFuture::observe(connectionSupportsMemoryOperations())
+      .subscribe([this, keys, dbIndex, result](bool memorySupported) {
+        if (!result || !result->isValid()) return;
+
+        QList<QList<QByteArray>> commands;
+        commands.reserve(keys.size() * 4);
+
+        for (const QByteArray& key : keys) {
+          commands.append({"TYPE", key});
+          commands.append({"PTTL", key});
+          commands.append({"OBJECT", "ENCODING", key});
+
+          if (memorySupported) commands.append({"MEMORY", "USAGE", key});
+        }
+
+        int commandsPerKey = commands.size() / keys.size();
+        int expectedResponses = commands.size();
+        auto responses = QSharedPointer<QVariantList>(new QVariantList());
+
+        m_connection->pipelinedCmd(
+            commands, this, dbIndex,
+            [keys, commandsPerKey, expectedResponses, responses, result](
+                RedisClient::Response r, QString err) {
+              if (!err.isEmpty()) {
+                // Background request, errors are visible in connection log
+                qWarning() << "Cannot load keys metadata:" << err;
+                return;
+              }
+
+              QVariant value = r.value();
+
+              if (value.type() == QVariant::List) {
+                responses->append(value.toList());
+              } else {
+                responses->append(value);
+              }
+
+              if (responses->size() < expectedResponses) return;
+
+              QList<KeyMetadata> metadata;
+              metadata.reserve(keys.size());
+
+              for (int i = 0; i < keys.size(); i++) {
+                int offset = i * commandsPerKey;
+                KeyMetadata keyMetadata;
+                keyMetadata.type = responses->at(offset).toByteArray();
+                keyMetadata.ttl = responses->at(offset + 1).toLongLong();
+                keyMetadata.encoding = responses->at(offset + 2).toByteArray();
+
+                if (commandsPerKey > 3)
+                  keyMetadata.usedMemory =
+                      responses->at(offset + 3).toLongLong();
+
+                metadata.append(keyMetadata);
+              }
+
+              result->call(metadata);
+            },
+            true);
+      });
+}
+
+QList<QSharedPointer<RedisClient::Connection>>
+TreeOperations::memoryConnectionsPool() {
+  QMutexLocker lock(&m_memoryConnectionsMutex);
+
+  if (!m_memoryConnections.isEmpty()) return m_memoryConnections;
+
+  m_memoryConnections.append(m_connection);
+
+  int poolSize =
+      qBound(1, QThread::idealThreadCount() / 2, MEMORY_CONNECTIONS_LIMIT);
+
+  for (int i = 1; i < poolSize; i++) {
+    // NOTE(u_glide): Clones are not registered in the logger - MEMORY USAGE
+    // commands of big namespaces would flood the log
+    auto c = m_connection->clone();
+
+    if (!connect(c)) break;
+
+    m_memoryConnections.append(c);
   }
 
-  int expectedResponses = commands.size();
-  auto processedResponses = QSharedPointer<int>(new int(0));
-  auto totalMemory = QSharedPointer<qlonglong>(new qlonglong(0));
+  return m_memoryConnections;
+}
+
+void TreeOperations::resetMemoryConnectionsPool() {
+  QMutexLocker lock(&m_memoryConnectionsMutex);
+
+  for (auto c : m_memoryConnections) {
+    if (c == m_connection) continue;
+
+    QtConcurrent::run([c]() { c->disconnect(); });
+  }
+
+  m_memoryConnections.clear();
+}
+
+void TreeOperations::runMemoryUsage(
+    const ConnectionsTree::RawKeys& keys, int dbIndex,
+    std::function<void(int, qlonglong)> onKeyProcessed,
+    std::function<void()> onFinished) {
+  if (keys.size() == 0) return onFinished();
+
+  // Small batches don't pay off extra connections
+  auto pool = keys.size() < MEMORY_USAGE_PARALLEL_THRESHOLD
+                  ? QList<QSharedPointer<RedisClient::Connection>>{m_connection}
+                  : memoryConnectionsPool();
+  int chunkSize = (keys.size() + pool.size() - 1) / pool.size();
+  auto pendingResponses = QSharedPointer<int>(new int(keys.size()));
+
+  const QByteArray memoryCmd("MEMORY");
+  const QByteArray usageSubCmd("USAGE");
+
+  for (int offset = 0, chunk = 0; offset < keys.size();
+       offset += chunkSize, chunk++) {
+    auto chunkKeys = keys.mid(offset, chunkSize);
+
+    QList<QList<QByteArray>> commands;
+    commands.reserve(chunkKeys.size());
+
+    // Views passed to the callback are only valid inside of it and
+    // commands outlive the storage, so keys are copied
+    chunkKeys.forEach(
+        [&commands, &memoryCmd, &usageSubCmd](const QByteArray& key) {
+          QByteArray keyCopy(key.constData(), key.size());
+          commands.append({memoryCmd, usageSubCmd, keyCopy});
+        });
+
+    int chunkKeysCount = chunkKeys.size();
+    auto processedResponses = QSharedPointer<int>(new int(0));
+
+    pool.at(chunk)->pipelinedCmd(
+        commands, this, dbIndex,
+        [this, offset, chunkKeysCount, processedResponses, pendingResponses,
+         onKeyProcessed, onFinished](RedisClient::Response r, QString err) {
+          if (*processedResponses >= chunkKeysCount) return;
+
+          if (!err.isEmpty()) {
+            QString errorMsg =
+                QCoreApplication::translate(
+                    "RESP", "Cannot determine amount of used memory by key: %1")
+                    .arg(err);
+            m_events->error(errorMsg);
+
+            // Failed chunk is counted as done, so analysis is finished with
+            // the error above instead of waiting for responses forever
+            (*pendingResponses) -= chunkKeysCount - (*processedResponses);
+            (*processedResponses) = chunkKeysCount;
+
+            if (*pendingResponses <= 0) onFinished();
+            return;
+          }
+
+          auto processResponse = [&](const QVariant& resp) {
+            onKeyProcessed(offset + (*processedResponses), resp.toLongLong());
+            (*processedResponses)++;
+            (*pendingResponses)--;
+          };
 
-  m_connection->pipelinedCmd(
-      commands, this, dbIndex,
-      [this, expectedResponses, processedResponses, totalMemory, progress,
-       result](RedisClient::Response r, QString err) {
-        if (!err.isEmpty()) {
-          QString errorMsg =
-              QCoreApplication::translate(
-                  "RESP", "Cannot determine amount of used memory by key: %1")
-                  .arg(err);
-          m_events->error(errorMsg);          
-        } else {
           QVariant incrResult = r.value();
 
           if (incrResult.canConvert(QVariant::LongLong)) {
-            (*totalMemory) += incrResult.toLongLong();
-            (*processedResponses)++;
+            processResponse(incrResult);
           } else if (incrResult.canConvert(QVariant::List)) {
             auto responses = incrResult.toList();
 
             for (auto resp : responses) {
-              (*totalMemory) += resp.toLongLong();
-              (*processedResponses)++;
+              processResponse(resp);
             }
           }
 
-          if (progress)
-            progress->call(*totalMemory);
+          if (*pendingResponses <= 0) onFinished();
+        },
+        true);
+  }
+}
 
-          if ((*processedResponses) >= expectedResponses && result) {
-            result->call(*totalMemory);
-          }
-        }
-      }, true);
+QString TreeOperations::keysCacheDir() {
+  return QDir::toNativeSeparators(
+      QString("%1/keys-cache").arg(ConfigManager::getConfigPath()));
+}
+
+QString TreeOperations::keysCacheId(const QString& filter) {
+  // NOTE: connection id is not persisted, use connection params instead
+  QByteArray connectionId = QCryptographicHash::hash(
+      QString("%1|%2|%3|%4")
+          .arg(m_config.name())
+          .arg(m_config.host())
+          .arg(m_config.port())
+          .arg(filter)
+          .toUtf8(),
+      QCryptographicHash::Sha1);
+
+  return QString(connectionId.toHex());
+}
+
+QString TreeOperations::keysCachePath(uint dbIndex, const QString& filter) {
+  // Snapshots of custom filters would quickly fill the disk
+  if (filter != defaultFilter()) return QString();
+
+  QString cacheDir = keysCacheDir();
+
+  if (!QDir().mkpath(cacheDir)) return QString();
+
+  return QDir::toNativeSeparators(QString("%1/%2-db%3.keys")
+                                      .arg(cacheDir)
+                                      .arg(keysCacheId(filter))
+                                      .arg(dbIndex));
+}
+
+void TreeOperations::removeKeysCache() {
+  QDir cacheDir(keysCacheDir());
+
+  if (!cacheDir.exists()) return;
+
+  auto files = cacheDir.entryList(
+      {QString("%1-db*.keys").arg(keysCacheId(defaultFilter()))}, QDir::Files);
+
+  for (const auto& file : files) {
+    ConnectionsTree::KeysDiskCache::remove(
+        QDir::toNativeSeparators(cacheDir.filePath(file)));
+  }
+}
+
+void TreeOperations::invalidateScanResults(uint dbIndex) {
+  m_scanResults->invalidate(dbIndex);
+}
+
+qint64 TreeOperations::scanResultsMemory() {
+  return m_scanResults->usedMemory();
+}
+
+void TreeOperations::enableKeyspaceEvents(
+    bool changeConfig, QSharedPointer<EnableKeyspaceEventsCallback> callback) {
+  getReadyConnection([this, changeConfig,
+                      callback](QSharedPointer<RedisClient::Connection> c) {
+    if (!connect(c)) return;
+
+    // NOTE: notifications are not propagated between cluster nodes
+    if (m_connection->mode() == RedisClient::Connection::Mode::Cluster) {
+      return callback->call(
+          false, QCoreApplication::translate(
+                     "RESP",
+                     "Keyspace notifications are not supported in cluster "
+                     "mode"));
+    }
+
+    auto processErr = [callback](const QString& err) {
+      return callback->call(
+          false, QCoreApplication::translate(
+                     "RESP", "Cannot enable keyspace notifications: %1")
+                     .arg(err));
+    };
+
+    try {
+      m_connection->cmd(
+          {"CONFIG", "GET", "notify-keyspace-events"}, this, -1,
+          [this, changeConfig, callback,
+           processErr](const RedisClient::Response& r) {
+            QVariantList config = r.value().toList();
+
+            if (r.isErrorMessage() || config.size() != 2) {
+              return processErr(r.value().toString());
+            }
+
+            QByteArray flags = config.at(1).toByteArray();
+
+            if (KeyspaceNotificationsListener::isEnabled(flags)) {
+              return callback->call(true, QString());
+            }
+
+            if (!changeConfig) return callback->call(false, QString());
+
+            m_connection->cmd(
+                {"CONFIG", "SET", "notify-keyspace-events",
+                 KeyspaceNotificationsListener::requiredFlags(flags)},
+                this, -1,
+                [callback, processErr](const RedisClient::Response& r) {
+                  if (r.isErrorMessage()) {
+                    return processErr(r.value().toString());
+                  }
+                  callback->call(true, QString());
+                },
+                processErr);
+          },
+          processErr);
+    } catch (const RedisClient::Connection::Exception& error) {
+      processErr(error.what());
+    }
+  });
+}
+
+QFuture<void> TreeOperations::subscribeToKeyspaceEvents(
+    uint dbIndex, const QString& filter,
+    QSharedPointer<KeyspaceEventsCallback> callback) {
+  QString keyPattern = filter.isEmpty() ? m_config.keysPattern() : filter;
+
+  auto d = QSharedPointer<AsyncFuture::Deferred<void>>(
+      new AsyncFuture::Deferred<void>());
+
+  getReadyConnection([this, dbIndex, keyPattern, callback,
+                      d](QSharedPointer<RedisClient::Connection> c) {
+    if (!connect(c)) return;
+
+    auto listener = new KeyspaceNotificationsListener(m_connection->clone(),
+                                                      dbIndex, keyPattern);
+    auto scanResults = m_scanResults;
+
+    listener->start(
+        [callback, scanResults, dbIndex](
+            const RedisClient::Connection::RawKeysList& added,
+            const RedisClient::Connection::RawKeysList& removed) {
+          if (!added.isEmpty() || !removed.isEmpty())
+            scanResults->invalidate(dbIndex);
+
+          callback->call(added, removed, QString());
+        },
+        [callback, d](const QString& err) {
+          d->complete();
+          callback->call(RedisClient::Connection::RawKeysList(),
+                         RedisClient::Connection::RawKeysList(), err);
+        },
+        [callback, d]() {
+          return d->future().isCanceled() || !callback->isValid();
+        });
+  });
+
+  return d->future();
 }
 
 QString TreeOperations::mode() {
@@ -521,6 +1224,8 @@ QSharedPointer<RedisClient::Connection> TreeOperations::connection()
 }
 
 void TreeOperations::setConnection(QSharedPointer<RedisClient::Connection> c) {
+  resetMemoryConnectionsPool();
+  m_memoryOperationsSupport = QFuture<bool>();
   m_connection = c;
   m_events->registerLoggerForConnection(*c);
 }
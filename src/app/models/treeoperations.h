@@ -1,11 +1,13 @@
 ﻿#pragma once
 #include <QEnableSharedFromThis>
+#include <QMutex>
 #include <QObject>
 #include <QSharedPointer>
 #include <functional>
 
 #include "app/models/connectionconf.h"
 #include "connections-tree/items/keyitem.h"
+#include "connections-tree/scanresultscache.h"
 #include "modules/bulk-operations/bulkoperationsmanager.h"
 #include "modules/connections-tree/operations.h"
 
@@ -28,8 +30,17 @@ class TreeOperations : public QObject,
 
   void loadNamespaceItems(
       uint dbIndex, const QString& filter,
-      QSharedPointer<LoadNamespaceItemsCallback> callback)
-      override;
+      QSharedPointer<LoadNamespaceItemsCallback> callback,
+      QSharedPointer<ScanProgressCallback> progress =
+          QSharedPointer<ScanProgressCallback>()) override;
+
+  QFuture<void> loadNamespaceItemsIncrementally(
+      uint dbIndex, const QString& filter,
+      QSharedPointer<LoadNamespaceItemsBatchCallback> callback) override;
+
+  QFuture<void> loadNamespacesSummary(
+      uint dbIndex, const QString& filter, int prefixLength, int depth,
+      QSharedPointer<LoadNamespacesSummaryCallback> callback) override;
 
   void disconnect() override;
 
@@ -81,10 +92,35 @@ class TreeOperations : public QObject,
       QSharedPointer<ConnectionsTree::DatabaseItem> parent,
       QSharedPointer<OpenKeyIfExistsCallback> callback) override;
 
-  virtual void getUsedMemory(const QList<QByteArray>& keys, int dbIndex,
+  virtual void getUsedMemory(const ConnectionsTree::RawKeys& keys, int dbIndex,
                              QSharedPointer<GetUsedMemoryCallback> result,
                              QSharedPointer<GetUsedMemoryCallback> progress) override;
 
+  virtual void getKeysMemory(const RedisClient::Connection::RawKeysList& keys,
+                             int dbIndex,
+                             QSharedPointer<GetKeysMemoryCallback> result) override;
+
+  virtual void getKeysMetadata(
+      const RedisClient::Connection::RawKeysList& keys, int dbIndex,
+      QSharedPointer<GetKeysMetadataCallback> result) override;
+
+  virtual QString keysCachePath(uint dbIndex, const QString& filter) override;
+
+  // Removes keys cached on disk for all databases of the connection
+  void removeKeysCache();
+
+  void invalidateScanResults(uint dbIndex) override;
+
+  qint64 scanResultsMemory() override;
+
+  void enableKeyspaceEvents(
+      bool changeConfig,
+      QSharedPointer<EnableKeyspaceEventsCallback> callback) override;
+
+  QFuture<void> subscribeToKeyspaceEvents(
+      uint dbIndex, const QString& filter,
+      QSharedPointer<KeyspaceEventsCallback> callback) override;
+
   virtual QString mode() override;
 
   virtual bool isConnected() const override;
@@ -124,6 +160,38 @@ signals:
 
   bool connect(QSharedPointer<RedisClient::Connection> c);
 
+  QString updateFilterHistory(const QString& filter);
+
+  void scanNamespaceItems(uint dbIndex, const QString& keyPattern,
+                          QSharedPointer<LoadNamespaceItemsCallback> callback,
+                          QSharedPointer<ScanProgressCallback> progress);
+
+  void scanKeysBatch(uint dbIndex, const QString& keyPattern,
+                     qlonglong scanLimit, qlonglong cursor,
+                     QSharedPointer<LoadNamespaceItemsBatchCallback> callback,
+                     QSharedPointer<AsyncFuture::Deferred<void>> d);
+
+  struct NamespacesSummaryResult {
+    RedisClient::Connection::RawKeysList keys;
+    NamespacesSummary namespaces;
+  };
+
+  void aggregateKeysBatch(
+      uint dbIndex, const QString& keyPattern, int prefixLength, int depth,
+      qlonglong scanLimit, const QByteArray& cursor,
+      QSharedPointer<NamespacesSummaryResult> result,
+      QSharedPointer<LoadNamespacesSummaryCallback> callback,
+      QSharedPointer<AsyncFuture::Deferred<void>> d);
+
+  QList<QSharedPointer<RedisClient::Connection>> memoryConnectionsPool();
+
+  void resetMemoryConnectionsPool();
+
+  // Runs MEMORY USAGE for keys split between connections of the pool
+  void runMemoryUsage(const ConnectionsTree::RawKeys& keys, int dbIndex,
+                      std::function<void(int, qlonglong)> onKeyProcessed,
+                      std::function<void()> onFinished);
+
   void requestBulkOperation(
       ConnectionsTree::AbstractNamespaceItem& ns,
       BulkOperations::Manager::Operation op,
@@ -134,6 +202,9 @@ signals:
       PendingOperation;
   void getReadyConnection(PendingOperation callback);
 
+  QString keysCacheDir();
+  QString keysCacheId(const QString& filter);
+
  private:
   QSharedPointer<RedisClient::Connection> m_connection;
   QSharedPointer<Events> m_events;
@@ -141,7 +212,11 @@ signals:
   RedisClient::Connection::Mode m_connectionMode;
   ServerConfig m_config;
   QVariantMap m_filterHistory;
+  QSharedPointer<ConnectionsTree::ScanResultsCache> m_scanResults;
   QWeakPointer<ConnectionsTree::ServerItem> m_serverItem;
   QSharedPointer<AsyncFuture::Deferred<void>> m_dbScanOp;
   PendingOperation m_pendingOperation;
+  QList<QSharedPointer<RedisClient::Connection>> m_memoryConnections;
+  QMutex m_memoryConnectionsMutex;
+  QFuture<bool> m_memoryOperationsSupport;
 };
@@ -1,5 +1,8 @@
 #include "abstractoperation.h"
 #include <qredisclient/utils/text.h>
+#include <QSettings>
+
+#include "modules/common/clusterkeysloader.h"
 
 BulkOperations::AbstractOperation::AbstractOperation(
     QSharedPointer<RedisClient::Connection> connection, int dbIndex,
@@ -40,7 +43,13 @@ void BulkOperations::AbstractOperation::getAffectedKeys(
     }
 
     if (m_connection->mode() == RedisClient::Connection::Mode::Cluster) {
-      m_connection->getClusterKeys(processingCallback, m_keyPattern.pattern());
+      QSettings settings;
+
+      auto loader = new ClusterKeysLoader(
+          m_connection, m_keyPattern.pattern(),
+          settings.value("app/scanLimit", DEFAULT_SCAN_LIMIT).toLongLong());
+
+      loader->load(processingCallback);
     } else {
       m_connection->getDatabaseKeys(processingCallback, m_keyPattern.pattern(),
                                     m_dbIndex);
@@ -0,0 +1,290 @@
+#include "clusterkeysloader.h"
+
+#include <asyncfuture.h>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QPointer>
+#include <QSettings>
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+ClusterKeysLoader::ClusterKeysLoader(
+    QSharedPointer<RedisClient::Connection> connection, const QString& pattern,
+    qlonglong scanLimit)
+    : m_connection(connection),
+      m_pattern(pattern),
+      m_scanLimit(scanLimit),
+      m_nextNode(0),
+      m_runningNodes(0),
+      m_failed(false) {
+  // Loader can be created in a worker thread, responses are processed in
+  // the main thread
+  moveToThread(QCoreApplication::instance()->thread());
+}
+
+void ClusterKeysLoader::load(
+    RedisClient::Connection::RawKeysListCallback callback,
+    ProgressCallback progress) {
+  m_callback = callback;
+  m_progress = progress;
+
+  QTimer::singleShot(0, this, [this]() { loadMasterNodes(); });
+}
+
+int ClusterKeysLoader::parallelismLimit() {
+  QSettings settings;
+  return qMax(1, settings.value("app/clusterScanParallelism", 8).toInt());
+}
+
+void ClusterKeysLoader::loadMasterNodes() {
+  m_connection->cmd(
+      {"CLUSTER", "NODES"}, this, -1,
+      [this](const RedisClient::Response& r) {
+        if (r.isErrorMessage()) {
+          return fallbackToClusterKeys(r.value().toString());
+        }
+
+        auto defaultConfig = m_connection->getConfig();
+        auto lines = r.value().toByteArray().split('\n');
+
+        // <id> <ip:port@cport[,hostname]> <flags> <master> <ping-sent>
+        // <pong-recv> <config-epoch> <link-state> <slot> <slot> ...
+        for (const QByteArray& line : qAsConst(lines)) {
+          auto parts = line.trimmed().split(' ');
+
+          // Masters without slots don't have keys
+          if (parts.size() < 9) continue;
+
+          auto flags = parts.at(2).split(',');
+
+          if (!flags.contains("master") || flags.contains("fail") ||
+              flags.contains("noaddr") || flags.contains("handshake"))
+            continue;
+
+          QByteArray address = parts.at(1);
+          int cportPos = address.indexOf('@');
+          if (cportPos >= 0) address = address.left(cportPos);
+
+          int portPos = address.lastIndexOf(':');
+          if (portPos < 0) continue;
+
+          QString host = QString::fromUtf8(address.left(portPos));
+          int port = address.mid(portPos + 1).toInt();
+
+          auto config = defaultConfig;
+          config.setHost(host.isEmpty() ? defaultConfig.host() : host);
+          config.setPort(port);
+          m_nodes.append(config);
+        }
+
+        if (m_nodes.isEmpty()) {
+          return fallbackToClusterKeys("master nodes not found");
+        }
+
+        for (int i = 0; i < m_nodes.size(); i++) {
+          m_nodesKeys.append(RedisClient::Connection::RawKeysList());
+        }
+
+        int workers = qMin(parallelismLimit(), m_nodes.size());
+
+        for (int i = 0; i < workers; i++) {
+          scanNextNode();
+        }
+      },
+      [this](const QString& err) { fallbackToClusterKeys(err); });
+}
+
+void ClusterKeysLoader::scanNextNode() {
+  if (m_failed || m_nextNode >= m_nodes.size()) return;
+
+  int node = m_nextNode++;
+  m_runningNodes++;
+
+  auto config = m_nodes.at(node);
+
+  auto future = QtConcurrent::run(
+      [config]() -> QSharedPointer<RedisClient::Connection> {
+        auto c = QSharedPointer<RedisClient::Connection>(
+            new RedisClient::Connection(config));
+
+        try {
+          if (c->connect(true)) return c;
+        } catch (const RedisClient::Connection::Exception& e) {
+          qWarning() << "Cannot connect to cluster node:" << e.what();
+        }
+
+        return QSharedPointer<RedisClient::Connection>();
+      });
+
+  QPointer<ClusterKeysLoader> self(this);
+
+  AsyncFuture::observe(future).subscribe([self, this, node, future]() {
+    auto c = future.result();
+
+    // Loader fell back to getClusterKeys() while the node was connecting
+    if (!self || m_failed) {
+      if (c) QtConcurrent::run([c]() { c->disconnect(); });
+      return;
+    }
+
+    if (!c) {
+      return fallbackToClusterKeys(
+          QString("%1 is not reachable").arg(nodeName(node)));
+    }
+
+    m_nodeConnections.insert(node, c);
+    scanNode(node, c, 0);
+  });
+}
+
+void ClusterKeysLoader::scanNode(int node,
+                                 QSharedPointer<RedisClient::Connection> c,
+                                 qlonglong cursor) {
+  if (m_failed) return;
+
+  c->cmd(
+      {"SCAN", QByteArray::number(cursor), "MATCH", m_pattern.toUtf8(),
+       "COUNT", QByteArray::number(m_scanLimit)},
+      this, -1,
+      [this, node, c](const RedisClient::Response& r) {
+        if (m_failed) return;
+
+        if (!r.isValidScanResponse()) {
+          return fallbackToClusterKeys(r.value().toString());
+        }
+
+        auto& keys = m_nodesKeys[node];
+        auto collection = r.getCollection();
+        keys.reserve(keys.size() + collection.size());
+
+        for (const auto& key : qAsConst(collection)) {
+          keys.append(key.toByteArray());
+        }
+
+        qlonglong nextCursor = r.getCursor();
+
+        if (nextCursor <= 0) return finishNode(node, c);
+
+        if (m_progress) m_progress(nodeName(node), keys.size(), false);
+
+        scanNode(node, c, nextCursor);
+      },
+      [this](const QString& err) { fallbackToClusterKeys(err); });
+}
+
+void ClusterKeysLoader::finishNode(int node,
+                                   QSharedPointer<RedisClient::Connection> c) {
+  m_nodeConnections.remove(node);
+  QtConcurrent::run([c]() { c->disconnect(); });
+
+  if (m_progress) {
+    m_progress(nodeName(node), m_nodesKeys.at(node).size(), true);
+  }
+
+  m_runningNodes--;
+
+  if (m_nextNode < m_nodes.size()) {
+    return scanNextNode();
+  }
+
+  if (m_runningNodes == 0) mergeNodesKeys();
+}
+
+void ClusterKeysLoader::mergeNodesKeys() {
+  auto nodesKeys = m_nodesKeys;
+  m_nodesKeys.clear();
+
+  auto future = QtConcurrent::run([nodesKeys]() mutable {
+    QtConcurrent::blockingMap(
+        nodesKeys, [](RedisClient::Connection::RawKeysList& keys) {
+          std::sort(keys.begin(), keys.end());
+        });
+
+    return merge(nodesKeys);
+  });
+
+  QPointer<ClusterKeysLoader> self(this);
+
+  AsyncFuture::observe(future).subscribe([self, this, future]() {
+    if (!self) return;
+
+    m_callback(future.result(), QString());
+    deleteLater();
+  });
+}
+
+QString ClusterKeysLoader::nodeName(int node) const {
+  return QString("%1:%2")
+      .arg(m_nodes.at(node).host())
+      .arg(m_nodes.at(node).port());
+}
+
+void ClusterKeysLoader::fallbackToClusterKeys(const QString& reason) {
+  if (m_failed) return;
+
+  m_failed = true;
+
+  qWarning() << "Cannot scan cluster nodes concurrently:" << reason;
+
+  closeNodeConnections();
+
+  try {
+    m_connection->getClusterKeys(m_callback, m_pattern, m_scanLimit);
+  } catch (const RedisClient::Connection::Exception& e) {
+    m_callback(RedisClient::Connection::RawKeysList(), QString(e.what()));
+  }
+
+  deleteLater();
+}
+
+void ClusterKeysLoader::closeNodeConnections() {
+  for (auto c : qAsConst(m_nodeConnections)) {
+    QtConcurrent::run([c]() { c->disconnect(); });
+  }
+
+  m_nodeConnections.clear();
+}
+
+RedisClient::Connection::RawKeysList ClusterKeysLoader::merge(
+    const QList<RedisClient::Connection::RawKeysList>& sortedKeys) {
+  // Position of the next key in the sorted list
+  using Cursor = QPair<int, int>;
+
+  auto isGreater = [&sortedKeys](const Cursor& a, const Cursor& b) {
+    return sortedKeys.at(b.first).at(b.second) <
+           sortedKeys.at(a.first).at(a.second);
+  };
+
+  std::priority_queue<Cursor, std::vector<Cursor>, decltype(isGreater)> heap(
+      isGreater);
+
+  int total = 0;
+
+  for (int i = 0; i < sortedKeys.size(); i++) {
+    if (sortedKeys.at(i).isEmpty()) continue;
+
+    heap.push({i, 0});
+    total += sortedKeys.at(i).size();
+  }
+
+  RedisClient::Connection::RawKeysList result;
+  result.reserve(total);
+
+  while (!heap.empty()) {
+    Cursor cursor = heap.top();
+    heap.pop();
+
+    const QByteArray& key = sortedKeys.at(cursor.first).at(cursor.second);
+
+    if (result.isEmpty() || result.last() != key) result.append(key);
+
+    if (cursor.second + 1 < sortedKeys.at(cursor.first).size()) {
+      heap.push({cursor.first, cursor.second + 1});
+    }
+  }
+
+  return result;
+}
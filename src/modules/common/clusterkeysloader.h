@@ -0,0 +1,57 @@
+#pragma once
+#include <qredisclient/connection.h>
+#include <QHash>
+#include <QObject>
+#include <functional>
+
+/*
+ * Loads keys of redis cluster: master nodes are scanned concurrently with
+ * dedicated connections, sorted keys of nodes are merged with k-way merge.
+ * If nodes cannot be reached directly keys are loaded with getClusterKeys().
+ *
+ * Loader deletes itself when keys are passed to the callback.
+ */
+class ClusterKeysLoader : public QObject {
+  Q_OBJECT
+
+ public:
+  using ProgressCallback =
+      std::function<void(const QString& node, qlonglong keys, bool finished)>;
+
+  ClusterKeysLoader(QSharedPointer<RedisClient::Connection> connection,
+                    const QString& pattern, qlonglong scanLimit);
+
+  void load(RedisClient::Connection::RawKeysListCallback callback,
+            ProgressCallback progress = ProgressCallback());
+
+  // Maximum amount of nodes scanned at the same time
+  static int parallelismLimit();
+
+  static RedisClient::Connection::RawKeysList merge(
+      const QList<RedisClient::Connection::RawKeysList>& sortedKeys);
+
+ private:
+  void loadMasterNodes();
+  void scanNextNode();
+  void scanNode(int node, QSharedPointer<RedisClient::Connection> c,
+                qlonglong cursor);
+  void finishNode(int node, QSharedPointer<RedisClient::Connection> c);
+  void mergeNodesKeys();
+  void fallbackToClusterKeys(const QString& reason);
+  void closeNodeConnections();
+  QString nodeName(int node) const;
+
+ private:
+  QSharedPointer<RedisClient::Connection> m_connection;
+  QString m_pattern;
+  qlonglong m_scanLimit;
+  RedisClient::Connection::RawKeysListCallback m_callback;
+  ProgressCallback m_progress;
+  QList<RedisClient::ConnectionConfig> m_nodes;
+  QList<RedisClient::Connection::RawKeysList> m_nodesKeys;
+  // Connections of nodes which are scanned now
+  QHash<int, QSharedPointer<RedisClient::Connection>> m_nodeConnections;
+  int m_nextNode;
+  int m_runningNodes;
+  bool m_failed;
+};
@@ -0,0 +1,170 @@
+#include "keyspacenotifications.h"
+
+#include <asyncfuture.h>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QPointer>
+#include <QtConcurrent>
+
+namespace {
+// Events are applied to the keys tree at most once per interval
+const int FLUSH_INTERVAL = 1000;
+
+// Key-space events of generic commands, expired and evicted keys and all
+// data types
+const QByteArray REQUIRED_CLASSES = "g$lshzxe";
+}  // namespace
+
+KeyspaceNotificationsListener::KeyspaceNotificationsListener(
+    QSharedPointer<RedisClient::Connection> connection, uint dbIndex,
+    const QString& pattern)
+    : m_connection(connection),
+      m_channelPrefix(QString("__keyspace@%1__:").arg(dbIndex).toUtf8()),
+      m_pattern(pattern),
+      m_flushTimer(this),
+      m_stopped(false) {
+  // Listener can be created in a worker thread, messages are processed in
+  // the main thread
+  moveToThread(QCoreApplication::instance()->thread());
+
+  m_flushTimer.setInterval(FLUSH_INTERVAL);
+
+  QObject::connect(&m_flushTimer, &QTimer::timeout, this,
+                   &KeyspaceNotificationsListener::flush);
+}
+
+void KeyspaceNotificationsListener::start(EventsCallback events,
+                                          ErrorCallback error,
+                                          CanceledCallback isCanceled) {
+  m_events = events;
+  m_error = error;
+  m_isCanceled = isCanceled;
+
+  QTimer::singleShot(0, this, [this]() { subscribe(); });
+}
+
+bool KeyspaceNotificationsListener::isEnabled(const QByteArray& flags) {
+  if (!flags.contains('K')) return false;
+
+  if (flags.contains('A')) return true;
+
+  for (char c : REQUIRED_CLASSES) {
+    if (!flags.contains(c)) return false;
+  }
+
+  return true;
+}
+
+QByteArray KeyspaceNotificationsListener::requiredFlags(
+    const QByteArray& flags) {
+  QByteArray result = flags;
+
+  if (!result.contains('K')) result.append('K');
+  if (!result.contains('A')) result.append('A');
+
+  return result;
+}
+
+bool KeyspaceNotificationsListener::keyExistsAfter(const QByteArray& event) {
+  // NOTE: commands which leave an empty collection emit "del" event too
+  return !(event == "del" || event == "expired" || event == "evicted" ||
+           event == "rename_from" || event == "move_from");
+}
+
+void KeyspaceNotificationsListener::subscribe() {
+  auto connection = m_connection;
+
+  auto future = QtConcurrent::run([connection]() {
+    try {
+      return connection->connect(true);
+    } catch (const RedisClient::Connection::Exception& e) {
+      qWarning() << "Cannot connect to receive keyspace events:" << e.what();
+    }
+    return false;
+  });
+
+  QPointer<KeyspaceNotificationsListener> self(this);
+
+  AsyncFuture::observe(future).subscribe([self, this, future]() {
+    if (!self || m_stopped) return;
+
+    if (!future.result()) {
+      return stop(QCoreApplication::translate(
+          "RESP", "Cannot connect to receive keyspace events"));
+    }
+
+    QObject::connect(m_connection.data(), &RedisClient::Connection::error,
+                     this, [this](const QString& err) { stop(err); });
+
+    m_connection->cmd(
+        {"PSUBSCRIBE", m_channelPrefix + m_pattern.toUtf8()}, this, -1,
+        [this](const RedisClient::Response& r) { processMessage(r); },
+        [this](const QString& err) { stop(err); });
+
+    m_flushTimer.start();
+  });
+}
+
+void KeyspaceNotificationsListener::processMessage(
+    const RedisClient::Response& r) {
+  if (m_stopped) return;
+
+  if (r.isErrorMessage()) {
+    return stop(r.value().toString());
+  }
+
+  if (r.type() != RedisClient::Response::Array) return;
+
+  // pmessage <pattern> <channel> <event>
+  QVariantList msg = r.value().toList();
+
+  if (msg.size() != 4 || msg[0].toByteArray() != "pmessage") return;
+
+  QByteArray channel = msg[2].toByteArray();
+
+  if (!channel.startsWith(m_channelPrefix)) return;
+
+  m_pendingKeys.insert(channel.mid(m_channelPrefix.size()),
+                       keyExistsAfter(msg[3].toByteArray()));
+}
+
+void KeyspaceNotificationsListener::flush() {
+  if (m_stopped) return;
+
+  if (m_isCanceled && m_isCanceled()) return stop();
+
+  if (m_pendingKeys.isEmpty()) return;
+
+  RedisClient::Connection::RawKeysList added;
+  RedisClient::Connection::RawKeysList removed;
+
+  for (auto it = m_pendingKeys.constBegin(); it != m_pendingKeys.constEnd();
+       ++it) {
+    if (it.value())
+      added.append(it.key());
+    else
+      removed.append(it.key());
+  }
+
+  m_pendingKeys.clear();
+
+  if (m_events) m_events(added, removed);
+}
+
+void KeyspaceNotificationsListener::stop(const QString& err) {
+  if (m_stopped) return;
+
+  m_stopped = true;
+  m_flushTimer.stop();
+
+  if (!err.isEmpty()) {
+    qWarning() << "Keyspace notifications subscription is lost:" << err;
+
+    if (m_error) m_error(err);
+  }
+
+  auto connection = m_connection;
+  QtConcurrent::run([connection]() { connection->disconnect(); });
+
+  deleteLater();
+}
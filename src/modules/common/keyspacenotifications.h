@@ -0,0 +1,61 @@
+#pragma once
+#include <qredisclient/connection.h>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <functional>
+
+/*
+ * Listens to __keyspace@N__ notifications on a dedicated connection and
+ * reports created and removed keys in batches. Events of the same key
+ * received between flushes are coalesced, the last event wins.
+ *
+ * Listener deletes itself when it is stopped or the connection is lost.
+ */
+class KeyspaceNotificationsListener : public QObject {
+  Q_OBJECT
+
+ public:
+  using EventsCallback =
+      std::function<void(const RedisClient::Connection::RawKeysList& added,
+                         const RedisClient::Connection::RawKeysList& removed)>;
+
+  // Called once when subscription is lost, events could be dropped
+  using ErrorCallback = std::function<void(const QString& err)>;
+
+  // Polled on each flush, listener unsubscribes when it returns true
+  using CanceledCallback = std::function<bool()>;
+
+  KeyspaceNotificationsListener(
+      QSharedPointer<RedisClient::Connection> connection, uint dbIndex,
+      const QString& pattern);
+
+  void start(EventsCallback events, ErrorCallback error,
+             CanceledCallback isCanceled);
+
+  // Checks notify-keyspace-events value
+  static bool isEnabled(const QByteArray& flags);
+
+  // Value of notify-keyspace-events which keeps current flags
+  static QByteArray requiredFlags(const QByteArray& flags);
+
+  // Returns false if the event removes the key
+  static bool keyExistsAfter(const QByteArray& event);
+
+ private:
+  void subscribe();
+  void processMessage(const RedisClient::Response& r);
+  void flush();
+  void stop(const QString& err = QString());
+
+ private:
+  QSharedPointer<RedisClient::Connection> m_connection;
+  QByteArray m_channelPrefix;
+  QString m_pattern;
+  EventsCallback m_events;
+  ErrorCallback m_error;
+  CanceledCallback m_isCanceled;
+  QHash<QByteArray, bool> m_pendingKeys;
+  QTimer m_flushTimer;
+  bool m_stopped;
+};
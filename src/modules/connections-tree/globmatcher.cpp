@@ -0,0 +1,251 @@
+#include "globmatcher.h"
+
+#include <QtConcurrent>
+#include <algorithm>
+#include <vector>
+
+using namespace ConnectionsTree;
+
+namespace {
+// Smaller lists are filtered in the calling thread
+const int FILTER_CHUNK_SIZE = 50000;
+
+bool isWildcard(char c) { return c == '*' || c == '?' || c == '['; }
+
+bool matchGlobImpl(const char* pattern, int patternLen, const char* str,
+                   int strLen, bool* skipLongerMatches) {
+  while (patternLen > 0 && strLen > 0) {
+    switch (pattern[0]) {
+      case '*':
+        while (patternLen > 1 && pattern[1] == '*') {
+          pattern++;
+          patternLen--;
+        }
+
+        if (patternLen == 1) return true;
+
+        while (strLen > 0) {
+          if (matchGlobImpl(pattern + 1, patternLen - 1, str, strLen,
+                            skipLongerMatches))
+            return true;
+
+          // Rest of the pattern doesn't match any suffix, longer ones too
+          if (*skipLongerMatches) return false;
+
+          str++;
+          strLen--;
+        }
+
+        *skipLongerMatches = true;
+        return false;
+      case '?':
+        str++;
+        strLen--;
+        break;
+      case '[': {
+        pattern++;
+        patternLen--;
+
+        bool negate = patternLen > 0 && pattern[0] == '^';
+
+        if (negate) {
+          pattern++;
+          patternLen--;
+        }
+
+        bool matched = false;
+        auto c = static_cast<unsigned char>(str[0]);
+
+        while (true) {
+          if (patternLen == 0) {
+            // Unterminated set, the last pattern character is consumed below
+            pattern--;
+            patternLen++;
+            break;
+          } else if (pattern[0] == '\\' && patternLen >= 2) {
+            pattern++;
+            patternLen--;
+            if (static_cast<unsigned char>(pattern[0]) == c) matched = true;
+          } else if (pattern[0] == ']') {
+            break;
+          } else if (patternLen >= 3 && pattern[1] == '-') {
+            auto start = static_cast<unsigned char>(pattern[0]);
+            auto end = static_cast<unsigned char>(pattern[2]);
+
+            if (start > end) std::swap(start, end);
+
+            pattern += 2;
+            patternLen -= 2;
+
+            if (c >= start && c <= end) matched = true;
+          } else if (static_cast<unsigned char>(pattern[0]) == c) {
+            matched = true;
+          }
+
+          pattern++;
+          patternLen--;
+        }
+
+        if (negate) matched = !matched;
+
+        if (!matched) return false;
+
+        str++;
+        strLen--;
+        break;
+      }
+      case '\\':
+        if (patternLen >= 2) {
+          pattern++;
+          patternLen--;
+        }
+        // fall through
+      default:
+        if (pattern[0] != str[0]) return false;
+
+        str++;
+        strLen--;
+        break;
+    }
+
+    pattern++;
+    patternLen--;
+
+    if (strLen == 0) {
+      while (patternLen > 0 && pattern[0] == '*') {
+        pattern++;
+        patternLen--;
+      }
+      break;
+    }
+  }
+
+  return patternLen == 0 && strLen == 0;
+}
+}  // namespace
+
+GlobMatcher::GlobMatcher(const QByteArray& pattern)
+    : m_pattern(pattern), m_exact(true), m_prefixPattern(false) {
+  QByteArray fragment;
+  QByteArray longestFragment;
+  bool prefixFinished = false;
+  int wildcards = 0;
+
+  auto finishFragment = [&]() {
+    if (!prefixFinished) m_prefix = fragment;
+    prefixFinished = true;
+
+    if (fragment.size() > longestFragment.size()) longestFragment = fragment;
+    fragment.clear();
+  };
+
+  for (int i = 0; i < pattern.size(); i++) {
+    char c = pattern.at(i);
+
+    if (c == '\\' && i + 1 < pattern.size()) {
+      fragment.append(pattern.at(++i));
+      continue;
+    }
+
+    if (!isWildcard(c)) {
+      fragment.append(c);
+      continue;
+    }
+
+    m_exact = false;
+    wildcards++;
+    finishFragment();
+
+    m_prefixPattern = wildcards == 1 && c == '*' && i == pattern.size() - 1;
+
+    if (c != '[') continue;
+
+    // Skip character set, it never contributes to literal fragments
+    for (i++; i < pattern.size() && pattern.at(i) != ']'; i++) {
+      if (pattern.at(i) == '\\') i++;
+    }
+  }
+
+  if (m_exact) {
+    m_prefix = fragment;
+    longestFragment = fragment;
+  } else {
+    finishFragment();
+  }
+
+  m_literal.setPattern(longestFragment);
+  m_matchAll = pattern.isEmpty() ||
+               std::all_of(pattern.begin(), pattern.end(),
+                           [](char c) { return c == '*'; });
+}
+
+bool GlobMatcher::match(const QByteArray& key) const {
+  if (m_matchAll) return true;
+
+  if (m_exact) return key == m_prefix;
+
+  if (!key.startsWith(m_prefix)) return false;
+
+  if (!m_literal.pattern().isEmpty() && m_literal.indexIn(key) < 0)
+    return false;
+
+  return matchGlob(m_pattern.constData(), m_pattern.size(), key.constData(),
+                   key.size());
+}
+
+bool GlobMatcher::isSubsetOf(const GlobMatcher& other) const {
+  if (other.m_matchAll || m_pattern == other.m_pattern) return true;
+
+  if (m_matchAll) return false;
+
+  if (other.m_exact) return m_exact && m_prefix == other.m_prefix;
+
+  // Keys matched by the pattern start with its literal prefix
+  if (other.m_prefixPattern) return m_prefix.startsWith(other.m_prefix);
+
+  return false;
+}
+
+RedisClient::Connection::RawKeysList GlobMatcher::filter(
+    const RawKeys& keys) const {
+  auto filterChunk = [this](const RawKeys& chunk) {
+    RedisClient::Connection::RawKeysList result;
+
+    chunk.forEach([this, &result](const QByteArray& key) {
+      // Key passed to the callback doesn't own data
+      if (match(key)) result.append(QByteArray(key.constData(), key.size()));
+    });
+
+    return result;
+  };
+
+  if (keys.size() <= FILTER_CHUNK_SIZE) return filterChunk(keys);
+
+  QList<int> chunks;
+
+  for (int pos = 0; pos < keys.size(); pos += FILTER_CHUNK_SIZE) {
+    chunks.append(pos);
+  }
+
+  std::vector<RedisClient::Connection::RawKeysList> results(chunks.size());
+
+  QtConcurrent::blockingMap(chunks, [&keys, &results,
+                                     &filterChunk](const int& pos) {
+    results[pos / FILTER_CHUNK_SIZE] =
+        filterChunk(keys.mid(pos, FILTER_CHUNK_SIZE));
+  });
+
+  RedisClient::Connection::RawKeysList filtered;
+
+  for (const auto& result : results) {
+    filtered.append(result);
+  }
+
+  return filtered;
+}
+
+bool GlobMatcher::matchGlob(const char* pattern, int patternLen,
+                            const char* str, int strLen) {
+  bool skipLongerMatches = false;
+  return matchGlobImpl(pattern, patternLen, str, strLen, &skipLongerMatches);
+}
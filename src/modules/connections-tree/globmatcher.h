@@ -0,0 +1,53 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include <QByteArray>
+#include <QByteArrayMatcher>
+
+#include "rawkeys.h"
+
+namespace ConnectionsTree {
+
+/*
+ * Matches keys with glob patterns of SCAN MATCH (*, ?, [...] and \ escapes)
+ * without converting keys to QString. The longest literal fragment of the
+ * pattern is searched first, so most of non-matching keys are rejected by
+ * substring search before the glob is evaluated.
+ */
+class GlobMatcher {
+ public:
+  explicit GlobMatcher(const QByteArray& pattern);
+
+  QByteArray pattern() const { return m_pattern; }
+
+  // Pattern matches all keys
+  bool isMatchAll() const { return m_matchAll; }
+
+  // Literal part of the pattern before the first wildcard
+  QByteArray prefix() const { return m_prefix; }
+
+  bool match(const QByteArray& key) const;
+
+  // Returns true if every key matched by the pattern is matched by the
+  // other one. Only simple cases are proven, false means unknown.
+  bool isSubsetOf(const GlobMatcher& other) const;
+
+  // Filters keys in parallel, order of keys is kept
+  // NOTE: thread-safe
+  RedisClient::Connection::RawKeysList filter(const RawKeys& keys) const;
+
+  // Same semantics as stringmatchlen() of Redis
+  static bool matchGlob(const char* pattern, int patternLen, const char* str,
+                        int strLen);
+
+ private:
+  QByteArray m_pattern;
+  QByteArray m_prefix;
+  QByteArrayMatcher m_literal;
+  bool m_matchAll;
+  bool m_exact;
+  // Literal prefix followed by a single "*"
+  bool m_prefixPattern;
+};
+
+}  // namespace ConnectionsTree
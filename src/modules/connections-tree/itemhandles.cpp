@@ -0,0 +1,126 @@
+#include "itemhandles.h"
+
+#include "items/treeitem.h"
+
+using namespace ConnectionsTree;
+
+namespace {
+// Slot index is stored in low bits, generation in high bits
+const int INDEX_BITS = sizeof(quintptr) >= 8 ? 32 : 20;
+const quintptr INDEX_MASK = (quintptr(1) << INDEX_BITS) - 1;
+const quint32 GENERATION_MASK =
+    quint32((~quintptr(0)) >> INDEX_BITS) & 0xFFFFFFFFu;
+const int MIN_SWEEP_THRESHOLD = 1024;
+}  // namespace
+
+TreeItemHandles::TreeItemHandles() : m_sweepThreshold(MIN_SWEEP_THRESHOLD) {}
+
+quintptr TreeItemHandles::makeHandle(int index, quint32 generation) {
+  return (quintptr(generation) << INDEX_BITS) | quintptr(index);
+}
+
+bool TreeItemHandles::isValid(quintptr handle, int &index) const {
+  if (handle == 0) return false;
+
+  index = static_cast<int>(handle & INDEX_MASK);
+
+  if (index >= m_slots.size()) return false;
+
+  return m_slots.at(index).generation ==
+         static_cast<quint32>(handle >> INDEX_BITS);
+}
+
+quintptr TreeItemHandles::acquire(const QSharedPointer<TreeItem> &item) {
+  if (!item) return 0;
+
+  int index = -1;
+
+  if (isValid(item->m_handle, index) && m_slots.at(index).raw == item.data() &&
+      !m_slots.at(index).item.isNull()) {
+    return item->m_handle;
+  }
+
+  if (m_freeSlots.isEmpty() && m_slots.size() >= m_sweepThreshold) {
+    sweep();
+  }
+
+  if (m_freeSlots.isEmpty()) {
+    index = m_slots.size();
+    m_slots.append({QWeakPointer<TreeItem>(), nullptr, 1});
+  } else {
+    index = m_freeSlots.takeLast();
+  }
+
+  Slot &slot = m_slots[index];
+  slot.item = item.toWeakRef();
+  slot.raw = item.data();
+
+  item->m_handle = makeHandle(index, slot.generation);
+  return item->m_handle;
+}
+
+TreeItem *TreeItemHandles::resolve(quintptr handle) {
+  int index = -1;
+
+  if (!isValid(handle, index)) return nullptr;
+
+  const Slot &slot = m_slots.at(index);
+
+  if (!slot.raw) return nullptr;
+
+  if (slot.item.isNull()) {
+    freeSlot(index);
+    return nullptr;
+  }
+
+  return slot.raw;
+}
+
+void TreeItemHandles::release(quintptr handle) {
+  int index = -1;
+
+  if (!isValid(handle, index) || !m_slots.at(index).raw) return;
+
+  freeSlot(index);
+}
+
+int TreeItemHandles::size() const {
+  int alive = 0;
+
+  for (const auto &slot : m_slots) {
+    if (slot.raw && !slot.item.isNull()) alive++;
+  }
+
+  return alive;
+}
+
+void TreeItemHandles::clear() {
+  m_slots.clear();
+  m_freeSlots.clear();
+  m_sweepThreshold = MIN_SWEEP_THRESHOLD;
+}
+
+void TreeItemHandles::freeSlot(int index) {
+  Slot &slot = m_slots[index];
+
+  slot.item.clear();
+  slot.raw = nullptr;
+
+  // Handles of the previous item in this slot become stale
+  slot.generation = (slot.generation + 1) & GENERATION_MASK;
+  if (slot.generation == 0) slot.generation = 1;
+
+  m_freeSlots.append(index);
+}
+
+void TreeItemHandles::sweep() {
+  for (int index = 0; index < m_slots.size(); ++index) {
+    const Slot &slot = m_slots.at(index);
+
+    if (slot.raw && slot.item.isNull()) freeSlot(index);
+  }
+
+  // Slab grows at least twice before the next sweep, so sweeps are amortized
+  int alive = m_slots.size() - m_freeSlots.size();
+  m_sweepThreshold = qMax(MIN_SWEEP_THRESHOLD, 2 * alive);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <QSharedPointer>
+#include <QVector>
+#include <QWeakPointer>
+
+namespace ConnectionsTree {
+
+class TreeItem;
+
+/*
+ * Slab of weak references to tree items used as QModelIndex::internalId().
+ * Handle contains slot index and slot generation, so handles of destroyed
+ * items are rejected in O(1). Slots of destroyed items are reused, slab is
+ * swept when it runs out of free slots.
+ */
+class TreeItemHandles {
+ public:
+  TreeItemHandles();
+
+  // Returns handle registered for the item or registers a new one
+  quintptr acquire(const QSharedPointer<TreeItem>& item);
+
+  TreeItem* resolve(quintptr handle);
+
+  void release(quintptr handle);
+
+  // Amount of slots referencing alive items
+  int size() const;
+
+  int capacity() const { return m_slots.size(); }
+
+  void clear();
+
+ private:
+  struct Slot {
+    QWeakPointer<TreeItem> item;
+    TreeItem* raw;
+    quint32 generation;
+  };
+
+  static quintptr makeHandle(int index, quint32 generation);
+
+  bool isValid(quintptr handle, int& index) const;
+
+  void freeSlot(int index);
+
+  void sweep();
+
+ private:
+  QVector<Slot> m_slots;
+  QVector<int> m_freeSlots;
+  int m_sweepThreshold;
+};
+
+}  // namespace ConnectionsTree
@@ -1,5 +1,6 @@
 #include "abstractnamespaceitem.h"
 
+#include <qredisclient/utils/text.h>
 #include <QApplication>
 #include <QMessageBox>
 #include <QThread>
@@ -7,6 +8,8 @@
 #include <functional>
 
 #include "connections-tree/keysrendering.h"
+#include "connections-tree/keyssorting.h"
+#include "connections-tree/memorysampling.h"
 #include "connections-tree/model.h"
 #include "connections-tree/operations.h"
 #include "keyitem.h"
@@ -24,7 +27,13 @@ AbstractNamespaceItem::AbstractNamespaceItem(
       m_filter(filter.isEmpty() ? QRegExp(operations->defaultFilter())
                                 : filter),      
       m_dbIndex(dbIndex),
-      m_runningOperation(nullptr) {
+      m_runningOperation(nullptr),
+      m_keysCounter(0),
+      m_rawKeysCounter(0),
+      m_namespacesCounter(0),
+      m_remoteKeysCount(0),
+      m_attachedToParent(false),
+      m_exactMemoryUsage(false) {
   QSettings settings;
   m_showNsOnTop = settings
                       .value("app/showNamespacesOnTop",
@@ -35,10 +44,19 @@ AbstractNamespaceItem::AbstractNamespaceItem(
 #endif
                              )
                       .toBool();
+  m_shortKeysRendering =
+      settings.value("app/namespacedKeysShortName", true).toBool();
 }
 
 QList<QSharedPointer<TreeItem>> AbstractNamespaceItem::getAllChilds() const {
-  return m_childItems;
+  QList<QSharedPointer<TreeItem>> result;
+  result.reserve(m_childRows.size());
+
+  for (int row = 0; row < m_childRows.size(); row++) {
+    result.append(materializeRow(row));
+  }
+
+  return result;
 }
 
 QList<QSharedPointer<AbstractNamespaceItem>>
@@ -47,64 +65,225 @@ AbstractNamespaceItem::getAllChildNamespaces() const {
 }
 
 QSharedPointer<TreeItem> AbstractNamespaceItem::child(uint row) {
-  if (row < m_childItems.size()) return m_childItems.at(row);
+  if (row < static_cast<uint>(m_childRows.size())) return materializeRow(row);
 
   return QSharedPointer<TreeItem>();
 }
 
+int AbstractNamespaceItem::indexOfChild(const TreeItem *item) {
+  // Flyweight rows can't hold the item, they are skipped without
+  // materialization
+  for (int row = 0; row < m_childRows.size(); row++) {
+    if (m_childRows.at(row).item.data() == item) return row;
+  }
+
+  return -1;
+}
+
 QWeakPointer<TreeItem> AbstractNamespaceItem::parent() const {
   return m_parent;
 }
 
 void AbstractNamespaceItem::append(QSharedPointer<TreeItem> item, bool notifyModel) {
+  ChildRow row{item, item && item->type() == "key" ? item->getFullPath()
+                                                   : QByteArray()};
+
   if (notifyModel)
-    m_model.beforeChildLoadedAtPos(getSelf(), m_childItems.size());
-  m_childItems.append(item);
+    m_model.beforeChildLoadedAtPos(getSelf(), m_childRows.size());
+  m_childRows.append(row);
+  countChilds({row}, 1);
   if (notifyModel) m_model.childLoaded(getSelf());
 }
 
-bool compareTreeItemsByName(QSharedPointer<TreeItem> first,
-                            QSharedPointer<TreeItem> second) {
-  return first->getDisplayName() < second->getDisplayName();
+void AbstractNamespaceItem::appendKey(const QByteArray &fullPath,
+                                      bool notifyModel) {
+  auto row = ChildRow::key(fullPath);
+
+  if (notifyModel)
+    m_model.beforeChildLoadedAtPos(getSelf(), m_childRows.size());
+  m_childRows.append(row);
+  countChilds({row}, 1);
+  if (notifyModel) m_model.childLoaded(getSelf());
 }
 
-bool compareTreeItemsByNameAndNsOnTop(QSharedPointer<TreeItem> first,
-                                      QSharedPointer<TreeItem> second) {
-  if (first->type() != second->type()) return first->type() > second->type();
+const QByteArray &AbstractNamespaceItem::rowCollationKey(
+    const ChildRow &row) const {
+  if (row.item) return row.item->collationKey();
+
+  if (!row.collationKey.isNull()) return row.collationKey;
+
+  // Names of flyweight rows are built like KeyItem::collationName() does
+  if (type() == "namespace" && m_shortKeysRendering) {
+    row.collationKey = buildCollationKey(
+        printableString(row.keyPath.mid(keysPrefix().size())));
+  } else {
+    row.collationKey = buildCollationKey(printableString(row.keyPath, true));
+  }
 
-  return first->getDisplayName() < second->getDisplayName();
+  return row.collationKey;
 }
 
-void AbstractNamespaceItem::insertChild(QSharedPointer<TreeItem> item) {
-  auto pos = std::upper_bound(m_childItems.begin(), m_childItems.end(), item,
-                              m_showNsOnTop ? compareTreeItemsByNameAndNsOnTop
-                                            : compareTreeItemsByName);
+void AbstractNamespaceItem::sortRows(ChildRows &rows) const {
+  // Collation keys are built once per row
+  QVector<QPair<QByteArray, int>> order;
+  order.reserve(rows.size());
+
+  for (int i = 0; i < rows.size(); i++) {
+    order.append({rowCollationKey(rows.at(i)), i});
+  }
+
+  auto isNamespace = [&rows](int i) {
+    return rows.at(i).item && rows.at(i).item->supportChildItems();
+  };
 
-  int index = std::distance(m_childItems.begin(), pos);
+  std::stable_sort(order.begin(), order.end(),
+                   [this, &isNamespace](const QPair<QByteArray, int> &first,
+                                        const QPair<QByteArray, int> &second) {
+                     bool firstIsNamespace = isNamespace(first.second);
+
+                     if (m_showNsOnTop &&
+                         firstIsNamespace != isNamespace(second.second))
+                       return firstIsNamespace;
+
+                     return first.first < second.first;
+                   });
+
+  ChildRows sorted;
+  sorted.reserve(rows.size());
+
+  for (const auto &entry : order) {
+    sorted.append(rows.at(entry.second));
+  }
+
+  rows = sorted;
+}
+
+void AbstractNamespaceItem::insertRow(const ChildRow &row) {
+  auto isNamespace = [](const ChildRow &r) {
+    return r.item && r.item->supportChildItems();
+  };
+
+  bool rowIsNamespace = isNamespace(row);
+
+  // Collation keys are built once per row and stored in it, so comparisons
+  // don't allocate
+  const QByteArray &collationKey = rowCollationKey(row);
+
+  auto pos = std::upper_bound(
+      m_childRows.begin(), m_childRows.end(), row,
+      [this, &isNamespace, rowIsNamespace, &collationKey](
+          const ChildRow &, const ChildRow &other) {
+        if (m_showNsOnTop && rowIsNamespace != isNamespace(other))
+          return rowIsNamespace;
+
+        return collationKey < rowCollationKey(other);
+      });
+
+  int index = std::distance(m_childRows.begin(), pos);
 
   m_model.beforeChildLoadedAtPos(getSelf(), index);
-  m_childItems.insert(pos, item);
+  m_childRows.insert(index, row);
+  countChilds({row}, 1);
   m_model.childLoaded(getSelf());
 }
 
-void AbstractNamespaceItem::appendKeyToIndex(QSharedPointer<KeyItem> key) {
-  if (!key) return;
+void AbstractNamespaceItem::insertChild(QSharedPointer<TreeItem> item) {
+  insertRow(ChildRow{item, item && item->type() == "key" ? item->getFullPath()
+                                                         : QByteArray()});
+}
 
-  m_keysIndex.insert(key->getFullPath(), key.toWeakRef());
+void AbstractNamespaceItem::insertKey(const QByteArray &fullPath) {
+  insertRow(ChildRow::key(fullPath));
 }
 
-void AbstractNamespaceItem::removeNamespacedKeysFromIndex(QByteArray nsPrefix) {
-  auto keys = m_keysIndex.keys();
+void AbstractNamespaceItem::appendChilds(
+    const QList<QSharedPointer<TreeItem>> &items, bool notifyModel) {
+  ChildRows rows;
+  rows.reserve(items.size());
+
+  for (const auto &item : items) {
+    rows.append(ChildRow{item, item->type() == "key" ? item->getFullPath()
+                                                     : QByteArray()});
+  }
+
+  appendRows(rows, notifyModel);
+}
+
+void AbstractNamespaceItem::appendRows(const ChildRows &rows,
+                                       bool notifyModel) {
+  if (rows.isEmpty()) return;
+
+  if (notifyModel) m_model.beforeChildLoaded(getSelf(), rows.size());
 
-  for (auto const &fullPath : qAsConst(keys)) {
-    if (fullPath.startsWith(nsPrefix)) {
-      m_keysIndex.remove(fullPath);
+  m_childRows.reserve(m_childRows.size() + rows.size());
+
+  for (const auto &row : rows) {
+    if (row.item && row.item->type() == "namespace") {
+      auto ns = row.item.dynamicCast<AbstractNamespaceItem>();
+      if (ns) m_childNamespaces[ns->getName()] = ns;
     }
+    m_childRows.append(row);
+  }
+
+  countChilds(rows, 1);
+
+  if (notifyModel) m_model.childLoaded(getSelf());
+}
+
+int AbstractNamespaceItem::keyRow(const QByteArray &fullPath) const {
+  for (int row = 0; row < m_childRows.size(); row++) {
+    if (m_childRows.at(row).keyPath == fullPath) return row;
+  }
+
+  return -1;
+}
+
+QByteArray AbstractNamespaceItem::keysPrefix() const {
+  // Interned once, flyweight rows of the namespace share it
+  if (m_keysPrefix.isNull() && type() == "namespace") {
+    m_keysPrefix =
+        getFullPath() + m_operations->getNamespaceSeparator().toUtf8();
   }
+
+  return m_keysPrefix;
 }
 
-QHash<QByteArray, QWeakPointer<KeyItem>> AbstractNamespaceItem::getKeysIndex()
-    const {
+QSharedPointer<TreeItem> AbstractNamespaceItem::materializeRow(int row) const {
+  ChildRow &childRow = m_childRows[row];
+
+  if (childRow.item || !childRow.isKey()) return childRow.item;
+
+  // Materialization doesn't change the observable state of the namespace
+  auto self = const_cast<AbstractNamespaceItem *>(this)->getSelf();
+
+  childRow.item = QSharedPointer<TreeItem>(
+      new KeyItem(childRow.keyPath, self, m_model, m_shortKeysRendering));
+  childRow.collationKey = QByteArray();
+
+  return childRow.item;
+}
+
+void AbstractNamespaceItem::materializeAllRows(bool recursive) {
+  for (int row = 0; row < m_childRows.size(); row++) {
+    materializeRow(row);
+  }
+
+  if (!recursive) return;
+
+  for (const auto &ns : qAsConst(m_childNamespaces)) {
+    ns->materializeAllRows(recursive);
+  }
+}
+
+void AbstractNamespaceItem::appendKeyToIndex(const QByteArray &fullPath) {
+  m_keysIndex.insert(fullPath);
+}
+
+void AbstractNamespaceItem::removeNamespacedKeysFromIndex(QByteArray nsPrefix) {
+  m_keysIndex.removePrefix(nsPrefix);
+}
+
+const KeysIndex &AbstractNamespaceItem::getKeysIndex() const {
   return m_keysIndex;
 }
 
@@ -115,59 +294,326 @@ QSharedPointer<TreeItem> resolveItemToRemove(QSharedPointer<TreeItem> item) {
 
   if (!parent || parent->type() == "database") return item;
 
-  if (parent->type() == "namespace" && parent->getAllChilds().empty())
+  if (parent->type() == "namespace" && parent->childCount() == 0)
     return resolveItemToRemove(parent);
 
   return item;
 }
 
-void AbstractNamespaceItem::removeObsoleteKeys(
-    QList<QWeakPointer<KeyItem>> keys) {
-  for (const auto &obsoleteKey : keys) {
-    auto key = obsoleteKey.toStrongRef();
+QSharedPointer<AbstractNamespaceItem> AbstractNamespaceItem::findKeyHolder(
+    const QByteArray &fullPath) {
+  QSharedPointer<AbstractNamespaceItem> holder =
+      getSelf().toStrongRef().dynamicCast<AbstractNamespaceItem>();
 
-    if (!key) continue;
+  QByteArray separator = m_operations->getNamespaceSeparator().toUtf8();
 
-    m_keysIndex.remove(key->getFullPath());
+  if (separator.isEmpty()) return holder;
 
-    auto parent = key->parent().toStrongRef();
+  int pos = keysPrefix().size();
 
-    if (!parent) continue;
+  while (holder) {
+    int separatorPos = fullPath.indexOf(separator, pos);
 
-    QSharedPointer<TreeItem> itemToRemoveFromModel = key;
+    if (separatorPos == -1) break;
 
-    if (parent->type() == "namespace" && parent->getAllChilds().size() == 1) {
-      itemToRemoveFromModel = resolveItemToRemove(parent);
-    }
+    auto ns =
+        holder->findChildNamespace(fullPath.mid(pos, separatorPos - pos));
+
+    if (!ns) break;
+
+    holder = ns;
+    pos = separatorPos + separator.size();
+  }
+
+  return holder;
+}
+
+void AbstractNamespaceItem::removeObsoleteKeys(const QList<QByteArray> &keys) {
+  auto root = resolveRootItem(
+      getSelf().toStrongRef().dynamicCast<AbstractNamespaceItem>());
+
+  for (const auto &fullPath : keys) {
+    if (root) root->m_keysIndex.remove(fullPath);
 
-    if (!itemToRemoveFromModel) continue;
+    auto holder = findKeyHolder(fullPath);
+    int row = holder ? holder->keyRow(fullPath) : -1;
 
-    int row = itemToRemoveFromModel->row();
+    if (row < 0) continue;
 
-    m_model.beforeItemChildRemoved(itemToRemoveFromModel->parent(), row);
+    if (holder->type() == "namespace" && holder->childCount() == 1) {
+      auto itemToRemoveFromModel = resolveItemToRemove(holder);
+      auto parentHoldsItemToRemove =
+          itemToRemoveFromModel->parent().toStrongRef();
 
-    auto parentHoldsItemToRemove =
-        itemToRemoveFromModel->parent().toStrongRef();
+      if (!parentHoldsItemToRemove) continue;
 
-    if (!parentHoldsItemToRemove) continue;
+      int nsRow = itemToRemoveFromModel->row();
+
+      m_model.beforeItemChildRemoved(itemToRemoveFromModel->parent(), nsRow);
+      parentHoldsItemToRemove->removeChild(nsRow);
+      m_model.itemChildRemoved(itemToRemoveFromModel);
+      continue;
+    }
 
-    parentHoldsItemToRemove->removeChild(row);
+    m_model.beforeItemChildRemoved(holder->getSelf(), row);
+    holder->removeChild(row);
 
-    m_model.itemChildRemoved(itemToRemoveFromModel);
+    // Flyweight row has no item, removal is finished on behalf of the holder
+    m_model.itemChildRemoved(holder->getSelf());
   }
 }
 
+bool AbstractNamespaceItem::removeKeyRow(const QByteArray &fullPath) {
+  int row = keyRow(fullPath);
+
+  if (row < 0) return false;
+
+  m_model.beforeItemChildRemoved(getSelf(), row);
+  removeChild(row);
+  m_model.itemChildRemoved(getSelf());
+  return true;
+}
+
 void AbstractNamespaceItem::removeChild(int index)
 {
-    bool validIndex = 0 < index && index < m_childItems.size();
+    bool validIndex = 0 <= index && index < m_childRows.size();
     if (!validIndex)
         return;
 
-    m_childItems.removeAt(index);
+    auto row = m_childRows.at(index);
+
+    countChilds({row}, -1);
+
+    if (row.item && row.item->type() == "namespace") {
+      for (auto it = m_childNamespaces.begin(); it != m_childNamespaces.end();
+           ++it) {
+        if (it.value() == row.item) {
+          m_childNamespaces.erase(it);
+          break;
+        }
+      }
+    }
+
+    m_childRows.remove(index);
 }
 
 void AbstractNamespaceItem::appendRawKey(const QByteArray &k) {
   m_rawChildKeys.append(k);
+  updateCounters(1, 1, 0);
+}
+
+void AbstractNamespaceItem::appendRawKeys(const RawKeys &keys) {
+  m_rawChildKeys.append(keys);
+  updateCounters(keys.size(), keys.size(), 0);
+}
+
+void AbstractNamespaceItem::removeRawKeys(const QSet<QByteArray> &keys) {
+  if (keys.isEmpty() || m_rawChildKeys.isEmpty()) return;
+
+  RawKeys result;
+  int index = 0;
+  int rangeStart = 0;
+  int removed = 0;
+
+  // Kept ranges share storage with the original list
+  m_rawChildKeys.forEach([&](const QByteArray &key) {
+    if (keys.contains(key)) {
+      if (index > rangeStart)
+        result.append(m_rawChildKeys.mid(rangeStart, index - rangeStart));
+      rangeStart = index + 1;
+      removed++;
+    }
+    index++;
+  });
+
+  if (removed == 0) return;
+
+  if (index > rangeStart)
+    result.append(m_rawChildKeys.mid(rangeStart, index - rangeStart));
+
+  m_rawChildKeys = result;
+  updateCounters(-removed, -removed, 0);
+}
+
+void AbstractNamespaceItem::collectRawKeys(RawKeys &keys) const {
+  keys.append(m_rawChildKeys);
+
+  for (const auto &ns : m_childNamespaces) {
+    ns->collectRawKeys(keys);
+  }
+}
+
+qint64 AbstractNamespaceItem::estimatedTreeMemory() const {
+  qint64 result = m_rawChildKeys.usedMemory();
+
+  for (const auto &ns : m_childNamespaces) {
+    result += MemoryBudget::NAMESPACE_ITEM_BYTES + ns->getFullPath().size() +
+              ns->estimatedTreeMemory();
+  }
+
+  return result;
+}
+
+int AbstractNamespaceItem::unloadCollapsedNamespaces() {
+  int unloaded = 0;
+
+  for (const auto &ns : qAsConst(m_childNamespaces)) {
+    if (ns->isExpanded()) {
+      unloaded += ns->unloadCollapsedNamespaces();
+    } else if (ns->unloadRenderedItems()) {
+      unloaded++;
+    }
+  }
+
+  return unloaded;
+}
+
+bool AbstractNamespaceItem::unloadRenderedItems() {
+  if (m_childRows.isEmpty() || type() != "namespace") return false;
+
+  auto selfRef = getSelf().toStrongRef().dynamicCast<AbstractNamespaceItem>();
+  if (!selfRef) return false;
+
+  auto root = resolveRootItem(selfRef);
+  if (!root) return false;
+
+  RawKeys keys;
+
+  root->getKeysIndex().forEachWithPrefix(
+      keysPrefix(), [&keys](const QByteArray &key) { keys.append(key); });
+
+  collectRawKeys(keys);
+
+  clear();
+  appendRawKeys(keys);
+  setExpanded(false);
+
+  emit m_model.itemChanged(getSelf());
+  return true;
+}
+
+MemoryBudget::Policy AbstractNamespaceItem::memoryPolicy() const {
+  auto parent = m_parent.toStrongRef().dynamicCast<AbstractNamespaceItem>();
+
+  if (!parent) return MemoryBudget::Policy::None;
+
+  return parent->memoryPolicy();
+}
+
+void AbstractNamespaceItem::updateCounters(qlonglong keys, qlonglong rawKeys,
+                                           qlonglong namespaces,
+                                           qlonglong usedMemory) {
+  AbstractNamespaceItem *item = this;
+
+  while (item) {
+    item->m_keysCounter += keys;
+    item->m_rawKeysCounter += rawKeys;
+    item->m_namespacesCounter += namespaces;
+
+    if (usedMemory != 0 && item->m_usedMemory > 0) {
+      item->m_usedMemory = qMax<qlonglong>(0, item->m_usedMemory + usedMemory);
+    }
+
+    // Detached namespaces are counted by parent when they are appended
+    if (!item->m_attachedToParent) break;
+
+    auto parent = item->m_parent.toStrongRef();
+    item = parent ? dynamic_cast<AbstractNamespaceItem *>(parent.data())
+                  : nullptr;
+  }
+}
+
+void AbstractNamespaceItem::countChilds(const ChildRows &rows, int sign) {
+  qlonglong keys = 0;
+  qlonglong rawKeys = 0;
+  qlonglong namespaces = 0;
+  qlonglong usedMemory = 0;
+
+  for (const auto &row : rows) {
+    if (row.isKey()) {
+      keys += 1;
+
+      // Only materialized keys can have used memory
+      auto memoryItem = row.item.dynamicCast<MemoryUsage>();
+      if (sign < 0 && memoryItem) usedMemory += memoryItem->usedMemory();
+      continue;
+    }
+
+    const auto &item = row.item;
+
+    if (!item) continue;
+
+    if (item->type() == "namespace") {
+      auto ns = item.dynamicCast<AbstractNamespaceItem>();
+      if (!ns) continue;
+
+      ns->m_attachedToParent = sign > 0;
+      keys += ns->m_keysCounter;
+      rawKeys += ns->m_rawKeysCounter;
+      namespaces += ns->m_namespacesCounter + 1;
+
+      if (sign < 0) usedMemory += ns->m_usedMemory;
+    }
+  }
+
+  if (keys == 0 && rawKeys == 0 && namespaces == 0) return;
+
+  updateCounters(sign * keys, sign * rawKeys, sign * namespaces,
+                 -usedMemory);
+}
+
+int AbstractNamespaceItem::rawKeysPageSize(int limit) const {
+  if (limit <= 0 || limit >= m_rawChildKeys.size()) return -1;
+
+  if (!m_operations) return limit;
+
+  QByteArray separator = m_operations->getNamespaceSeparator().toUtf8();
+
+  if (separator.isEmpty()) return limit;
+
+  // Raw keys are stored sorted so keys of one namespace are placed in one
+  // block, the page is extended to the end of the last namespace so the
+  // namespace isn't split between pages
+  QByteArray lastKey = m_rawChildKeys.mid(limit - 1, 1).toList().first();
+
+  int separatorPos = lastKey.indexOf(separator, keysPrefix().size());
+
+  if (separatorPos == -1) return limit;
+
+  return limit + m_rawChildKeys.countWithPrefix(
+                     limit, lastKey.left(separatorPos + separator.size()));
+}
+
+RawKeys AbstractNamespaceItem::takeRawChildKeys(int count) {
+  RawKeys result;
+
+  if (count < 0 || count >= m_rawChildKeys.size()) {
+    result = m_rawChildKeys;
+    m_rawChildKeys.clear();
+  } else {
+    result = m_rawChildKeys.mid(0, count);
+    m_rawChildKeys = m_rawChildKeys.mid(count);
+  }
+
+  updateCounters(-result.size(), -result.size(), 0);
+
+  // Kept until keys are rendered, cancelled rendering puts them back
+  m_takenRawKeys = result;
+  return result;
+}
+
+void AbstractNamespaceItem::restoreTakenRawKeys() {
+  if (m_takenRawKeys.isEmpty()) return;
+
+  RawKeys keys = m_takenRawKeys;
+  keys.append(m_rawChildKeys);
+  m_rawChildKeys = keys;
+
+  updateCounters(m_takenRawKeys.size(), m_takenRawKeys.size(), 0);
+  m_takenRawKeys.clear();
+
+  ensureLoaderIsCreated();
+  emit m_model.itemChanged(getSelf());
 }
 
 void AbstractNamespaceItem::appendNamespace(
@@ -180,13 +626,13 @@ uint AbstractNamespaceItem::childCount(bool recursive) const {
   uint count = 0;
 
   if (!recursive) {
-    count += m_childItems.size();
+    count += m_childRows.size();
     return count;
   }
 
-  for (const auto &item : m_childItems) {
-    if (item->supportChildItems()) {
-      count += item->childCount(true);
+  for (const auto &row : m_childRows) {
+    if (row.item && row.item->supportChildItems()) {
+      count += row.item->childCount(true);
     } else {
       count += 1;
     }
@@ -195,19 +641,20 @@ uint AbstractNamespaceItem::childCount(bool recursive) const {
 }
 
 uint AbstractNamespaceItem::keysCount() const {
-  uint count = m_rawChildKeys.size();
+  return static_cast<uint>(m_keysCounter);
+}
 
-  for (const auto &item : m_childItems) {
-    if (item->supportChildItems()) {
-      auto ns = item.dynamicCast<AbstractNamespaceItem>();
-      if (ns) {
-        count += ns->keysCount();
-      }
-    } else if (item->type() == "key") {
-      count += 1;
-    }
-  }
-  return count;
+uint AbstractNamespaceItem::rawKeysCount() const {
+  return static_cast<uint>(m_rawKeysCounter);
+}
+
+uint AbstractNamespaceItem::namespacesCount() const {
+  return static_cast<uint>(m_namespacesCounter);
+}
+
+void AbstractNamespaceItem::setRemoteKeysCount(qlonglong count) {
+  updateCounters(count - m_remoteKeysCount, 0, 0);
+  m_remoteKeysCount = count;
 }
 
 uint AbstractNamespaceItem::keysRenderingLimit() const {
@@ -216,8 +663,7 @@ uint AbstractNamespaceItem::keysRenderingLimit() const {
 }
 
 bool AbstractNamespaceItem::keysShortNameRendering() const {
-  QSettings appSettings;
-  return appSettings.value("app/namespacedKeysShortName", true).toBool();
+  return m_shortKeysRendering;
 }
 
 void AbstractNamespaceItem::clear() {
@@ -225,15 +671,26 @@ void AbstractNamespaceItem::clear() {
 
   bool notifyModel = false;
 
-  if (m_childItems.size() > 0) {
+  if (m_childRows.size() > 0) {
     notifyModel = true;
     m_model.beforeItemChildsUnloaded(getSelf());
   }
 
-  m_childItems.clear();
+  for (const auto &ns : qAsConst(m_childNamespaces)) {
+    ns->m_attachedToParent = false;
+  }
+
+  updateCounters(-m_keysCounter, -m_rawKeysCounter, -m_namespacesCounter,
+                 -m_usedMemory);
+
+  m_childRows.clear();
   m_childNamespaces.clear();
   m_rawChildKeys.clear();
+  m_takenRawKeys.clear();
+  m_remoteKeysCount = 0;
   m_usedMemory = 0;
+  m_usedMemoryError = 0;
+  m_usedMemoryEstimated = false;
 
   if (type() == "database") {
     m_keysIndex.clear();
@@ -243,7 +700,7 @@ void AbstractNamespaceItem::clear() {
       auto root = resolveRootItem(selfRef);
 
       if (root) {
-        root->removeNamespacedKeysFromIndex(getFullPath());
+        root->removeNamespacedKeysFromIndex(keysPrefix());
       }
     }
   }
@@ -254,16 +711,16 @@ void AbstractNamespaceItem::clear() {
 }
 
 void AbstractNamespaceItem::clearLoader() {
-  if (m_childItems.empty()) {
+  if (m_childRows.empty()) {
     return;
   }
 
-  auto lastItem = m_childItems.last();
+  auto lastItem = m_childRows.last().item;
 
   if (!lastItem || lastItem->type() != "loader") return;
 
-  m_model.beforeItemChildRemoved(getSelf(), m_childItems.size() - 1);
-  m_childItems.removeLast();
+  m_model.beforeItemChildRemoved(getSelf(), m_childRows.size() - 1);
+  m_childRows.removeLast();
   m_model.itemChildRemoved(lastItem.toWeakRef());
 }
 
@@ -273,11 +730,23 @@ void AbstractNamespaceItem::showLoadingError(const QString &err) {
 }
 
 void AbstractNamespaceItem::cancelCurrentOperation() {
+  if (m_keysRendering) {
+    m_keysRendering->future().cancel();
+    m_keysRendering.clear();
+    restoreTakenRawKeys();
+    unlock();
+  }
+
   if (m_runningOperation) {
     m_runningOperation->future().cancel();
     m_operations->resetConnection();
     unlock();
   }
+
+  if (!m_currentOperation.isFinished()) {
+    m_currentOperation.cancel();
+    unlock();
+  }
 }
 
 bool compareChilds(QSharedPointer<TreeItem> first,
@@ -295,14 +764,20 @@ bool compareChilds(QSharedPointer<TreeItem> first,
 }
 
 void AbstractNamespaceItem::sortChilds() {
+  // Keys are sorted by used memory which is stored in KeyItem
+  materializeAllRows(false);
+
   m_model.beforeItemLayoutChanged(getSelf());
-  std::sort(m_childItems.begin(), m_childItems.end(), compareChilds);
+  std::sort(m_childRows.begin(), m_childRows.end(),
+            [](const ChildRow &first, const ChildRow &second) {
+              return compareChilds(first.item, second.item);
+            });
   m_model.itemLayoutChanged(getSelf());
   emit m_model.itemChanged(getSelf());
 }
 
 void AbstractNamespaceItem::renderRawKeys(
-    const RedisClient::Connection::RawKeysList &keylist, QRegExp filter,
+    const RawKeys &keylist, QRegExp filter,
     QSharedPointer<RenderRawKeysCallback> callback, bool appendNewItems,
     bool checkPreRenderedItems, int maxChildItems) {
   if (!m_operations) {
@@ -310,7 +785,7 @@ void AbstractNamespaceItem::renderRawKeys(
   }
 
   uint renderingLimit =
-      qMax(static_cast<uint>(m_childItems.size()), keysRenderingLimit());
+      qMax(static_cast<uint>(m_childRows.size()), keysRenderingLimit());
 
   if (maxChildItems > 0) {
     renderingLimit = static_cast<uint>(maxChildItems);
@@ -319,45 +794,263 @@ void AbstractNamespaceItem::renderRawKeys(
   auto settings = ConnectionsTree::KeysTreeRenderer::RenderingSettigns{
       filter,         m_operations->getNamespaceSeparator(),
       getDbIndex(),   renderingLimit,
-      appendNewItems, checkPreRenderedItems, keysShortNameRendering()};
+      appendNewItems, checkPreRenderedItems, m_showNsOnTop};
+
+  // Fresh load: build namespaces in the worker thread and attach them at once
+  bool buildTrie = !checkPreRenderedItems && m_childRows.isEmpty();
+
+  int prefixLength = 0;
+  if (getFullPath().size() > 0 || type() == "namespace") {
+    prefixLength = getFullPath().size() + settings.nsSeparator.toUtf8().size();
+  }
+
+  auto expandedNamespaces = m_model.expandedNamespaces;
+
+  auto rendering = QSharedPointer<AsyncFuture::Deferred<void>>(
+      new AsyncFuture::Deferred<void>());
+  m_keysRendering = rendering;
 
   auto future = QtConcurrent::run(
-      [](QList<QByteArray> keylist) {
-        std::sort(keylist.begin(), keylist.end());
-        return keylist;
+      [buildTrie, prefixLength, settings, expandedNamespaces,
+       rendering](RawKeys rawKeys) {
+        auto keylist = rawKeys.toList();
+        rawKeys.clear();
+
+        QSharedPointer<KeysTreeRenderer::NamespaceTrieNode> trie;
+
+        bool sorted = sortKeys(keylist, [rendering]() {
+          return rendering->future().isCanceled();
+        });
+
+        if (!sorted) {
+          return qMakePair(RedisClient::Connection::RawKeysList(), trie);
+        }
+
+        if (buildTrie) {
+          trie = KeysTreeRenderer::buildNamespaceTrie(
+              keylist, prefixLength, settings, expandedNamespaces);
+          if (trie) keylist.clear();
+        }
+
+        return qMakePair(keylist, trie);
       },
       keylist);
 
   auto selfWPtr = getSelf();
 
-  AsyncFuture::observe(future).subscribe([selfWPtr, this, settings, callback, future]() {
-
+  AsyncFuture::observe(future).subscribe([selfWPtr, this, settings, callback,
+                                          buildTrie, rendering, future]() {
     auto self = selfWPtr.toStrongRef();
 
-    if (!self)
+    if (!self || rendering->future().isCanceled())
       return;
 
-    ConnectionsTree::KeysTreeRenderer::renderKeys(
-        m_operations, future.result(),
-        qSharedPointerDynamicCast<AbstractNamespaceItem>(self), settings,
-        m_model.expandedNamespaces);
+    rendering->complete();
+
+    if (m_keysRendering == rendering) m_keysRendering.clear();
+
+    m_takenRawKeys.clear();
+
+    auto result = future.result();
+
+    if (buildTrie && !result.second) {
+      showLoadingError(QCoreApplication::translate(
+          "RESP", "Not enough memory to render all keys"));
+    } else if (buildTrie) {
+      ConnectionsTree::KeysTreeRenderer::renderNamespaceTrie(
+          m_operations, result.second,
+          qSharedPointerDynamicCast<AbstractNamespaceItem>(self), settings);
+    } else {
+      ConnectionsTree::KeysTreeRenderer::renderKeys(
+          m_operations, result.first,
+          qSharedPointerDynamicCast<AbstractNamespaceItem>(self), settings,
+          m_model.expandedNamespaces);
+    }
+
     if (callback)
       callback->call();
   });
 }
 
+bool AbstractNamespaceItem::isNamespacesSummaryEnabled() const {
+  if (memoryPolicy() >= MemoryBudget::Policy::NamespacesSummary) return true;
+
+  QSettings settings;
+  return settings.value("app/namespacesSummaryLoading", false).toBool();
+}
+
+void AbstractNamespaceItem::loadNamespacesSummary(
+    const QString &filter, QSharedPointer<RenderRawKeysCallback> callback) {
+  QSettings settings;
+  int depth = settings.value("app/namespacesSummaryDepth", 2).toInt();
+
+  int prefixLength = 0;
+  if (getFullPath().size() > 0 || type() == "namespace") {
+    prefixLength = getFullPath().size() +
+                   m_operations->getNamespaceSeparator().toUtf8().size();
+  }
+
+  auto summaryCallback =
+      QSharedPointer<Operations::LoadNamespacesSummaryCallback>(
+          new Operations::LoadNamespacesSummaryCallback(
+              getSelf(),
+              [this, callback](
+                  const RedisClient::Connection::RawKeysList &keylist,
+                  const Operations::NamespacesSummary &summary,
+                  const QString &err) {
+                if (!err.isEmpty()) {
+                  unlock();
+                  return showLoadingError(err);
+                }
+
+                renderSummaryResult(keylist, summary, callback);
+              }));
+
+  m_currentOperation = m_operations->loadNamespacesSummary(
+      m_dbIndex, filter, prefixLength, depth, summaryCallback);
+}
+
+void AbstractNamespaceItem::summarizeLoadedKeys(
+    const RedisClient::Connection::RawKeysList &keylist,
+    QSharedPointer<RenderRawKeysCallback> callback) {
+  QSettings settings;
+  int depth = settings.value("app/namespacesSummaryDepth", 2).toInt();
+
+  QByteArray separator = m_operations->getNamespaceSeparator().toUtf8();
+
+  int prefixLength = 0;
+  if (getFullPath().size() > 0 || type() == "namespace") {
+    prefixLength = getFullPath().size() + separator.size();
+  }
+
+  if (separator.isEmpty()) depth = 0;
+
+  // Same aggregation as the summary script does on the server
+  auto future = QtConcurrent::run(
+      [separator, prefixLength,
+       depth](RedisClient::Connection::RawKeysList keys) {
+        Operations::NamespacesSummary summary;
+        RedisClient::Connection::RawKeysList ownKeys;
+
+        for (const auto &key : qAsConst(keys)) {
+          int pos = prefixLength;
+          int level = 0;
+
+          while (level < depth) {
+            int separatorPos = key.indexOf(separator, pos);
+
+            if (separatorPos == -1) break;
+
+            summary[key.left(separatorPos)]++;
+            pos = separatorPos + separator.size();
+            level++;
+          }
+
+          if (level == 0) ownKeys.append(key);
+        }
+
+        return qMakePair(ownKeys, summary);
+      },
+      keylist);
+
+  auto selfWPtr = getSelf();
+
+  AsyncFuture::observe(future).subscribe([selfWPtr, this, future, callback]() {
+    if (!selfWPtr.toStrongRef()) return;
+
+    auto result = future.result();
+    renderSummaryResult(result.first, result.second, callback);
+  });
+}
+
+void AbstractNamespaceItem::renderSummaryResult(
+    const RedisClient::Connection::RawKeysList &keylist,
+    const Operations::NamespacesSummary &summary,
+    QSharedPointer<RenderRawKeysCallback> callback) {
+  auto onKeysRendered = QSharedPointer<RenderRawKeysCallback>(
+      new RenderRawKeysCallback(getSelf(), [this, summary, callback]() {
+        renderNamespacesSummary(summary);
+
+        if (callback) callback->call();
+      }));
+
+  renderRawKeys(keylist, m_filter, onKeysRendered, true, false);
+}
+
+void AbstractNamespaceItem::renderNamespacesSummary(
+    const Operations::NamespacesSummary &summary) {
+  if (summary.isEmpty()) return;
+
+  QByteArray separator = m_operations->getNamespaceSeparator().toUtf8();
+
+  int prefixLength = 0;
+  if (getFullPath().size() > 0 || type() == "namespace") {
+    prefixLength = getFullPath().size() + separator.size();
+  }
+
+  // Counters include keys of nested namespaces, keep only own keys
+  auto ownKeys = summary;
+
+  for (auto it = summary.constBegin(); it != summary.constEnd(); ++it) {
+    int pos = it.key().lastIndexOf(separator);
+
+    if (pos < prefixLength) continue;
+
+    auto parentPath = it.key().left(pos);
+
+    if (ownKeys.contains(parentPath)) ownKeys[parentPath] -= it.value();
+  }
+
+  // Summary is sorted so parent namespaces are created before nested ones
+  QHash<QByteArray, QSharedPointer<NamespaceItem>> items;
+  QList<QSharedPointer<NamespaceItem>> topLevelItems;
+
+  for (auto it = summary.constBegin(); it != summary.constEnd(); ++it) {
+    int pos = it.key().lastIndexOf(separator);
+
+    QSharedPointer<NamespaceItem> parentItem;
+
+    if (pos >= prefixLength) {
+      parentItem = items.value(it.key().left(pos));
+
+      if (!parentItem) continue;
+    }
+
+    QWeakPointer<TreeItem> parentWPtr =
+        parentItem ? parentItem.staticCast<TreeItem>().toWeakRef() : getSelf();
+
+    auto namespaceItem = QSharedPointer<NamespaceItem>(new NamespaceItem(
+        it.key(), m_operations, parentWPtr, m_model, m_dbIndex, m_filter));
+
+    namespaceItem->setRemoteKeysCount(ownKeys.value(it.key()));
+
+    items.insert(it.key(), namespaceItem);
+
+    if (parentItem) {
+      parentItem->appendChilds({namespaceItem}, false);
+    } else {
+      topLevelItems.append(namespaceItem);
+    }
+  }
+
+  for (const auto &namespaceItem : qAsConst(topLevelItems)) {
+    appendNamespace(namespaceItem);
+  }
+}
+
 void AbstractNamespaceItem::ensureLoaderIsCreated() {
-  if (m_rawChildKeys.empty() || m_childItems.empty()) {
+  if (m_rawChildKeys.empty() || m_childRows.empty()) {
     return;
   }
 
-  auto lastItem = m_childItems.last();
+  auto lastItem = m_childRows.last().item;
 
-  if (lastItem->type() == "loader") return;
+  if (lastItem && lastItem->type() == "loader") return;
 
   m_model.beforeChildLoaded(getSelf(), 1);
-  m_childItems.append(
-      QSharedPointer<TreeItem>(new LoadMoreItem(getSelf(), m_model)));
+  m_childRows.append(ChildRow{
+      QSharedPointer<TreeItem>(new LoadMoreItem(getSelf(), m_model)),
+      QByteArray()});
   m_model.childLoaded(getSelf());
 }
 
@@ -365,7 +1058,10 @@ QHash<QString, std::function<bool ()> > AbstractNamespaceItem::eventHandlers() {
   auto events = TreeItem::eventHandlers();
 
   events.insert("analyze_memory_usage", [this]() {
-    if (m_usedMemory > 0) return true;
+    if (m_usedMemory > 0 && !isUsedMemoryEstimated()) return true;
+
+    // Second request on estimated value calculates exact used memory
+    m_exactMemoryUsage = isUsedMemoryEstimated();
 
     auto future = m_operations->connectionSupportsMemoryOperations();
 
@@ -403,13 +1099,15 @@ QHash<QString, std::function<bool ()> > AbstractNamespaceItem::eventHandlers() {
 
 void AbstractNamespaceItem::getMemoryUsage(
     std::function<void(qlonglong)> callback) {
-  m_usedMemory = 0;
-
   m_runningOperation = QSharedPointer<AsyncFuture::Deferred<qlonglong>>(
       new AsyncFuture::Deferred<qlonglong>());
 
+  // Used memory of keys is kept in KeyItem, rows are materialized in the
+  // UI thread before the calculation starts
+  materializeAllRows(true);
+
   QtConcurrent::run(this, &AbstractNamespaceItem::calculateUsedMemory,
-                    m_runningOperation, callback);
+                    m_runningOperation, callback, m_exactMemoryUsage);
 
   return;
 }
@@ -421,12 +1119,13 @@ void AbstractNamespaceItem::fetchMore() {
 
   clearLoader();
 
-  int childsCount = m_childItems.size();
-  auto rawKeys = m_rawChildKeys;
+  int childsCount = m_childRows.size();
+  int renderingLimit = keysRenderingLimit();
 
-  emit m_model.itemChanged(getSelf());
+  // Only next page of keys is rendered, the rest stays in shared storage
+  auto rawKeys = takeRawChildKeys(rawKeysPageSize(renderingLimit));
 
-  m_rawChildKeys.clear();
+  emit m_model.itemChanged(getSelf());
 
   auto callback = QSharedPointer<RenderRawKeysCallback>(
       new RenderRawKeysCallback(getSelf(), [this]() {
@@ -437,78 +1136,140 @@ void AbstractNamespaceItem::fetchMore() {
 
   return renderRawKeys(
       rawKeys, m_filter, callback,
-      true, false, static_cast<uint>(childsCount) + keysRenderingLimit());
+      true, false, childsCount + renderingLimit);
 }
 
 void AbstractNamespaceItem::calculateUsedMemory(
     QSharedPointer<AsyncFuture::Deferred<qlonglong>> parentDeffered,
-    std::function<void(qlonglong)> callback) {
+    std::function<void(qlonglong)> callback, bool exact) {
   if (parentDeffered && parentDeffered->future().isCanceled()) {
     return;
   }
 
-  if (m_rawChildKeys.size() > 0) {
-    auto resultCallback = QSharedPointer<Operations::GetUsedMemoryCallback>(
-        new Operations::GetUsedMemoryCallback(
-            getSelf(), [this, callback](qlonglong result) {
-              m_usedMemory = result;
-              emit m_model.itemChanged(getSelf());
+  QList<QSharedPointer<MemoryUsage>> memoryItems;
 
-              if (m_childItems.empty()) callback(result);
-            }));
+  for (const auto &row : qAsConst(m_childRows)) {
+    if (!row.item || !row.isKey()) continue;
 
-    auto progressCallback = QSharedPointer<Operations::GetUsedMemoryCallback>(
-        new Operations::GetUsedMemoryCallback(
-            getSelf(), [this](qlonglong progress) {
-              m_usedMemory = progress;
-              emit m_model.itemChanged(getSelf());
-            }));
+    auto memoryItem = row.item.dynamicCast<MemoryUsage>();
 
-    operations()->getUsedMemory(m_rawChildKeys, m_dbIndex, resultCallback,
-                                progressCallback);
+    if (memoryItem) memoryItems.append(memoryItem);
   }
 
-  auto resultsRemaining = QSharedPointer<qlonglong>(new qlonglong(0));
+  auto resultsRemaining = QSharedPointer<qlonglong>(
+      new qlonglong(m_childNamespaces.size() + memoryItems.size() +
+                    (m_rawChildKeys.size() > 0 ? 1 : 0)));
 
-  auto updateUsedMemoryValue = [this, resultsRemaining,
-                                callback](qlonglong result) {
-    if (!resultsRemaining) return;
+  {
+    QMutexLocker locker(&m_updateUsedMemoryMutex);
+    m_usedMemory = 0;
+    m_usedMemoryError = 0;
+    m_usedMemoryEstimated = false;
+  }
 
+  if (*resultsRemaining <= 0) {
+    emit m_model.itemChanged(getSelf());
+    return callback(0);
+  }
+
+  auto errorMargins = QSharedPointer<QVector<qlonglong>>(new QVector<qlonglong>());
+
+  auto addResult = [this, resultsRemaining, errorMargins, callback](
+                       qlonglong result, qlonglong errorMargin,
+                       bool estimated) {
     QMutexLocker locker(&m_updateUsedMemoryMutex);
-    Q_UNUSED(locker);
     m_usedMemory += result;
-    emit m_model.itemChanged(getSelf());
+
+    if (errorMargin > 0) errorMargins->append(errorMargin);
+    if (estimated) m_usedMemoryEstimated = true;
 
     (*resultsRemaining)--;
 
-    if (*resultsRemaining <= 0) {
-      callback(m_usedMemory);
+    if (*resultsRemaining > 0) {
+      locker.unlock();
+      emit m_model.itemChanged(getSelf());
+      return;
     }
+
+    m_usedMemoryError = MemorySampling::combineMargins(*errorMargins);
+    qlonglong usedMemory = m_usedMemory;
+    locker.unlock();
+
+    emit m_model.itemChanged(getSelf());
+    callback(usedMemory);
   };
 
-  (*resultsRemaining) += m_childNamespaces.size();
+  if (m_rawChildKeys.size() > 0) {
+    int keysCount = m_rawChildKeys.size();
+    int sampleSize = MemorySampling::sampleSize(keysCount);
+
+    if (!exact && sampleSize < keysCount) {
+      auto resultCallback = QSharedPointer<Operations::GetKeysMemoryCallback>(
+          new Operations::GetKeysMemoryCallback(
+              getSelf(),
+              [keysCount, addResult](const QVector<qlonglong>& sample) {
+                auto estimate = MemorySampling::estimate(sample, keysCount);
+                addResult(estimate.total, estimate.margin, true);
+              }));
+
+      operations()->getKeysMemory(
+          MemorySampling::sample(m_rawChildKeys, sampleSize), m_dbIndex,
+          resultCallback);
+    } else {
+      auto reportedProgress = QSharedPointer<qlonglong>(new qlonglong(0));
+
+      auto resultCallback = QSharedPointer<Operations::GetUsedMemoryCallback>(
+          new Operations::GetUsedMemoryCallback(
+              getSelf(), [this, reportedProgress, addResult](qlonglong result) {
+                {
+                  QMutexLocker locker(&m_updateUsedMemoryMutex);
+                  m_usedMemory -= *reportedProgress;
+                }
+                addResult(result, 0, false);
+              }));
+
+      auto progressCallback = QSharedPointer<Operations::GetUsedMemoryCallback>(
+          new Operations::GetUsedMemoryCallback(
+              getSelf(), [this, reportedProgress](qlonglong progress) {
+                {
+                  QMutexLocker locker(&m_updateUsedMemoryMutex);
+                  m_usedMemory += progress - *reportedProgress;
+                  *reportedProgress = progress;
+                }
+                emit m_model.itemChanged(getSelf());
+              }));
+
+      operations()->getUsedMemory(m_rawChildKeys, m_dbIndex, resultCallback,
+                                  progressCallback);
+    }
+  }
 
   for (auto childNs : qAsConst(m_childNamespaces)) {
     if (parentDeffered->future().isCanceled()) {
       return;
     }
-    childNs->calculateUsedMemory(parentDeffered, updateUsedMemoryValue);
+
+    QWeakPointer<AbstractNamespaceItem> childNsRef = childNs.toWeakRef();
+
+    childNs->calculateUsedMemory(
+        parentDeffered,
+        [childNsRef, addResult](qlonglong result) {
+          auto childNs = childNsRef.toStrongRef();
+          if (!childNs) return addResult(result, 0, false);
+
+          addResult(result, childNs->usedMemoryError(),
+                    childNs->isUsedMemoryEstimated());
+        },
+        exact);
   }
 
-  for (const QSharedPointer<TreeItem> &child : qAsConst(m_childItems)) {
+  for (auto memoryItem : qAsConst(memoryItems)) {
     if (parentDeffered->future().isCanceled()) {
       return;
     }
 
-    if (!child || child->type() != "key") continue;
-
-    auto memoryItem = child.dynamicCast<MemoryUsage>();
-
-    if (!memoryItem) continue;
-
-    QMutexLocker locker(&m_updateUsedMemoryMutex);
-    (*resultsRemaining)++;
-    memoryItem->getMemoryUsage(updateUsedMemoryValue);
+    memoryItem->getMemoryUsage(
+        [addResult](qlonglong result) { addResult(result, 0, false); });
   }
 }
 
@@ -3,8 +3,13 @@
 #include <QRegExp>
 #include <QSharedPointer>
 #include <QString>
+#include <QVector>
 #include <QtConcurrent>
 
+#include "connections-tree/keysindex.h"
+#include "connections-tree/memorybudget.h"
+#include "connections-tree/operations.h"
+#include "connections-tree/rawkeys.h"
 #include "memoryusage.h"
 #include "treeitem.h"
 #include "modules/common/callbackwithowner.h"
@@ -18,6 +23,28 @@ class KeyItem;
 
 class AbstractNamespaceItem : public QObject, public TreeItem, public MemoryUsage {
 
+ public:
+  /*
+   * Row of a child item. Keys are rendered as flyweight rows: the row keeps
+   * only the full path which shares data with KeysIndex, KeyItem is created
+   * when the row is accessed by the model for the first time.
+   */
+  struct ChildRow {
+    QSharedPointer<TreeItem> item;
+    QByteArray keyPath;
+    // Collation key of the flyweight row, it's built on the first comparison
+    // and kept until the row is materialized
+    mutable QByteArray collationKey;
+
+    bool isKey() const { return !keyPath.isNull(); }
+
+    static ChildRow key(const QByteArray& fullPath) {
+      return ChildRow{QSharedPointer<TreeItem>(), fullPath};
+    }
+  };
+
+  using ChildRows = QVector<ChildRow>;
+
  public:
   AbstractNamespaceItem(Model& model, QWeakPointer<TreeItem> parent,
                         QSharedPointer<Operations> operations, uint dbIndex,
@@ -33,30 +60,81 @@ class AbstractNamespaceItem : public QObject, public TreeItem, public MemoryUsag
 
   uint keysCount() const;
 
+  uint rawKeysCount() const;
+
+  uint namespacesCount() const;
+
+  // Keys counted on the server side which are not loaded yet
+  void setRemoteKeysCount(qlonglong count);
+
+  bool hasRemoteKeys() const { return m_remoteKeysCount > 0; }
+
   uint keysRenderingLimit() const;
 
   bool keysShortNameRendering() const;
 
   QSharedPointer<TreeItem> child(uint row) override;
 
+  int indexOfChild(const TreeItem* item) override;
+
   QWeakPointer<TreeItem> parent() const override;
 
   virtual void append(QSharedPointer<TreeItem> item, bool notifyModel=true);
 
+  // Sorts rows in the order used by insertRow()
+  void sortRows(ChildRows& rows) const;
+
   virtual void insertChild(QSharedPointer<TreeItem> item);
 
-  virtual void appendKeyToIndex(QSharedPointer<KeyItem> key);
+  virtual void appendChilds(const QList<QSharedPointer<TreeItem>>& items,
+                            bool notifyModel = true);
+
+  virtual void appendRows(const ChildRows& rows, bool notifyModel = true);
+
+  // Appends flyweight row of the key
+  virtual void appendKey(const QByteArray& fullPath, bool notifyModel = true);
+
+  // Inserts flyweight row of the key keeping child items sorted
+  virtual void insertKey(const QByteArray& fullPath);
+
+  // Row of the rendered key or -1
+  int keyRow(const QByteArray& fullPath) const;
+
+  // Prefix of full paths of child keys, empty for databases
+  QByteArray keysPrefix() const;
+
+  virtual void appendKeyToIndex(const QByteArray& fullPath);
 
   virtual void removeNamespacedKeysFromIndex(QByteArray nsPrefix);
 
-  virtual QHash<QByteArray, QWeakPointer<KeyItem>> getKeysIndex() const;
+  virtual const KeysIndex& getKeysIndex() const;
 
-  virtual void removeObsoleteKeys(QList<QWeakPointer<KeyItem>> keys);
+  virtual void removeObsoleteKeys(const QList<QByteArray>& keys);
 
   void removeChild(int index) override;
 
+  // Removes row of the rendered key, key stays in the keys index
+  bool removeKeyRow(const QByteArray& fullPath);
+
   virtual void appendRawKey(const QByteArray& k);
 
+  virtual void appendRawKeys(const RawKeys& keys);
+
+  virtual void removeRawKeys(const QSet<QByteArray>& keys);
+
+  // Appends not rendered keys of the whole subtree
+  void collectRawKeys(RawKeys& keys) const;
+
+  // Estimated memory of namespaces and raw keys of the subtree
+  virtual qint64 estimatedTreeMemory() const;
+
+  // Replaces rendered items of collapsed namespaces with raw keys, they are
+  // rendered again when the namespace is expanded
+  int unloadCollapsedNamespaces();
+
+  // Policy of the memory budget applied to the database
+  virtual MemoryBudget::Policy memoryPolicy() const;
+
   virtual void appendNamespace(QSharedPointer<AbstractNamespaceItem> item);
 
   virtual QSharedPointer<AbstractNamespaceItem> findChildNamespace(
@@ -88,32 +166,87 @@ class AbstractNamespaceItem : public QObject, public TreeItem, public MemoryUsag
 
   virtual void clearLoader();
 
+  bool unloadRenderedItems();
+
   void sortChilds();
 
+  // Creates KeyItem of the flyweight row
+  QSharedPointer<TreeItem> materializeRow(int row) const;
+
+  void materializeAllRows(bool recursive);
+
+  // Collation key of the row, flyweight rows are not materialized
+  const QByteArray& rowCollationKey(const ChildRow& row) const;
+
+  void insertRow(const ChildRow& row);
+
+  QSharedPointer<AbstractNamespaceItem> findKeyHolder(const QByteArray& fullPath);
+
+  void updateCounters(qlonglong keys, qlonglong rawKeys, qlonglong namespaces,
+                      qlonglong usedMemory = 0);
+
+  void countChilds(const ChildRows& rows, int sign);
+
+  RawKeys takeRawChildKeys(int count = -1);
+
+  // Puts keys taken for the cancelled rendering back to raw storage
+  void restoreTakenRawKeys();
+
+  // Number of raw keys rendered by fetchMore(), namespaces are not split
+  int rawKeysPageSize(int limit) const;
+
   using RenderRawKeysCallback = CallbackWithOwner<TreeItem>;
 
-  void renderRawKeys(const RedisClient::Connection::RawKeysList& keylist, QRegExp filter,
+  void renderRawKeys(const RawKeys& keylist, QRegExp filter,
                      QSharedPointer<RenderRawKeysCallback> callback,
                      bool appendNewItems,
                      bool checkPreRenderedItems,
                      int maxChildItems=-1);  
 
+  bool isNamespacesSummaryEnabled() const;
+
+  void loadNamespacesSummary(const QString& filter,
+                             QSharedPointer<RenderRawKeysCallback> callback);
+
+  // Builds namespaces summary from keys which are loaded already
+  void summarizeLoadedKeys(const RedisClient::Connection::RawKeysList& keylist,
+                           QSharedPointer<RenderRawKeysCallback> callback);
+
+  void renderNamespacesSummary(const Operations::NamespacesSummary& summary);
+
+  void renderSummaryResult(const RedisClient::Connection::RawKeysList& keylist,
+                           const Operations::NamespacesSummary& summary,
+                           QSharedPointer<RenderRawKeysCallback> callback);
+
   QHash<QString, std::function<bool()>> eventHandlers() override;
 
-  void calculateUsedMemory(QSharedPointer<AsyncFuture::Deferred<qlonglong>> parentD, std::function<void(qlonglong)> callback);
+  void calculateUsedMemory(QSharedPointer<AsyncFuture::Deferred<qlonglong>> parentD, std::function<void(qlonglong)> callback,
+                           bool exact);
 
   void restoreOpenedNamespaces(QSharedPointer<AbstractNamespaceItem> ns);
 
  protected:
   QWeakPointer<TreeItem> m_parent;
   QSharedPointer<Operations> m_operations;
-  QList<QSharedPointer<TreeItem>> m_childItems;
+  mutable ChildRows m_childRows;
   QHash<QByteArray, QSharedPointer<AbstractNamespaceItem>> m_childNamespaces;
-  QList<QByteArray> m_rawChildKeys;
+  RawKeys m_rawChildKeys;
+  RawKeys m_takenRawKeys;
   QRegExp m_filter;  
   uint m_dbIndex;
   QSharedPointer<AsyncFuture::Deferred<qlonglong>> m_runningOperation;
+  QSharedPointer<AsyncFuture::Deferred<void>> m_keysRendering;
   bool m_showNsOnTop;  
-  QHash<QByteArray, QWeakPointer<KeyItem>> m_keysIndex;  
+  bool m_shortKeysRendering;
+  mutable QByteArray m_keysPrefix;
+  KeysIndex m_keysIndex;
+
+  // Aggregated counters of the whole subtree
+  qlonglong m_keysCounter;
+  qlonglong m_rawKeysCounter;
+  qlonglong m_namespacesCounter;
+  qlonglong m_remoteKeysCount;
+  bool m_attachedToParent;
+  bool m_exactMemoryUsage;
 };
 }  // namespace ConnectionsTree
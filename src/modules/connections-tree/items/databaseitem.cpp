@@ -10,6 +10,8 @@
 #include <typeinfo>
 
 #include "app/apputils.h"
+#include "connections-tree/globmatcher.h"
+#include "connections-tree/keysdiskcache.h"
 #include "connections-tree/model.h"
 #include "connections-tree/utils.h"
 #include "keyitem.h"
@@ -19,13 +21,54 @@
 
 using namespace ConnectionsTree;
 
+namespace {
+// Used to estimate memory of keys before SCAN
+const qint64 AVERAGE_KEY_BYTES = 48;
+
+// Loaded keys are filtered without SCAN if they were loaded recently
+const qint64 LOADED_KEYS_MAX_AGE = 60000;
+
+// Keys changed by live updates are saved to disk at most once per interval
+const int DISK_CACHE_SAVE_INTERVAL = 60000;
+
+qint64 estimateKeysMemory(const RedisClient::Connection::RawKeysList& keys) {
+  qint64 result = keys.size() * MemoryBudget::KEY_ROW_BYTES;
+
+  for (const auto& key : keys) {
+    result += key.size();
+  }
+
+  return result;
+}
+
+// Keeps keys which fit into available memory
+void truncateKeys(RedisClient::Connection::RawKeysList& keys,
+                  qint64 availableMemory) {
+  int count = 0;
+
+  for (qint64 used = 0; count < keys.size(); count++) {
+    used += MemoryBudget::KEY_ROW_BYTES + keys.at(count).size();
+
+    if (used > availableMemory) break;
+  }
+
+  keys.erase(keys.begin() + count, keys.end());
+}
+}  // namespace
+
 DatabaseItem::DatabaseItem(unsigned int index, int keysCount,
                            QSharedPointer<Operations> operations,
                            QWeakPointer<TreeItem> parent, Model& model)
     : AbstractNamespaceItem(model, parent, operations, index),
-      m_keysCount(keysCount) {}
+      m_keysCount(keysCount),
+      m_keysStreaming(false),
+      m_renderingStreamedKeys(false),
+      m_streamingCanceled(false),
+      m_keyspaceEventsActive(false),
+      m_keyspaceEventsMissed(false),
+      m_memoryPolicy(MemoryBudget::Policy::None) {}
 
-DatabaseItem::~DatabaseItem() {}
+DatabaseItem::~DatabaseItem() { stopKeyspaceEvents(); }
 
 QByteArray DatabaseItem::getName() const { return QByteArray(); }
 
@@ -40,10 +83,32 @@ QString DatabaseItem::getDisplayName() const {
 
   if (m_usedMemory > 0) {
     baseString.append(
-        QString(" <b>[%1]</b>").arg(humanReadableSize(m_usedMemory)));
+        QString(" <b>[%1]</b>").arg(usedMemoryLabel()));
+  }
+
+  if (m_memoryPolicy != MemoryBudget::Policy::None) {
+    baseString.append(
+        QString(" <i>[%1]</i>").arg(MemoryBudget::description(m_memoryPolicy)));
   }
 
   if (m_operations->mode() == "cluster") {
+    if (!m_nodesScanProgress.isEmpty()) {
+      int finishedNodes = 0;
+      qlonglong scannedKeys = 0;
+
+      for (const auto& progress : m_nodesScanProgress) {
+        scannedKeys += progress.first;
+        if (progress.second) finishedNodes++;
+      }
+
+      return QString("%1 %2 (scanning %3/%4 nodes, %5 keys)")
+          .arg(baseString)
+          .arg(filter)
+          .arg(finishedNodes)
+          .arg(m_nodesScanProgress.size())
+          .arg(scannedKeys);
+    }
+
     return QString("%1 %2").arg(baseString).arg(filter);
   } else {
     return QString("%1 %2 (%3)").arg(baseString).arg(filter).arg(m_keysCount);
@@ -65,11 +130,144 @@ void DatabaseItem::loadKeys(std::function<void()> callback,
     return;
   }
 
+  updateKeysCount();
+
+  if (!partialReload) {
+    m_loadedKeysFilter.clear();
+
+    // Switch to summary loading before SCAN if all keys don't fit the budget
+    m_memoryPolicy = MemoryBudget::Policy::None;
+    applyMemoryBudget(m_keysCount *
+                      (MemoryBudget::KEY_ROW_BYTES + AVERAGE_KEY_BYTES));
+  }
+
+  if (!partialReload && !isNamespacesSummaryEnabled() &&
+      isKeysDiskCacheEnabled() && renderCachedKeys(filter, callback)) {
+    return;
+  }
+
+  if (!partialReload && isKeysStreamingEnabled() &&
+      !isNamespacesSummaryEnabled()) {
+    return streamKeys(filter, callback);
+  }
+
+  auto onKeysRendered = QSharedPointer<RenderRawKeysCallback>(
+      new RenderRawKeysCallback(getSelf(), [this, callback]() {
+        ensureLoaderIsCreated();
+        unlock();
+
+        if (!isExpanded()) {
+          setExpanded(true);
+          m_model.expandItem(getSelf());
+        }
+
+        applyMemoryBudget();
+        emit m_model.itemChanged(getSelf());
+
+        if (callback) {
+          callback();
+        }
+      }));
+
+  if (!partialReload && isNamespacesSummaryEnabled()) {
+    return loadNamespacesSummary(filter, onKeysRendered);
+  }
+
+  auto nsItemsCallback = QSharedPointer<Operations::LoadNamespaceItemsCallback>(
+      new Operations::LoadNamespaceItemsCallback(
+          getSelf(), [this, onKeysRendered, partialReload, filter](
+                         RedisClient::Connection::RawKeysList keylist,
+                         const QString& err) {
+            m_nodesScanProgress.clear();
+
+            if (!err.isEmpty()) {
+              unlock();
+              return showLoadingError(err);
+            }
+
+            applyMemoryBudget(estimateKeysMemory(keylist));
+
+            // Keys are loaded already, summary is built without second SCAN
+            if (!partialReload && isNamespacesSummaryEnabled()) {
+              return summarizeLoadedKeys(keylist, onKeysRendered);
+            }
+
+            if (m_memoryPolicy == MemoryBudget::Policy::StopLoading) {
+              truncateKeys(keylist, availableMemory());
+            } else if (!partialReload) {
+              saveKeysToDiskCache(RawKeys(keylist), false);
+              setLoadedKeysFilter(filter);
+            }
+
+            return renderRawKeys(keylist, m_filter, onKeysRendered,
+                                 !partialReload, partialReload);
+          }));
+
+  m_nodesScanProgress.clear();
+
+  m_operations->loadNamespaceItems(m_dbIndex, filter, nsItemsCallback,
+                                   scanProgressCallback());
+}
+
+QSharedPointer<Operations::ScanProgressCallback>
+DatabaseItem::scanProgressCallback() {
+  return QSharedPointer<Operations::ScanProgressCallback>(
+      new Operations::ScanProgressCallback(
+          getSelf(),
+          [this](const QString& node, qlonglong keys, bool finished) {
+            m_nodesScanProgress[node] = qMakePair(keys, finished);
+            emit m_model.itemChanged(getSelf());
+          }));
+}
+
+qint64 DatabaseItem::estimatedTreeMemory() const {
+  return AbstractNamespaceItem::estimatedTreeMemory() +
+         m_keysIndex.usedMemory() +
+         m_keysIndex.size() * MemoryBudget::KEY_ROW_BYTES +
+         m_keysSnapshot.usedMemory();
+}
+
+void DatabaseItem::applyMemoryBudget(qint64 incomingMemory,
+                                     bool unloadCollapsedKeys) {
+  auto server = m_parent.toStrongRef().dynamicCast<ServerItem>();
+
+  if (!server || !server->memoryBudget().isEnabled()) return;
+
+  const auto& budget = server->memoryBudget();
+  auto policy = budget.policy(server->estimatedTreeMemory() + incomingMemory);
+
+  if (unloadCollapsedKeys &&
+      policy >= MemoryBudget::Policy::UnloadCollapsedKeys &&
+      unloadCollapsedNamespaces() > 0) {
+    policy = budget.policy(server->estimatedTreeMemory() + incomingMemory);
+  }
+
+  if (policy <= m_memoryPolicy) return;
+
+  m_memoryPolicy = policy;
+
+  qWarning() << "Keys tree of" << m_operations->connectionName() << "db"
+             << m_dbIndex << "-" << MemoryBudget::description(policy);
+
+  emit m_model.itemChanged(getSelf());
+}
+
+qint64 DatabaseItem::availableMemory() const {
+  auto server = m_parent.toStrongRef().dynamicCast<ServerItem>();
+
+  if (!server) return MemoryBudget(0).available(0);
+
+  return server->memoryBudget().available(server->estimatedTreeMemory());
+}
+
+void DatabaseItem::updateKeysCount() {
+  // NOTE: Lock isn't released on error, it may be held by another operation
+  // while keyspace notifications are verified. SCAN started by the owner of
+  // the lock fails too and releases it.
   auto dbLoadCallback = QSharedPointer<Operations::GetDatabasesCallback>(
       new Operations::GetDatabasesCallback(
           getSelf(), [this](QMap<int, int> dbMapping, const QString& err) {
             if (err.size() > 0) {
-              unlock();
               emit m_model.error(QCoreApplication::translate(
                                      "RESP", "Cannot load databases:\n\n") +
                                  err);
@@ -83,47 +281,243 @@ void DatabaseItem::loadKeys(std::function<void()> callback,
           }));
 
   m_operations->getDatabases(dbLoadCallback);
+}
 
-  auto onKeysRendered = QSharedPointer<RenderRawKeysCallback>(
-      new RenderRawKeysCallback(getSelf(), [this, callback]() {
-        ensureLoaderIsCreated();
-        unlock();
+bool DatabaseItem::isKeysStreamingEnabled() const {
+  QSettings settings;
+  return settings.value("app/streamingKeysLoading", false).toBool();
+}
+
+void DatabaseItem::streamKeys(const QString& filter,
+                              std::function<void()> callback) {
+  m_keysStreaming = true;
+  m_streamingCanceled = false;
+  m_streamingCallback = callback;
+  m_streamedKeys.clear();
+
+  auto batchCallback =
+      QSharedPointer<Operations::LoadNamespaceItemsBatchCallback>(
+          new Operations::LoadNamespaceItemsBatchCallback(
+              getSelf(),
+              [this](const RedisClient::Connection::RawKeysList& keylist,
+                     const QString& err, bool finished) {
+                if (!m_keysStreaming) return;
+
+                if (!err.isEmpty()) {
+                  m_keysStreaming = false;
+                  m_streamedKeys.clear();
+                  if (!m_renderingStreamedKeys) unlock();
+                  return showLoadingError(err);
+                }
+
+                m_streamedKeys.append(keylist);
+
+                if (finished) m_keysStreaming = false;
+
+                // Tree can't be changed while the previous batch is rendered
+                applyMemoryBudget(estimateKeysMemory(m_streamedKeys),
+                                  !m_renderingStreamedKeys);
+
+                if (m_keysStreaming &&
+                    m_memoryPolicy == MemoryBudget::Policy::StopLoading) {
+                  truncateKeys(m_streamedKeys, availableMemory());
+                  cancelCurrentOperation();
+                  return;
+                }
+
+                renderStreamedKeys();
+              }));
+
+  m_currentOperation = m_operations->loadNamespaceItemsIncrementally(
+      m_dbIndex, filter, batchCallback);
+}
+
+void DatabaseItem::renderStreamedKeys() {
+  // Batches received during rendering are merged into the next one
+  if (m_renderingStreamedKeys) return;
+
+  if (m_streamedKeys.isEmpty()) {
+    if (!m_keysStreaming) finishKeysStreaming();
+    return;
+  }
+
+  auto keys = m_streamedKeys;
+  m_streamedKeys.clear();
+
+  m_renderingStreamedKeys = true;
+
+  auto onBatchRendered = QSharedPointer<RenderRawKeysCallback>(
+      new RenderRawKeysCallback(getSelf(), [this]() {
+        m_renderingStreamedKeys = false;
 
         if (!isExpanded()) {
           setExpanded(true);
           m_model.expandItem(getSelf());
         }
 
+        applyMemoryBudget();
+
+        // Update keys counters of already rendered namespaces
+        for (const auto& ns : qAsConst(m_childNamespaces)) {
+          emit m_model.itemChanged(ns.staticCast<TreeItem>().toWeakRef());
+        }
         emit m_model.itemChanged(getSelf());
 
-        if (callback) {
-          callback();
+        renderStreamedKeys();
+      }));
+
+  // First batch is rendered from scratch, next ones are merged into the tree
+  renderRawKeys(keys, m_filter, onBatchRendered, m_childRows.isEmpty(),
+                false);
+}
+
+void DatabaseItem::finishKeysStreaming() {
+  ensureLoaderIsCreated();
+  unlock();
+
+  if (!m_streamingCanceled) {
+    saveKeysToDiskCache(collectLoadedKeys(), false);
+    setLoadedKeysFilter(m_filter.pattern());
+  }
+
+  if (!isExpanded()) {
+    setExpanded(true);
+    m_model.expandItem(getSelf());
+  }
+
+  emit m_model.itemChanged(getSelf());
+
+  auto callback = m_streamingCallback;
+  m_streamingCallback = std::function<void()>();
+
+  if (callback) callback();
+}
+
+bool DatabaseItem::isKeysDiskCacheEnabled() const {
+  QSettings settings;
+  return settings.value("app/keysDiskCache", false).toBool();
+}
+
+bool DatabaseItem::renderCachedKeys(const QString& filter,
+                                    std::function<void()> callback) {
+  auto snapshot =
+      KeysDiskCache::load(m_operations->keysCachePath(m_dbIndex, filter));
+
+  if (!snapshot.isValid()) return false;
+
+  qDebug() << "Render" << snapshot.size() << "keys from disk cache";
+
+  m_keysSnapshot = snapshot;
+
+  auto onCachedKeysRendered = QSharedPointer<RenderRawKeysCallback>(
+      new RenderRawKeysCallback(getSelf(), [this, filter, callback]() {
+        ensureLoaderIsCreated();
+
+        if (!isExpanded()) {
+          setExpanded(true);
+          m_model.expandItem(getSelf());
         }
+
+        emit m_model.itemChanged(getSelf());
+
+        // Database stays locked until cached keys are reconciled with SCAN
+        reconcileCachedKeys(filter, callback);
       }));
 
+  renderRawKeys(snapshot.keys(), m_filter, onCachedKeysRendered, true, false);
+  return true;
+}
+
+void DatabaseItem::reconcileCachedKeys(const QString& filter,
+                                       std::function<void()> callback) {
+  // Keys on disk are reconciled with the server, not with the memory cache
+  m_operations->invalidateScanResults(m_dbIndex);
+
   auto nsItemsCallback = QSharedPointer<Operations::LoadNamespaceItemsCallback>(
       new Operations::LoadNamespaceItemsCallback(
-          getSelf(), [this, onKeysRendered, partialReload](
-                         const RedisClient::Connection::RawKeysList& keylist,
-                         const QString& err) {
+          getSelf(),
+          [this, callback](const RedisClient::Connection::RawKeysList& keylist,
+                           const QString& err) {
             if (!err.isEmpty()) {
               unlock();
               return showLoadingError(err);
             }
 
-            return renderRawKeys(keylist, m_filter, onKeysRendered,
-                                 !partialReload, partialReload);
+            diffLiveUpdateKeys(keylist, [this, callback]() {
+              if (!isLiveUpdateEnabled()) m_keysSnapshot = KeysSnapshot();
+
+              if (callback) callback();
+            });
           }));
 
   m_operations->loadNamespaceItems(m_dbIndex, filter, nsItemsCallback);
 }
 
+void DatabaseItem::saveKeysToDiskCache(const RawKeys& keys, bool sorted) {
+  if (!isKeysDiskCacheEnabled()) return;
+
+  QString path = m_operations->keysCachePath(
+      m_dbIndex, m_filter.isEmpty() ? "" : m_filter.pattern());
+
+  if (path.isEmpty()) return;
+
+  KeysDiskCache::saveAsync(path, keys, sorted);
+}
+
+void DatabaseItem::scheduleDiskCacheSave() {
+  if (!isKeysDiskCacheEnabled()) return;
+
+  if (!m_diskCacheSaveTimer) {
+    m_diskCacheSaveTimer = QSharedPointer<QTimer>(new QTimer());
+    m_diskCacheSaveTimer->setInterval(DISK_CACHE_SAVE_INTERVAL);
+    m_diskCacheSaveTimer->setSingleShot(true);
+
+    QObject::connect(m_diskCacheSaveTimer.data(), &QTimer::timeout, [this]() {
+      if (m_keysSnapshot.isValid())
+        saveKeysToDiskCache(m_keysSnapshot.keys(), true);
+    });
+  }
+
+  // Diffs applied before the timeout are saved with one write
+  if (!m_diskCacheSaveTimer->isActive()) m_diskCacheSaveTimer->start();
+}
+
+void DatabaseItem::cancelCurrentOperation() {
+  if (!m_keysStreaming) {
+    return AbstractNamespaceItem::cancelCurrentOperation();
+  }
+
+  // Stop SCAN but keep keys which are already loaded
+  m_keysStreaming = false;
+  m_streamingCanceled = true;
+  m_currentOperation.cancel();
+
+  renderStreamedKeys();
+}
+
 QVariantMap DatabaseItem::metadata() const {
   QVariantMap metadata = TreeItem::metadata();
   metadata["filter"] = m_filter.pattern();
   metadata["filterHistory"] = filterHistoryTop10();
   metadata["live_update"] = isLiveUpdateEnabled();
   metadata["user_color"] = m_operations->iconColor();
+  metadata["memory_estimated"] = isUsedMemoryEstimated();
+
+  if (!m_nodesScanProgress.isEmpty()) {
+    QVariantMap scanProgress;
+
+    for (auto it = m_nodesScanProgress.constBegin();
+         it != m_nodesScanProgress.constEnd(); ++it) {
+      scanProgress[it.key()] = it.value().first;
+    }
+
+    metadata["scan_progress"] = scanProgress;
+  }
+
+  if (m_memoryPolicy != MemoryBudget::Policy::None) {
+    metadata["memory_policy"] = MemoryBudget::description(m_memoryPolicy);
+  }
+
   return metadata;
 }
 
@@ -171,9 +565,13 @@ void DatabaseItem::setMetadata(const QString& key, QVariant value) {
     if (liveUpdateTimer()->isActive() && isResetValue) {
       qDebug() << "Stop live update";
       liveUpdateTimer()->stop();
+      stopKeyspaceEvents();
+      m_keysSnapshot = KeysSnapshot();
     } else {
       qDebug() << "Start live update";
       liveUpdateTimer()->start();
+
+      if (isKeyspaceNotificationsEnabled()) enableKeyspaceEvents(false);
     }
 
     emit m_model.itemChanged(getSelf());
@@ -181,7 +579,7 @@ void DatabaseItem::setMetadata(const QString& key, QVariant value) {
 }
 
 void DatabaseItem::getMemoryUsage(std::function<void(qlonglong)> callback) {
-  if (m_childItems.size() == 0) {
+  if (m_childRows.size() == 0) {
     auto d = QSharedPointer<AsyncFuture::Deferred<qlonglong>>(
         new AsyncFuture::Deferred<qlonglong>());
     loadKeys([this, callback]() {
@@ -194,12 +592,15 @@ void DatabaseItem::getMemoryUsage(std::function<void(qlonglong)> callback) {
 }
 
 void DatabaseItem::unload(bool notify) {
-  if (m_childItems.size() == 0) return;
+  if (m_childRows.size() == 0) return;
 
   lock();
   clear();
 
   m_keysCount = 0;
+  m_keysSnapshot = KeysSnapshot();
+  m_loadedKeysFilter.clear();
+  stopKeyspaceEvents();
 
   if (notify) m_operations->notifyDbWasUnloaded(m_dbIndex);
 
@@ -208,6 +609,7 @@ void DatabaseItem::unload(bool notify) {
 
 void DatabaseItem::reload(std::function<void()> callback) {
   clear();
+  m_keysSnapshot = KeysSnapshot();
   loadKeys([this, callback]() {
     QSettings settings;
     m_model.expandedNamespaces.clear();
@@ -234,50 +636,457 @@ void DatabaseItem::performLiveUpdate() {
     return;
   }
 
-  m_rawChildKeys.clear();
+  // Keyspace notifications deliver changes, check that they are still on
+  if (m_keyspaceEventsActive && !m_keyspaceEventsMissed) {
+    return verifyKeyspaceEvents();
+  }
 
-  loadKeys(
-      [this]() {
-        QSettings settings;
-        if (m_childItems.size() >=
-            settings.value("app/liveUpdateKeysLimit", 1000).toInt()) {
-          liveUpdateTimer()->stop();
+  m_keyspaceEventsMissed = false;
 
-          emit m_model.itemChanged(getSelf());
+  lock();
+  updateKeysCount();
 
-          QMessageBox::warning(
-              nullptr,
-              QCoreApplication::translate("RESP", "Live update was disabled"),
-              QCoreApplication::translate(
-                  "RESP",
-                  "Live update was disabled due to exceeded keys limit. "
-                  "Please specify filter more carefully or change limit in "
-                  "settings."));
-        } else {
-          liveUpdateTimer()->start();
-          emit m_model.itemChanged(getSelf());
+  // Type and TTL of rendered keys could be changed since previous update
+  m_model.keysMetadata().invalidate();
+
+  QString filter = (m_filter.isEmpty()) ? "" : m_filter.pattern();
+
+  m_operations->invalidateScanResults(m_dbIndex);
+
+  auto nsItemsCallback = QSharedPointer<Operations::LoadNamespaceItemsCallback>(
+      new Operations::LoadNamespaceItemsCallback(
+          getSelf(), [this](const RedisClient::Connection::RawKeysList& keylist,
+                            const QString& err) {
+            if (!err.isEmpty()) {
+              unlock();
+              return showLoadingError(err);
+            }
+
+            diffLiveUpdateKeys(keylist, [this]() { liveUpdateTimer()->start(); });
+          }));
+
+  m_operations->loadNamespaceItems(m_dbIndex, filter, nsItemsCallback);
+}
+
+RawKeys DatabaseItem::collectLoadedKeys() {
+  RawKeys keys;
+
+  for (auto it = m_keysIndex.begin(); it != m_keysIndex.end(); ++it) {
+    keys.append(it.key());
+  }
+  collectRawKeys(keys);
+
+  return keys;
+}
+
+void DatabaseItem::diffLiveUpdateKeys(
+    const RedisClient::Connection::RawKeysList& keylist,
+    std::function<void()> callback) {
+  // Keys rendered before the first live update are used as initial snapshot
+  RawKeys renderedKeys;
+
+  if (!m_keysSnapshot.isValid()) {
+    renderedKeys = collectLoadedKeys();
+  }
+
+  auto snapshot = m_keysSnapshot;
+
+  auto future = QtConcurrent::run(
+      [snapshot, renderedKeys](RedisClient::Connection::RawKeysList keys) {
+        KeysSnapshot::normalize(keys);
+
+        KeysSnapshot previous = snapshot;
+
+        if (!previous.isValid()) {
+          auto rendered = renderedKeys.toList();
+          KeysSnapshot::normalize(rendered);
+          previous = KeysSnapshot(rendered);
         }
+
+        auto diff = previous.diff(keys);
+        return qMakePair(KeysSnapshot(keys), diff);
       },
-      true);
+      keylist);
+
+  applySnapshotUpdate(future, callback);
+}
+
+void DatabaseItem::applySnapshotUpdate(
+    QFuture<QPair<KeysSnapshot, KeysSnapshot::Diff>> future,
+    std::function<void()> callback) {
+  auto selfWPtr = getSelf();
+
+  AsyncFuture::observe(future).subscribe([selfWPtr, this, future, callback]() {
+    auto self = selfWPtr.toStrongRef();
+
+    if (!self) return;
+
+    auto result = future.result();
+    m_keysSnapshot = result.first;
+    setLoadedKeysFilter(m_filter.pattern());
+
+    if (!result.second.isEmpty()) scheduleDiskCacheSave();
+
+    applyKeysDiff(result.second, callback);
+  });
+}
+
+bool DatabaseItem::isKeyspaceNotificationsEnabled() const {
+  QSettings settings;
+  return settings.value("app/liveUpdateKeyspaceEvents", true).toBool();
+}
+
+void DatabaseItem::enableKeyspaceEvents(bool changeConfig) {
+  auto callback = QSharedPointer<Operations::EnableKeyspaceEventsCallback>(
+      new Operations::EnableKeyspaceEventsCallback(
+          getSelf(), [this, changeConfig](bool enabled, const QString& err) {
+            if (!isLiveUpdateEnabled()) return;
+
+            if (enabled) return listenKeyspaceEvents();
+
+            if (!err.isEmpty()) {
+              qDebug() << "Live update: keyspace notifications are not used:"
+                       << err;
+              if (changeConfig) emit m_model.error(err);
+              return;
+            }
+
+            if (changeConfig) return;
+
+            confirmAction(
+                nullptr,
+                QCoreApplication::translate(
+                    "RESP",
+                    "Keyspace notifications are disabled on the server. Do "
+                    "you want to enable <b>notify-keyspace-events</b> to "
+                    "apply changes without rescanning keys?"),
+                [this]() { enableKeyspaceEvents(true); },
+                QCoreApplication::translate("RESP",
+                                            "Enable keyspace notifications"));
+          }));
+
+  m_operations->enableKeyspaceEvents(changeConfig, callback);
+}
+
+void DatabaseItem::listenKeyspaceEvents() {
+  if (m_keyspaceEventsActive) return;
+
+  qDebug() << "Live update: subscribe to keyspace notifications";
+
+  auto callback = QSharedPointer<Operations::KeyspaceEventsCallback>(
+      new Operations::KeyspaceEventsCallback(
+          getSelf(), [this](const RedisClient::Connection::RawKeysList& added,
+                            const RedisClient::Connection::RawKeysList& removed,
+                            const QString& err) {
+            if (!err.isEmpty()) {
+              // Events could be lost, live update timer rescans keys
+              qWarning() << "Live update: fall back to keys diffing:" << err;
+              m_keyspaceEventsActive = false;
+              m_keyspaceEventsMissed = true;
+
+              emit m_model.error(
+                  QCoreApplication::translate(
+                      "RESP",
+                      "Keyspace notifications are not received anymore, "
+                      "keys are rescanned periodically: %1")
+                      .arg(err));
+              return;
+            }
+
+            applyKeyspaceEvents(added, removed);
+          }));
+
+  m_keyspaceEventsActive = true;
+  m_keyspaceEvents = m_operations->subscribeToKeyspaceEvents(
+      m_dbIndex, m_filter.isEmpty() ? "" : m_filter.pattern(), callback);
+
+  // Keys are rescanned once the subscription is requested, so changes made
+  // before PSUBSCRIBE are not lost
+  m_keyspaceEventsMissed = true;
+  performLiveUpdate();
+}
+
+void DatabaseItem::stopKeyspaceEvents() {
+  if (!m_keyspaceEventsActive) return;
+
+  m_keyspaceEventsActive = false;
+  m_keyspaceEvents.cancel();
+}
+
+void DatabaseItem::verifyKeyspaceEvents() {
+  updateKeysCount();
+
+  auto callback = QSharedPointer<Operations::EnableKeyspaceEventsCallback>(
+      new Operations::EnableKeyspaceEventsCallback(
+          getSelf(), [this](bool enabled, const QString&) {
+            if (!enabled) {
+              // notify-keyspace-events was changed on the server
+              stopKeyspaceEvents();
+              return performLiveUpdate();
+            }
+
+            liveUpdateTimer()->start();
+          }));
+
+  m_operations->enableKeyspaceEvents(false, callback);
+}
+
+void DatabaseItem::applyKeyspaceEvents(
+    const RedisClient::Connection::RawKeysList& added,
+    const RedisClient::Connection::RawKeysList& removed) {
+  if (!m_keyspaceEventsActive) return;
+
+  if (isLocked()) {
+    m_keyspaceEventsMissed = true;
+    return;
+  }
+
+  lock();
+
+  RawKeys renderedKeys;
+
+  if (!m_keysSnapshot.isValid()) {
+    renderedKeys = collectLoadedKeys();
+  }
+
+  auto snapshot = m_keysSnapshot;
+
+  auto future = QtConcurrent::run([snapshot, renderedKeys, added, removed]() {
+    KeysSnapshot previous = snapshot;
+
+    if (!previous.isValid()) {
+      auto rendered = renderedKeys.toList();
+      KeysSnapshot::normalize(rendered);
+      previous = KeysSnapshot(rendered);
+    }
+
+    KeysSnapshot::Diff applied;
+    auto next = previous.apply(added, removed, applied);
+    return qMakePair(next, applied);
+  });
+
+  applySnapshotUpdate(future, std::function<void()>());
+}
+
+void DatabaseItem::applyKeysDiff(const KeysSnapshot::Diff& diff,
+                                 std::function<void()> callback) {
+  qDebug() << "Live update: added" << diff.added.size() << "removed"
+           << diff.removed.size();
+
+  QSettings settings;
+
+  if (diff.size() > settings.value("app/liveUpdateKeysLimit", 1000).toInt()) {
+    // Too many changes to apply them one by one, render tree from scratch
+    auto onTreeRendered = QSharedPointer<RenderRawKeysCallback>(
+        new RenderRawKeysCallback(getSelf(), [this, callback]() {
+          QSettings settings;
+
+          ensureLoaderIsCreated();
+          unlock();
+
+          if (settings.value("app/reopenNamespacesOnReload", true).toBool()) {
+            auto self = getSelf().toStrongRef();
+
+            if (self)
+              restoreOpenedNamespaces(self.staticCast<AbstractNamespaceItem>());
+          }
+
+          emit m_model.itemChanged(getSelf());
+
+          if (callback) callback();
+        }));
+
+    clear();
+    return renderRawKeys(m_keysSnapshot.keys(), m_filter, onTreeRendered,
+                         true, false);
+  }
+
+  auto onKeysRendered = QSharedPointer<RenderRawKeysCallback>(
+      new RenderRawKeysCallback(getSelf(), [this, callback]() {
+        ensureLoaderIsCreated();
+        unlock();
+        applyMemoryBudget();
+        emit m_model.itemChanged(getSelf());
+
+        if (callback) callback();
+      }));
+
+  removeKeys(diff.removed);
+
+  if (diff.added.isEmpty()) {
+    return onKeysRendered->call();
+  }
+
+  renderRawKeys(diff.added, m_filter, onKeysRendered, false, false);
+}
+
+void DatabaseItem::removeKeys(const RedisClient::Connection::RawKeysList& keys) {
+  QList<QByteArray> renderedKeys;
+  QList<QSharedPointer<AbstractNamespaceItem>> holders;
+  QHash<AbstractNamespaceItem*, QSet<QByteArray>> rawKeys;
+
+  for (const auto& key : keys) {
+    if (m_keysIndex.contains(key)) {
+      renderedKeys.append(key);
+      continue;
+    }
+
+    auto holder = findKeyHolder(key);
+
+    if (!rawKeys.contains(holder.data())) holders.append(holder);
+
+    rawKeys[holder.data()].insert(key);
+  }
+
+  // Raw keys go first, namespaces can be removed with the last rendered key
+  for (const auto& holder : qAsConst(holders)) {
+    holder->removeRawKeys(rawKeys[holder.data()]);
+
+    if (holder->type() == "namespace" && holder->keysCount() == 0) {
+      removeEmptyNamespace(holder);
+    }
+  }
+
+  if (renderedKeys.size() > 0) {
+    removeObsoleteKeys(renderedKeys);
+  }
+}
+
+void DatabaseItem::removeEmptyNamespace(
+    QSharedPointer<AbstractNamespaceItem> ns) {
+  QSharedPointer<TreeItem> itemToRemove = ns;
+
+  // Remove the topmost namespace left without keys
+  while (true) {
+    auto parent = itemToRemove->parent()
+                      .toStrongRef()
+                      .dynamicCast<AbstractNamespaceItem>();
+
+    if (!parent || parent->type() != "namespace" || parent->keysCount() > 0)
+      break;
+
+    itemToRemove = parent;
+  }
+
+  auto parent = itemToRemove->parent().toStrongRef();
+
+  if (!parent) return;
+
+  int row = itemToRemove->row();
+
+  m_model.beforeItemChildRemoved(itemToRemove->parent(), row);
+  parent->removeChild(row);
+  m_model.itemChildRemoved(itemToRemove);
 }
 
 void DatabaseItem::filterKeys(const QRegExp& filter) {
+  bool filterLocally = canFilterLoadedKeys(filter.pattern());
+
   m_filter = filter;
   emit m_model.itemChanged(getSelf());
-  reload();
+
+  if (filterLocally) {
+    filterLoadedKeys();
+  } else {
+    reload();
+  }
+
+  if (m_keyspaceEventsActive) {
+    stopKeyspaceEvents();
+    listenKeyspaceEvents();
+  }
 }
 
 void DatabaseItem::resetFilter() {
   m_filter = QRegExp(m_operations->defaultFilter());
   emit m_model.itemChanged(getSelf());
   reload();
+
+  if (m_keyspaceEventsActive) {
+    stopKeyspaceEvents();
+    listenKeyspaceEvents();
+  }
+}
+
+void DatabaseItem::setLoadedKeysFilter(const QString& filter) {
+  // Summary doesn't contain names of namespaced keys
+  if (isNamespacesSummaryEnabled()) {
+    m_loadedKeysFilter.clear();
+    return;
+  }
+
+  m_loadedKeysFilter = filter.isEmpty() ? QString("*") : filter;
+  m_loadedKeysAge.start();
+}
+
+bool DatabaseItem::canFilterLoadedKeys(const QString& filter) const {
+  if (isLocked() || m_loadedKeysFilter.isEmpty()) return false;
+
+  bool isFresh = (m_keyspaceEventsActive && !m_keyspaceEventsMissed) ||
+                 m_loadedKeysAge.elapsed() < LOADED_KEYS_MAX_AGE;
+
+  if (!isFresh) return false;
+
+  return m_loadedKeysFilter == filter ||
+         GlobMatcher(m_loadedKeysFilter.toUtf8()).isMatchAll();
+}
+
+void DatabaseItem::filterLoadedKeys() {
+  lock();
+
+  // Snapshot of live update is sorted, so filtered keys are sorted too
+  bool sorted = m_keysSnapshot.isValid();
+  RawKeys keys = sorted ? m_keysSnapshot.keys() : collectLoadedKeys();
+  GlobMatcher matcher(m_filter.pattern().toUtf8());
+
+  auto future =
+      QtConcurrent::run([keys, matcher]() { return matcher.filter(keys); });
+
+  auto selfWPtr = getSelf();
+
+  AsyncFuture::observe(future).subscribe([selfWPtr, this, future, sorted]() {
+    auto self = selfWPtr.toStrongRef();
+
+    if (!self) return;
+
+    auto keylist = future.result();
+
+    qDebug() << "Filtered loaded keys:" << keylist.size();
+
+    clear();
+    m_keysSnapshot = sorted ? KeysSnapshot(keylist) : KeysSnapshot();
+    // Filtered keys are as fresh as keys they were filtered from
+    m_loadedKeysFilter = m_filter.pattern();
+
+    auto onKeysRendered = QSharedPointer<RenderRawKeysCallback>(
+        new RenderRawKeysCallback(getSelf(), [this]() {
+          QSettings settings;
+
+          ensureLoaderIsCreated();
+          unlock();
+
+          m_model.expandedNamespaces.clear();
+
+          if (settings.value("app/reopenNamespacesOnReload", true).toBool()) {
+            auto self = getSelf().toStrongRef();
+
+            if (self)
+              restoreOpenedNamespaces(self.staticCast<AbstractNamespaceItem>());
+          }
+
+          applyMemoryBudget();
+          emit m_model.itemChanged(getSelf());
+        }));
+
+    renderRawKeys(keylist, m_filter, onKeysRendered, true, false);
+  });
 }
 
 QHash<QString, std::function<bool ()> > DatabaseItem::eventHandlers() {
   auto events = AbstractNamespaceItem::eventHandlers();
 
   events.insert("click", [this]() {
-    if (m_childItems.size() != 0) {
+    if (m_childRows.size() != 0) {
       if (!isExpanded()) {
         setExpanded(true);
         m_model.expandItem(getSelf());
@@ -290,7 +1099,7 @@ QHash<QString, std::function<bool ()> > DatabaseItem::eventHandlers() {
   });
 
   events.insert("right-click", [this]() {
-    if (m_childItems.size() != 0) return true;
+    if (m_childRows.size() != 0) return true;
 
     emit m_model.itemChanged(getSelf());
     return true;
@@ -299,6 +1108,8 @@ QHash<QString, std::function<bool ()> > DatabaseItem::eventHandlers() {
   events.insert("add_key", [this]() {
     auto callback = QSharedPointer<Operations::OpenNewKeyDialogCallback>(
         new Operations::OpenNewKeyDialogCallback(getSelf(), [this]() {
+          m_operations->invalidateScanResults(m_dbIndex);
+
           confirmAction(
               nullptr,
               QCoreApplication::translate(
@@ -317,6 +1128,8 @@ QHash<QString, std::function<bool ()> > DatabaseItem::eventHandlers() {
   });
 
   events.insert("reload", [this]() {
+    // Explicit reload always scans the server
+    m_operations->invalidateScanResults(m_dbIndex);
     reload();
     return false;
   });
@@ -1,5 +1,9 @@
 #pragma once
+#include <QElapsedTimer>
+
 #include "abstractnamespaceitem.h"
+#include "connections-tree/keyssnapshot.h"
+#include "connections-tree/rawkeys.h"
 
 namespace ConnectionsTree {
 
@@ -31,11 +35,18 @@ class DatabaseItem : public AbstractNamespaceItem {
 
   void reload(std::function<void()> callback = std::function<void()>());
 
+  void cancelCurrentOperation() override;
+
+  qint64 estimatedTreeMemory() const override;
+
+  MemoryBudget::Policy memoryPolicy() const override { return m_memoryPolicy; }
+
  protected:
   void loadKeys(std::function<void()> callback = std::function<void()>(),
                 bool partialReload=false);
   void unload(bool notify = true);
   void performLiveUpdate();
+  void updateKeysCount();
   void filterKeys(const QRegExp& filter);
   void resetFilter();
 
@@ -46,9 +57,70 @@ class DatabaseItem : public AbstractNamespaceItem {
   bool isLiveUpdateEnabled() const;
   QVariantList filterHistoryTop10() const;
 
+  bool isKeysStreamingEnabled() const;
+  void streamKeys(const QString& filter, std::function<void()> callback);
+  void renderStreamedKeys();
+  void finishKeysStreaming();
+
+  bool isKeysDiskCacheEnabled() const;
+  bool renderCachedKeys(const QString& filter, std::function<void()> callback);
+  void reconcileCachedKeys(const QString& filter,
+                           std::function<void()> callback);
+  void saveKeysToDiskCache(const RawKeys& keys, bool sorted);
+  void scheduleDiskCacheSave();
+
+  RawKeys collectLoadedKeys();
+  void diffLiveUpdateKeys(const RedisClient::Connection::RawKeysList& keylist,
+                          std::function<void()> callback);
+  void applyKeysDiff(const KeysSnapshot::Diff& diff,
+                     std::function<void()> callback);
+  void removeKeys(const RedisClient::Connection::RawKeysList& keys);
+  void removeEmptyNamespace(QSharedPointer<AbstractNamespaceItem> ns);
+
+  QSharedPointer<Operations::ScanProgressCallback> scanProgressCallback();
+
+  // Picks policy of the connection budget for the tree with keys which are
+  // about to be rendered, policy isn't relaxed until keys are reloaded
+  void applyMemoryBudget(qint64 incomingMemory = 0,
+                         bool unloadCollapsedKeys = true);
+  qint64 availableMemory() const;
+
+  bool isKeyspaceNotificationsEnabled() const;
+  void enableKeyspaceEvents(bool changeConfig);
+  void listenKeyspaceEvents();
+  void stopKeyspaceEvents();
+  void verifyKeyspaceEvents();
+  void applyKeyspaceEvents(const RedisClient::Connection::RawKeysList& added,
+                           const RedisClient::Connection::RawKeysList& removed);
+  void applySnapshotUpdate(
+      QFuture<QPair<KeysSnapshot, KeysSnapshot::Diff>> future,
+      std::function<void()> callback);
+
+  // Keys matching the filter are loaded and kept up to date
+  void setLoadedKeysFilter(const QString& filter);
+  bool canFilterLoadedKeys(const QString& filter) const;
+  void filterLoadedKeys();
+
  private:
   unsigned int m_keysCount;
   QSharedPointer<QTimer> m_liveUpdateTimer;
+  QSharedPointer<QTimer> m_diskCacheSaveTimer;
+  RedisClient::Connection::RawKeysList m_streamedKeys;
+  std::function<void()> m_streamingCallback;
+  bool m_keysStreaming;
+  bool m_renderingStreamedKeys;
+  bool m_streamingCanceled;
+  KeysSnapshot m_keysSnapshot;
+  // Amount of scanned keys and finished flag per cluster node
+  QMap<QString, QPair<qlonglong, bool>> m_nodesScanProgress;
+  QFuture<void> m_keyspaceEvents;
+  bool m_keyspaceEventsActive;
+  // Events received during another loading operation weren't applied
+  bool m_keyspaceEventsMissed;
+  MemoryBudget::Policy m_memoryPolicy;
+  // Filter of completely loaded keys, empty if some keys weren't loaded
+  QString m_loadedKeysFilter;
+  QElapsedTimer m_loadedKeysAge;
 };
 
 }  // namespace ConnectionsTree
@@ -28,29 +28,55 @@ KeyItem::KeyItem(const QByteArray& fullPath, QWeakPointer<TreeItem> parent,
       m_fullPath(fullPath),
       m_parent(parent),
       m_removed(false),
-      m_shortRendering(shortNameRendering)
+      m_shortRendering(shortNameRendering),
+      m_keyMetadataGeneration(0)
 {
 }
 
-QString KeyItem::getDisplayName() const {
-  QString title;
-
+QString KeyItem::printableName() const {
   if (m_parent && m_parent.toStrongRef()->type() == "namespace" &&
       m_shortRendering) {
     auto parent = parentTreeItemToNs(m_parent);
 
-    title = printableString(getFullPath().mid(
+    return printableString(getFullPath().mid(
         parent->getFullPath().size() +
         parent->operations()->getNamespaceSeparator().size()));
-  } else {
-    title = printableString(getFullPath(), true);
+  }
+
+  return printableString(getFullPath(), true);
+}
+
+QString KeyItem::collationName() const { return printableName(); }
+
+QString KeyItem::getDisplayName() const {
+  if (!m_displayName.isNull()) return m_displayName;
+
+  QString title = printableName();
+
+  if (hasKeyMetadata()) {
+    QString details = QString::fromUtf8(m_keyMetadata.type);
+
+    if (!m_keyMetadata.encoding.isEmpty())
+      details.append(
+          QString(", %1").arg(QString::fromUtf8(m_keyMetadata.encoding)));
+
+    // Seconds are rounded up, so keys which are about to expire aren't
+    // shown as persistent ones with 0s
+    if (m_keyMetadata.ttl >= 1000)
+      details.append(
+          QString(", TTL: %1s").arg((m_keyMetadata.ttl + 999) / 1000));
+    else if (m_keyMetadata.ttl >= 0)
+      details.append(QString(", TTL: %1ms").arg(m_keyMetadata.ttl));
+
+    title.append(QString(" <i>[%1]</i>").arg(details));
   }
 
   if (m_usedMemory > 0) {
     title.append(QString(" <b>[%1]</b>").arg(humanReadableSize(m_usedMemory)));
   }
 
-  return title;
+  m_displayName = title;
+  return m_displayName;
 }
 
 QByteArray KeyItem::getName() const { return getFullPath(); }
@@ -104,17 +130,34 @@ void KeyItem::getMemoryUsage(std::function<void(qlonglong)> callback) {
       new Operations::GetUsedMemoryCallback(
           getSelf(), [this, callback](qlonglong result) {
             m_usedMemory = result;
+            invalidateDisplayName();
             callback(result);
             emit m_model.itemChanged(getSelf());
           }));
 
   parentNs->operations()->getUsedMemory(
-      {getFullPath()}, getDbIndex(), cb,
+      RedisClient::Connection::RawKeysList{getFullPath()}, getDbIndex(), cb,
       QSharedPointer<Operations::GetUsedMemoryCallback>());
 }
 
+bool KeyItem::hasKeyMetadata() const {
+  return !m_keyMetadata.type.isEmpty() && m_keyMetadata.type != "none";
+}
+
+void KeyItem::setKeyMetadata(const Operations::KeyMetadata& metadata) {
+  m_keyMetadata = metadata;
+
+  if (metadata.usedMemory > 0) m_usedMemory = metadata.usedMemory;
+
+  invalidateDisplayName();
+
+  emit m_model.itemChanged(getSelf());
+}
+
 void KeyItem::setFullPath(const QByteArray& p) {
   m_fullPath = p;
+  invalidateDisplayName();
+  invalidateCollationKey();
 
   emit m_model.itemChanged(getSelf());
 }
@@ -39,14 +39,38 @@ class KeyItem : public TreeItem, public MemoryUsage {
 
   void getMemoryUsage(std::function<void(qlonglong)> callback) override;
 
+  bool hasKeyMetadata() const;
+
+  Operations::KeyMetadata keyMetadata() const { return m_keyMetadata; }
+
+  void setKeyMetadata(const Operations::KeyMetadata& metadata);
+
+  // Generation of KeysMetadataPrefetcher metadata was requested for
+  uint keyMetadataGeneration() const { return m_keyMetadataGeneration; }
+
+  void setKeyMetadataGeneration(uint generation) {
+    m_keyMetadataGeneration = generation;
+  }
+
  protected:
   QHash<QString, std::function<bool()>> eventHandlers() override;
 
+  QString collationName() const override;
+
+ private:
+  QString printableName() const;
+
+  // Display name is cached until name, used memory or metadata is changed
+  void invalidateDisplayName() { m_displayName.clear(); }
+
  private:
   QByteArray m_fullPath;
   QWeakPointer<TreeItem> m_parent;
   bool m_removed;
   bool m_shortRendering;
+  Operations::KeyMetadata m_keyMetadata;
+  uint m_keyMetadataGeneration;
+  mutable QString m_displayName;
 };
 
 }  // namespace ConnectionsTree
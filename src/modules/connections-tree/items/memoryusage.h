@@ -4,20 +4,42 @@
 #include <QString>
 #include <functional>
 
+#include "app/apputils.h"
 #include "treeitem.h"
 
 namespace ConnectionsTree {
 class MemoryUsage {
  public:
-  MemoryUsage() : m_usedMemory(0) {}
+  MemoryUsage()
+      : m_usedMemory(0), m_usedMemoryError(0), m_usedMemoryEstimated(false) {}
   virtual ~MemoryUsage() {}
 
   virtual void getMemoryUsage(std::function<void(qlonglong)> callback) = 0;
 
   qlonglong usedMemory() const { return m_usedMemory; }
 
+  // 95% margin of error when used memory was estimated from a sample of keys
+  qlonglong usedMemoryError() const { return m_usedMemoryError; }
+
+  // NOTE: margin of error is 0 when all sampled keys have the same size
+  bool isUsedMemoryEstimated() const { return m_usedMemoryEstimated; }
+
+ protected:
+  QString usedMemoryLabel() const {
+    if (!isUsedMemoryEstimated()) return humanReadableSize(m_usedMemory);
+
+    if (m_usedMemoryError <= 0)
+      return QString("~%1").arg(humanReadableSize(m_usedMemory));
+
+    return QString("~%1 &plusmn; %2")
+        .arg(humanReadableSize(m_usedMemory))
+        .arg(humanReadableSize(m_usedMemoryError));
+  }
+
  protected:
   qlonglong m_usedMemory;
+  qlonglong m_usedMemoryError;
+  bool m_usedMemoryEstimated;
   QMutex m_updateUsedMemoryMutex;
 };
 }  // namespace ConnectionsTree
@@ -26,12 +26,17 @@ QString NamespaceItem::getDisplayName() const {
                       .arg(keysCount());
 
   if (m_usedMemory > 0) {
-    title.append(QString(" <b>[%1]</b>").arg(humanReadableSize(m_usedMemory)));
+    title.append(QString(" <b>[%1]</b>").arg(usedMemoryLabel()));
   }
 
   return title;
 }
 
+QString NamespaceItem::collationName() const {
+  // Keys counter and used memory of the display name are changed often
+  return printableString(getName(), true);
+}
+
 QByteArray NamespaceItem::getName() const {
   qsizetype pos = m_fullPath.lastIndexOf(m_operations->getNamespaceSeparator());
 
@@ -57,6 +62,7 @@ void NamespaceItem::setRemoved() {
 QVariantMap NamespaceItem::metadata() const {
   QVariantMap metadata = TreeItem::metadata();
   metadata["full_path"] = getFullPath();
+  metadata["memory_estimated"] = isUsedMemoryEstimated();
   return metadata;
 }
 
@@ -72,8 +78,7 @@ void NamespaceItem::load() {
       }));
 
   if (m_rawChildKeys.size() > 0) {
-    auto rawKeys = m_rawChildKeys;
-    m_rawChildKeys.clear();
+    auto rawKeys = takeRawChildKeys();
 
     return renderRawKeys(rawKeys, m_filter, onKeysRendered, true, false);
   }
@@ -93,6 +98,10 @@ void NamespaceItem::load() {
     }
   }
 
+  if (isNamespacesSummaryEnabled()) {
+    return loadNamespacesSummary(nsFilter, onKeysRendered);
+  }
+
   auto callback = QSharedPointer<Operations::LoadNamespaceItemsCallback>(
       new Operations::LoadNamespaceItemsCallback(
           getSelf(), [this, nsFilter, onKeysRendered](
@@ -119,9 +128,13 @@ QHash<QString, std::function<bool()>> NamespaceItem::eventHandlers() {
   auto events = AbstractNamespaceItem::eventHandlers();
 
   events.insert("click", [this]() {
-    if (m_childItems.size() == 0) {
+    if (m_childRows.size() == 0) {
       load();
       return false;
+    } else if (hasRemoteKeys()) {
+      // Only nested namespaces were aggregated, load own keys
+      reload();
+      return false;
     } else if (!isExpanded()) {
       setExpanded(true);
       emit m_model.itemChanged(getSelf());
@@ -133,6 +146,8 @@ QHash<QString, std::function<bool()>> NamespaceItem::eventHandlers() {
   events.insert("add_key", [this]() {
     auto callback = QSharedPointer<Operations::OpenNewKeyDialogCallback>(
         new Operations::OpenNewKeyDialogCallback(getSelf(), [this]() {
+          m_operations->invalidateScanResults(m_dbIndex);
+
           confirmAction(
               nullptr,
               QCoreApplication::translate(
@@ -150,7 +165,11 @@ QHash<QString, std::function<bool()>> NamespaceItem::eventHandlers() {
     return true;
   });
 
-  events.insert("reload", [this]() { reload(); return false; });
+  events.insert("reload", [this]() {
+    m_operations->invalidateScanResults(m_dbIndex);
+    reload();
+    return false;
+  });
 
   events.insert("delete", [this]() { m_operations->deleteDbNamespace(*this); return true; });
 
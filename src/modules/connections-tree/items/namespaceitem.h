@@ -38,6 +38,8 @@ class NamespaceItem : public AbstractNamespaceItem {
 
   QHash<QString, std::function<bool()>> eventHandlers() override;
 
+  QString collationName() const override;
+
  private:
   QByteArray m_fullPath;
   bool m_removed;
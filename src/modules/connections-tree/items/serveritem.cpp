@@ -56,6 +56,19 @@ bool ServerItem::isDatabaseListLoaded() const {
 
 QSharedPointer<Operations> ServerItem::getOperations() { return m_operations; }
 
+const MemoryBudget& ServerItem::memoryBudget() const { return m_memoryBudget; }
+
+qint64 ServerItem::estimatedTreeMemory() const {
+  // Cached SCAN results are another copy of keys kept by the connection
+  qint64 result = m_operations->scanResultsMemory();
+
+  for (const auto& db : m_databases) {
+    result += db.staticCast<DatabaseItem>()->estimatedTreeMemory();
+  }
+
+  return result;
+}
+
 int ServerItem::row() const
 {
     if (!parent()) {
@@ -66,6 +79,9 @@ int ServerItem::row() const
 }
 
 void ServerItem::load() {
+  // Budget setting is applied on reconnect
+  m_memoryBudget = MemoryBudget();
+
   auto callback = QSharedPointer<Operations::GetDatabasesCallback>(
       new Operations::GetDatabasesCallback(
           getSelf(),
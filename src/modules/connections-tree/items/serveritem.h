@@ -2,6 +2,7 @@
 #include <QList>
 #include <QObject>
 
+#include "connections-tree/memorybudget.h"
 #include "connections-tree/operations.h"
 #include "sortabletreeitem.h"
 
@@ -40,6 +41,11 @@ class ServerItem : public QObject, public SortableTreeItem {
 
   QSharedPointer<Operations> getOperations();
 
+  // Budget is shared by keys trees of all databases
+  const MemoryBudget& memoryBudget() const;
+
+  qint64 estimatedTreeMemory() const;
+
   int row() const override;
 
  public slots:
@@ -65,5 +71,6 @@ class ServerItem : public QObject, public SortableTreeItem {
   QWeakPointer<ServerItem> m_self;
   QWeakPointer<TreeItem> m_parent;
   QModelIndex m_index;
+  MemoryBudget m_memoryBudget;
 };
 }  // namespace ConnectionsTree
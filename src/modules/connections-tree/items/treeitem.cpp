@@ -2,7 +2,12 @@
 #include "connections-tree/model.h"
 
 ConnectionsTree::TreeItem::TreeItem(Model &m)
-    : m_model(m), m_locked(false), m_expanded(false) {}
+    : m_model(m), m_locked(false), m_expanded(false), m_handle(0) {}
+
+ConnectionsTree::TreeItem::~TreeItem() {
+  // Slot of the handle is reused without waiting for a sweep
+  if (m_handle) m_model.releaseItemHandle(m_handle);
+}
 
 QVariantMap ConnectionsTree::TreeItem::metadata() const {
   QVariantMap meta;
@@ -14,16 +19,42 @@ QVariantMap ConnectionsTree::TreeItem::metadata() const {
   return meta;
 }
 
+const QByteArray &ConnectionsTree::TreeItem::collationKey() const {
+  if (m_collationKey.isEmpty()) m_collationKey = buildCollationKey(collationName());
+
+  return m_collationKey;
+}
+
+QByteArray ConnectionsTree::TreeItem::buildCollationKey(const QString &name) {
+  QByteArray key;
+  key.reserve(name.size() * 2);
+
+  // Big-endian UTF-16 code units are compared bytewise in the same order as
+  // QString compares them
+  for (const QChar &c : name) {
+    key.append(static_cast<char>(c.unicode() >> 8));
+    key.append(static_cast<char>(c.unicode() & 0xFF));
+  }
+
+  return key;
+}
+
+int ConnectionsTree::TreeItem::indexOfChild(const TreeItem *item) {
+  for (uint index = 0; index < childCount(); ++index) {
+    if (child(index).data() == item) return index;
+  }
+
+  return -1;
+}
+
 int ConnectionsTree::TreeItem::row() const {
   if (!parent()) return 0;
 
   auto p = parent().toStrongRef();
 
-  for (uint index = 0; index < p->childCount(); ++index) {
-    if (p->child(index).data() == this) return index;
-  }
+  if (!p) return 0;
 
-  return 0;
+  return qMax(0, p->indexOfChild(this));
 }
 
 QWeakPointer<ConnectionsTree::TreeItem> ConnectionsTree::TreeItem::getSelf() {
@@ -14,12 +14,15 @@
 namespace ConnectionsTree {
 
 class Model;
+class TreeItemHandles;
 
 class TreeItem {
+  friend class TreeItemHandles;
+
  public:
   TreeItem(Model& m);
 
-  virtual ~TreeItem() {}
+  virtual ~TreeItem();
 
   virtual QString getDisplayName() const = 0;
 
@@ -27,6 +30,10 @@ class TreeItem {
 
   virtual QByteArray getFullPath() const { return QByteArray(); }
 
+  // Binary key which orders items like their names, it's cached so
+  // comparison of items doesn't allocate memory
+  const QByteArray& collationKey() const;
+
   virtual QString type() const = 0;
 
   virtual QList<QSharedPointer<TreeItem>> getAllChilds() const = 0;
@@ -37,6 +44,9 @@ class TreeItem {
 
   virtual void removeChild(int) {};
 
+  // Row of the child item or -1
+  virtual int indexOfChild(const TreeItem* item);
+
   virtual QWeakPointer<TreeItem> parent() const { return QWeakPointer<TreeItem>(); }
 
   virtual bool supportChildItems() const { return true; }  
@@ -70,12 +80,23 @@ class TreeItem {
   void unlock();
   virtual QHash<QString, std::function<bool ()> > eventHandlers();
 
+  // Name used to build collation key
+  virtual QString collationName() const { return getDisplayName(); }
+
+  void invalidateCollationKey() { m_collationKey.clear(); }
+
+  static QByteArray buildCollationKey(const QString& name);
+
  protected:
   Model& m_model;  
   QWeakPointer<TreeItem> m_selfPtr;
   bool m_locked;
   bool m_expanded;
   QFuture<void> m_currentOperation;
+
+ private:
+  quintptr m_handle;
+  mutable QByteArray m_collationKey;
 };
 
 typedef QList<QSharedPointer<TreeItem>> TreeItems;
@@ -0,0 +1,175 @@
+#include "keysdiskcache.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <cstring>
+#include <limits>
+
+using namespace ConnectionsTree;
+
+namespace {
+const char MAGIC[] = "RESPKEYS";
+const quint32 FORMAT_VERSION = 1;
+
+struct Header {
+  char magic[8];
+  quint32 version;
+  qint32 count;
+};
+
+// Mapped key bytes are addressed by QByteArray with int size
+const qint64 MAX_DATA_SIZE = std::numeric_limits<qint32>::max();
+
+// Guards generations of paths and serializes writes of cache files
+QMutex writeMutex;
+
+// Generation of the latest requested save or removal per path
+QHash<QString, quint64> pathGenerations;
+
+quint64 nextGeneration(const QString &path) {
+  QMutexLocker locker(&writeMutex);
+  return ++pathGenerations[path];
+}
+}  // namespace
+
+bool KeysDiskCache::save(const QString &path, const RawKeys &keys) {
+  if (path.isEmpty()) return false;
+
+  QVector<qint32> offsets;
+  offsets.reserve(keys.size() + 1);
+  offsets.append(0);
+
+  qint64 dataSize = 0;
+  keys.forEach([&offsets, &dataSize](const QByteArray &key) {
+    dataSize += key.size();
+    offsets.append(static_cast<qint32>(qMin(dataSize, MAX_DATA_SIZE)));
+  });
+
+  if (dataSize >= MAX_DATA_SIZE) {
+    qWarning() << "Keys cache is too big:" << dataSize;
+    return false;
+  }
+
+  QSaveFile file(path);
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Cannot write keys cache:" << file.errorString();
+    return false;
+  }
+
+  // Cache contains key names, keep it private like connections config
+  file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+  Header header;
+  memcpy(header.magic, MAGIC, sizeof(header.magic));
+  header.version = FORMAT_VERSION;
+  header.count = keys.size();
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(offsets.constData()),
+             offsets.size() * sizeof(qint32));
+
+  keys.forEach([&file](const QByteArray &key) { file.write(key); });
+
+  if (!file.commit()) {
+    qWarning() << "Cannot save keys cache:" << file.errorString();
+    return false;
+  }
+
+  return true;
+}
+
+void KeysDiskCache::saveAsync(const QString &path, const RawKeys &keys,
+                              bool sorted) {
+  if (path.isEmpty()) return;
+
+  quint64 generation = nextGeneration(path);
+
+  QtConcurrent::run([path, keys, sorted, generation]() {
+    RawKeys sortedKeys = keys;
+
+    if (!sorted) {
+      auto keysList = keys.toList();
+      KeysSnapshot::normalize(keysList);
+      sortedKeys = RawKeys(keysList);
+    }
+
+    QMutexLocker locker(&writeMutex);
+
+    // Newer save or removal of the path was requested in the meantime
+    if (pathGenerations.value(path) != generation) return;
+
+    save(path, sortedKeys);
+  });
+}
+
+KeysSnapshot KeysDiskCache::load(const QString &path) {
+  QFile file(path);
+
+  if (path.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+    return KeysSnapshot();
+  }
+
+  qint64 fileSize = file.size();
+
+  if (fileSize < static_cast<qint64>(sizeof(Header))) return KeysSnapshot();
+
+  // Mapping is released with the file, keys are copied to the arena
+  const uchar *mapped = file.map(0, fileSize);
+
+  if (!mapped) {
+    qWarning() << "Cannot map keys cache:" << file.errorString();
+    return KeysSnapshot();
+  }
+
+  Header header;
+  memcpy(&header, mapped, sizeof(header));
+
+  if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != FORMAT_VERSION || header.count < 0) {
+    return KeysSnapshot();
+  }
+
+  qint64 offsetsSize = (static_cast<qint64>(header.count) + 1) * sizeof(qint32);
+  qint64 dataStart = sizeof(Header) + offsetsSize;
+
+  if (dataStart > fileSize) return KeysSnapshot();
+
+  auto offsets = reinterpret_cast<const qint32 *>(mapped + sizeof(Header));
+
+  if (offsets[0] != 0) return KeysSnapshot();
+
+  // Offsets are validated once, so keys can be read without bound checks
+  qint32 previous = 0;
+
+  for (qint32 index = 0; index <= header.count; ++index) {
+    if (offsets[index] < previous) return KeysSnapshot();
+    previous = offsets[index];
+  }
+
+  if (dataStart + previous != fileSize) return KeysSnapshot();
+
+  if (header.count == 0) return KeysSnapshot(RawKeys());
+
+  auto arena = QSharedPointer<const KeysArena>(
+      new KeysArena(reinterpret_cast<const char *>(mapped + dataStart),
+                    offsets, header.count));
+
+  return KeysSnapshot(RawKeys(arena));
+}
+
+void KeysDiskCache::remove(const QString &path) {
+  if (path.isEmpty()) return;
+
+  nextGeneration(path);
+
+  QMutexLocker locker(&writeMutex);
+
+  if (QFile::exists(path) && !QFile::remove(path)) {
+    qWarning() << "Cannot remove keys cache:" << path;
+  }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <QString>
+
+#include "keyssnapshot.h"
+#include "rawkeys.h"
+
+namespace ConnectionsTree {
+
+/*
+ * Sorted keys of a database stored on disk between sessions. File contains
+ * header, offsets of keys and packed key bytes, so loaded snapshot is copied
+ * into a keys arena at once without parsing keys. File isn't kept open, so
+ * it can be replaced or removed while the snapshot is used.
+ */
+class KeysDiskCache {
+ public:
+  // NOTE: keys must be sorted and unique
+  static bool save(const QString& path, const RawKeys& keys);
+
+  // Saves keys in a worker thread. Saves of one path are written in the
+  // order they were requested, outdated saves which weren't started yet
+  // are skipped.
+  static void saveAsync(const QString& path, const RawKeys& keys,
+                        bool sorted);
+
+  // Returns invalid snapshot if file doesn't exist or is corrupted
+  static KeysSnapshot load(const QString& path);
+
+  // Pending saves of the path are skipped
+  static void remove(const QString& path);
+};
+
+}  // namespace ConnectionsTree
@@ -0,0 +1,31 @@
+#include "keysindex.h"
+
+using namespace ConnectionsTree;
+
+int KeysIndex::removePrefix(const QByteArray &prefix) {
+  if (prefix.isEmpty()) {
+    int removed = m_index.size();
+    clear();
+    return removed;
+  }
+
+  int removed = 0;
+  auto it = m_index.lowerBound(prefix);
+
+  while (it != m_index.end() && it.key().startsWith(prefix)) {
+    m_keysBytes -= it.key().size();
+    it = m_index.erase(it);
+    removed++;
+  }
+
+  return removed;
+}
+
+QList<QByteArray> KeysIndex::keysWithPrefix(const QByteArray &prefix) const {
+  QList<QByteArray> result;
+
+  forEachWithPrefix(prefix,
+                    [&result](const QByteArray &key) { result.append(key); });
+
+  return result;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+
+namespace ConnectionsTree {
+
+/*
+ * Sorted index of names of rendered keys. Keys of one namespace are placed
+ * next to each other, so prefix operations cost O(log n + k). Copies share
+ * data until one of them is modified and can be used as snapshots.
+ *
+ * Names are shared with flyweight rows of namespaces, so a rendered key
+ * stores its full path only once.
+ */
+class KeysIndex {
+ public:
+  using Container = QMap<QByteArray, bool>;
+  using const_iterator = Container::const_iterator;
+
+  KeysIndex() : m_keysBytes(0) {}
+
+  void insert(const QByteArray& fullPath) {
+    int size = m_index.size();
+    m_index.insert(fullPath, true);
+
+    if (m_index.size() != size) m_keysBytes += fullPath.size();
+  }
+
+  void remove(const QByteArray& fullPath) {
+    if (m_index.remove(fullPath) > 0) m_keysBytes -= fullPath.size();
+  }
+
+  bool contains(const QByteArray& fullPath) const {
+    return m_index.contains(fullPath);
+  }
+
+  int size() const { return m_index.size(); }
+
+  bool isEmpty() const { return m_index.isEmpty(); }
+
+  void clear() {
+    m_index.clear();
+    m_keysBytes = 0;
+  }
+
+  // Estimated memory of index nodes and key names
+  qint64 usedMemory() const {
+    return m_index.size() * INDEX_NODE_BYTES + m_keysBytes;
+  }
+
+  const_iterator begin() const { return m_index.constBegin(); }
+
+  const_iterator end() const { return m_index.constEnd(); }
+
+  const_iterator lowerBound(const QByteArray& fullPath) const {
+    return m_index.lowerBound(fullPath);
+  }
+
+  int removePrefix(const QByteArray& prefix);
+
+  QList<QByteArray> keysWithPrefix(const QByteArray& prefix) const;
+
+  template <typename Callback>
+  void forEachWithPrefix(const QByteArray& prefix, Callback callback) const {
+    for (auto it = m_index.lowerBound(prefix);
+         it != m_index.constEnd() && it.key().startsWith(prefix); ++it) {
+      callback(it.key());
+    }
+  }
+
+ private:
+  // QMap node with key header and allocator overhead
+  static const qint64 INDEX_NODE_BYTES = 56;
+
+  Container m_index;
+  qint64 m_keysBytes;
+};
+
+}  // namespace ConnectionsTree
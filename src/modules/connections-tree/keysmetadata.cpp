@@ -0,0 +1,150 @@
+#include "keysmetadata.h"
+
+#include <QHash>
+#include <QSettings>
+
+#include "items/abstractnamespaceitem.h"
+#include "items/keyitem.h"
+#include "operations.h"
+
+using namespace ConnectionsTree;
+
+namespace {
+// Time to collect rows of the viewport before sending request
+const int FLUSH_DELAY = 50;
+
+// Rate cap, minimal interval between requests in ms
+const int FLUSH_INTERVAL = 500;
+
+// Only the most recently requested keys are loaded, keys requested before
+// them are scrolled out of the viewport already
+const int BATCH_LIMIT = 200;
+}  // namespace
+
+KeysMetadataPrefetcher::KeysMetadataPrefetcher(QObject *parent)
+    : QObject(parent), m_generation(1) {
+  m_flushTimer.setSingleShot(true);
+
+  QObject::connect(&m_flushTimer, &QTimer::timeout, this,
+                   &KeysMetadataPrefetcher::flush);
+}
+
+void KeysMetadataPrefetcher::request(QSharedPointer<TreeItem> item) {
+  auto key = item.dynamicCast<KeyItem>();
+
+  // Keys requested while prefetching is disabled are requested again once
+  // it's enabled
+  if (!key || key->keyMetadataGeneration() == m_generation || !isEnabled())
+    return;
+
+  key->setKeyMetadataGeneration(m_generation);
+  m_pendingKeys.append(item.toWeakRef());
+
+  scheduleFlush();
+}
+
+void KeysMetadataPrefetcher::invalidate() {
+  m_generation++;
+
+  auto visibleKeys = m_visibleKeys;
+
+  for (auto keyRef : qAsConst(visibleKeys)) {
+    auto key = keyRef.toStrongRef();
+
+    if (key) request(key);
+  }
+}
+
+bool KeysMetadataPrefetcher::isEnabled() {
+  QSettings settings;
+  return settings.value("app/keysMetadataPrefetch", true).toBool();
+}
+
+void KeysMetadataPrefetcher::scheduleFlush() {
+  if (m_flushTimer.isActive()) return;
+
+  qint64 delay = FLUSH_DELAY;
+
+  if (m_lastFlush.isValid()) {
+    delay = qMax<qint64>(delay, FLUSH_INTERVAL - m_lastFlush.elapsed());
+  }
+
+  m_flushTimer.start(static_cast<int>(delay));
+}
+
+void KeysMetadataPrefetcher::flush() {
+  m_lastFlush.start();
+
+  int outdatedKeys = qMax(0, m_pendingKeys.size() - BATCH_LIMIT);
+
+  // Keys are requested again when they are scrolled back into the viewport
+  for (int i = 0; i < outdatedKeys; i++) {
+    auto key = m_pendingKeys.at(i).toStrongRef().staticCast<KeyItem>();
+
+    if (key) key->setKeyMetadataGeneration(0);
+  }
+
+  m_visibleKeys = m_pendingKeys.mid(outdatedKeys);
+  m_pendingKeys.clear();
+
+  if (m_visibleKeys.isEmpty()) return;
+
+  if (!isEnabled()) {
+    // Prefetching was disabled after the keys were requested
+    for (auto keyRef : qAsConst(m_visibleKeys)) {
+      auto key = keyRef.toStrongRef().staticCast<KeyItem>();
+
+      if (key) key->setKeyMetadataGeneration(0);
+    }
+    return;
+  }
+
+  struct Batch {
+    QSharedPointer<AbstractNamespaceItem> db;
+    RedisClient::Connection::RawKeysList keys;
+    QList<QWeakPointer<TreeItem>> items;
+  };
+
+  QHash<TreeItem *, Batch> batches;
+
+  for (auto keyRef : qAsConst(m_visibleKeys)) {
+    auto key = keyRef.toStrongRef();
+
+    if (!key || !key->isEnabled()) continue;
+
+    auto db = key;
+
+    while (db && db->type() != "database") {
+      db = db->parent().toStrongRef();
+    }
+
+    if (!db) continue;
+
+    auto &batch = batches[db.data()];
+
+    if (!batch.db) batch.db = db.staticCast<AbstractNamespaceItem>();
+
+    batch.keys.append(key->getFullPath());
+    batch.items.append(keyRef);
+  }
+
+  for (const auto &batch : qAsConst(batches)) {
+    if (!batch.db->operations()) continue;
+
+    auto items = batch.items;
+
+    auto callback = QSharedPointer<Operations::GetKeysMetadataCallback>(
+        new Operations::GetKeysMetadataCallback(
+            batch.db.staticCast<TreeItem>().toWeakRef(),
+            [items](const QList<Operations::KeyMetadata> &metadata) {
+              for (int i = 0; i < items.size() && i < metadata.size(); i++) {
+                auto key = items.at(i).toStrongRef().staticCast<KeyItem>();
+
+                if (key) key->setKeyMetadata(metadata.at(i));
+              }
+            }));
+
+    batch.db->operations()->getKeysMetadata(batch.keys, batch.db->getDbIndex(),
+                                            callback);
+  }
+}
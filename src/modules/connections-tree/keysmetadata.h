@@ -0,0 +1,47 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QWeakPointer>
+
+namespace ConnectionsTree {
+
+class TreeItem;
+
+/*
+ * Loads TYPE, PTTL, OBJECT ENCODING and MEMORY USAGE of keys rendered by the
+ * view. Model requests metadata only for rows delegates ask data for, so
+ * requests queued between flushes describe the current viewport and are sent
+ * as one pipelined request per database. Flushes are rate limited.
+ */
+class KeysMetadataPrefetcher : public QObject {
+  Q_OBJECT
+ public:
+  explicit KeysMetadataPrefetcher(QObject* parent = nullptr);
+
+  // Queues key item if its metadata wasn't loaded for the current generation
+  void request(QSharedPointer<TreeItem> key);
+
+  // Marks cached metadata of all keys as stale and reloads visible keys
+  void invalidate();
+
+  uint generation() const { return m_generation; }
+
+  static bool isEnabled();
+
+ private:
+  void scheduleFlush();
+
+  void flush();
+
+ private:
+  QList<QWeakPointer<TreeItem>> m_pendingKeys;
+  QList<QWeakPointer<TreeItem>> m_visibleKeys;
+  QTimer m_flushTimer;
+  QElapsedTimer m_lastFlush;
+  uint m_generation;
+};
+
+}  // namespace ConnectionsTree
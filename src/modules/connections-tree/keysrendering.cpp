@@ -1,6 +1,7 @@
 #include "keysrendering.h"
 
 #include <QtGlobal>
+#include <algorithm>
 
 #include "items/abstractnamespaceitem.h"
 #include "items/keyitem.h"
@@ -43,47 +44,56 @@ void KeysTreeRenderer::renderKeys(QSharedPointer<Operations> operations,
 
   auto rootItem = resolveRootItem(parent);
 
-  QHash<QByteArray, QWeakPointer<KeyItem>> preRenderedKeys;
+  // Live index is used instead of a snapshot: a snapshot would be detached
+  // by the first rendered key. Rendered keys are not looked up again since
+  // keys in the list are unique.
+  static const KeysIndex noRenderedKeys;
+
+  const KeysIndex &preRenderedKeys =
+      rootItem ? rootItem->getKeysIndex() : noRenderedKeys;
 
-  if (rootItem) {
-      qDebug() << "Root item resolved";
-      preRenderedKeys = rootItem->getKeysIndex();
-  }
   qDebug() << "Pre-rendered keys: " << preRenderedKeys.size();
 
-  auto preRenderedKeysList = preRenderedKeys.keys();
-  QSet<QByteArray> preRenderedKeysSet = QSet<QByteArray>(preRenderedKeysList.begin(),
-                                                         preRenderedKeysList.end());
-  QSet<QByteArray> preRenderedKeysToBeRemoved;
+  qDebug() << "Live update: " << settings.checkPreRenderedItems;
+
+  QList<QByteArray> obsoleteKeys;
 
   if (settings.checkPreRenderedItems) {
-    preRenderedKeysToBeRemoved = QSet<QByteArray>(preRenderedKeysSet.begin(),
-                                                  preRenderedKeysSet.end());
-  }
+    // Both lists are sorted, keys missing in the new list are obsolete
+    QByteArray prefix = parent->getFullPath();
+    if (unprocessedPartStart > 0)
+      prefix.append(settings.nsSeparator.toUtf8());
 
-  qDebug() << "Live update: " << settings.checkPreRenderedItems;
+    auto newKey = keys.constBegin();
+
+    preRenderedKeys.forEachWithPrefix(
+        prefix, [&newKey, &keys, &obsoleteKeys](const QByteArray &fullPath) {
+          while (newKey != keys.constEnd() && *newKey < fullPath) ++newKey;
+
+          if (newKey == keys.constEnd() || *newKey != fullPath) {
+            obsoleteKeys.append(fullPath);
+          }
+        });
+  }
 
   QByteArray rawKey;
   QByteArray nextKey;
 
   QList<QByteArray> bulkInsertItems;
 
-  auto isBulkInsert = [settings, preRenderedKeysSet, unprocessedPartStart](
+  auto isBulkInsert = [&settings, &preRenderedKeys, unprocessedPartStart](
                           const QByteArray &current, const QByteArray &next) {
     return (settings.appendNewItems &&
             current.indexOf(settings.nsSeparator, unprocessedPartStart) == -1 &&
             !next.isEmpty() &&
             next.indexOf(settings.nsSeparator, unprocessedPartStart) == -1 &&
-            !preRenderedKeysSet.contains(next));
+            !preRenderedKeys.contains(next));
   };
 
   while (!keys.isEmpty()) {
     rawKey = keys.takeFirst();
 
-    if (preRenderedKeysSet.contains(rawKey)) {
-        if (preRenderedKeysToBeRemoved.contains(rawKey)) {
-            preRenderedKeysToBeRemoved.remove(rawKey);
-        }
+    if (preRenderedKeys.contains(rawKey)) {
         continue;
     }
 
@@ -99,7 +109,7 @@ void KeysTreeRenderer::renderKeys(QSharedPointer<Operations> operations,
     } else if (bulkInsertItems.size() > 0 && parent) {
       int itemsAboutToBeInserted =
           qMin(static_cast<uint>(bulkInsertItems.size()),
-               settings.renderLimit - parent->getAllChilds().size());
+               settings.renderLimit - parent->childCount());
 
       qDebug() << "Bulk insert" << itemsAboutToBeInserted;
 
@@ -108,16 +118,13 @@ void KeysTreeRenderer::renderKeys(QSharedPointer<Operations> operations,
                                             itemsAboutToBeInserted);
 
       for (const auto &item : bulkInsertItems) {
-        if (parent->getAllChilds().size() >= settings.renderLimit) {
+        if (parent->childCount() >= settings.renderLimit) {
           parent->appendRawKey(item);
         } else {
-          QSharedPointer<KeyItem> newKey(new KeyItem(
-              item, parent, parent->model(), settings.shortKeysRendering));
-
-          parent->append(newKey, false);
+          parent->appendKey(item, false);
 
           if (rootItem && rootItem->type() == "database") {
-            rootItem->appendKeyToIndex(newKey);
+            rootItem->appendKeyToIndex(item);
           }
         }
       }
@@ -136,13 +143,7 @@ void KeysTreeRenderer::renderKeys(QSharedPointer<Operations> operations,
     }
   }  
 
-  if (preRenderedKeysToBeRemoved.size() > 0) {
-    QList<QWeakPointer<KeyItem>> obsoleteKeys;
-
-    for (const auto &keyFullPath : qAsConst(preRenderedKeysToBeRemoved)) {
-      obsoleteKeys.append(preRenderedKeys[keyFullPath]);
-    }
-
+  if (obsoleteKeys.size() > 0) {
     parent->removeObsoleteKeys(obsoleteKeys);
   }
 
@@ -171,21 +172,17 @@ void KeysTreeRenderer::renderLazily(QSharedPointer<AbstractNamespaceItem> root,
           : notProcessedKeyPart.indexOf(settings.nsSeparator);
 
   if (indexOfNaspaceSeparator == -1) {
-    if (parent->getAllChilds().size() >= settings.renderLimit) {
+    if (parent->childCount() >= settings.renderLimit) {
       parent->appendRawKey(fullKey);
     } else {
-      QSharedPointer<KeyItem> newKey(new KeyItem(fullKey, currentParent,
-                                                 parent->model(),
-                                                 settings.shortKeysRendering));
-
       if (settings.appendNewItems) {
-        parent->append(newKey);
+        parent->appendKey(fullKey);
       } else {
-        parent->insertChild(newKey);
+        parent->insertKey(fullKey);
       }
 
       if (root && root->type() == "database") {
-        root->appendKeyToIndex(newKey);
+        root->appendKeyToIndex(fullKey);
       }
     }
     return;
@@ -204,13 +201,10 @@ void KeysTreeRenderer::renderLazily(QSharedPointer<AbstractNamespaceItem> root,
 
     // Single namespaced key
     if (nextKey.isEmpty() || nextKey.indexOf(namespaceFullPath) == -1) {
-      QSharedPointer<KeyItem> newKey(new KeyItem(fullKey, currentParent,
-                                                 parent->model(),
-                                                 settings.shortKeysRendering));
-      parent->append(newKey);
+      parent->appendKey(fullKey);
 
       if (root && root->type() == "database") {
-        root->appendKeyToIndex(newKey);
+        root->appendKeyToIndex(fullKey);
       }
       return;
     }
@@ -224,6 +218,28 @@ void KeysTreeRenderer::renderLazily(QSharedPointer<AbstractNamespaceItem> root,
     }
 
     parent->appendNamespace(namespaceItem);
+
+    // Keys which were rendered as single namespaced keys before other keys
+    // of the namespace arrived (e.g. in previous SCAN batches) are moved
+    // into the namespace
+    if (root && root->type() == "database") {
+      QByteArray nsPrefix = namespaceFullPath + settings.nsSeparator.toUtf8();
+      auto renderedKeys = root->getKeysIndex().keysWithPrefix(nsPrefix);
+
+      if (!renderedKeys.isEmpty()) {
+        root->removeNamespacedKeysFromIndex(nsPrefix);
+
+        for (const auto &key : renderedKeys) {
+          if (!parent->removeKeyRow(key)) {
+            root->appendKeyToIndex(key);
+            continue;
+          }
+
+          renderLazily(root, namespaceItem, key.mid(nsPrefix.size()), key,
+                       m_operations, settings, expandedNamespaces, level + 1);
+        }
+      }
+    }
   }
 
   renderLazily(root, namespaceItem,
@@ -232,3 +248,179 @@ void KeysTreeRenderer::renderLazily(QSharedPointer<AbstractNamespaceItem> root,
                fullKey, m_operations, settings, expandedNamespaces,
                level + 1, nextKey);
 }
+
+QSharedPointer<KeysTreeRenderer::NamespaceTrieNode>
+KeysTreeRenderer::buildNamespaceTrie(
+    const RedisClient::Connection::RawKeysList &keys, int prefixLength,
+    const RenderingSettigns &settings,
+    const QSet<QByteArray> &expandedNamespaces) {
+  QElapsedTimer timer;
+  timer.start();
+
+  auto root = QSharedPointer<NamespaceTrieNode>(new NamespaceTrieNode());
+  root->expanded = true;
+
+  try {
+    // Keys which are not rendered share packed storage
+    RawKeys packedKeys = RawKeys::pack(keys);
+
+    buildTrieLevel(*root, keys, packedKeys, 0, keys.size(), prefixLength,
+                   settings.nsSeparator.toUtf8(), settings,
+                   expandedNamespaces);
+  } catch (std::bad_alloc &) {
+    return QSharedPointer<NamespaceTrieNode>();
+  }
+
+  qDebug() << "Namespace trie builded in: " << timer.elapsed() << " ms";
+
+  return root;
+}
+
+void KeysTreeRenderer::buildTrieLevel(
+    NamespaceTrieNode &node, const RedisClient::Connection::RawKeysList &keys,
+    const RawKeys &packedKeys, int begin, int end, int prefixLength,
+    const QByteArray &separator, const RenderingSettigns &settings,
+    const QSet<QByteArray> &expandedNamespaces) {
+  node.keysCount = end - begin;
+
+  int rawRangeStart = -1;
+  int rawRangeEnd = -1;
+
+  auto flushRawRange = [&node, &packedKeys, &rawRangeStart, &rawRangeEnd]() {
+    if (rawRangeStart < 0) return;
+
+    node.rawKeys.append(
+        packedKeys.mid(rawRangeStart, rawRangeEnd - rawRangeStart));
+    rawRangeStart = rawRangeEnd = -1;
+  };
+
+  auto appendKey = [&node, &settings, &keys, &rawRangeStart, &rawRangeEnd,
+                    &flushRawRange](int index) {
+    if (static_cast<uint>(node.childs.size()) < settings.renderLimit) {
+      node.childs.append({keys.at(index), QSharedPointer<NamespaceTrieNode>()});
+      return;
+    }
+
+    if (rawRangeEnd != index) {
+      flushRawRange();
+      rawRangeStart = index;
+    }
+    rawRangeEnd = index + 1;
+  };
+
+  int index = begin;
+
+  while (index < end) {
+    const QByteArray &key = keys.at(index);
+
+    int separatorPos =
+        separator.isEmpty() ? -1 : key.indexOf(separator, prefixLength);
+
+    if (separatorPos == -1) {
+      appendKey(index);
+      index++;
+      continue;
+    }
+
+    // Keys are sorted so all keys of the namespace are placed in one block
+    QByteArray nsPrefix = key.left(separatorPos + separator.size());
+
+    auto blockEnd = std::partition_point(
+        keys.begin() + index + 1, keys.begin() + end,
+        [&nsPrefix](const QByteArray &k) { return k.startsWith(nsPrefix); });
+
+    int nsEnd = static_cast<int>(blockEnd - keys.begin());
+
+    // Single namespaced key
+    if (nsEnd - index == 1) {
+      appendKey(index);
+      index++;
+      continue;
+    }
+
+    auto ns = QSharedPointer<NamespaceTrieNode>(new NamespaceTrieNode());
+    ns->fullPath = key.left(separatorPos);
+    ns->expanded = expandedNamespaces.contains(ns->fullPath);
+
+    if (ns->expanded) {
+      buildTrieLevel(*ns, keys, packedKeys, index, nsEnd, nsPrefix.size(),
+                     separator, settings, expandedNamespaces);
+    } else {
+      ns->keysCount = nsEnd - index;
+      ns->rawKeys = packedKeys.mid(index, nsEnd - index);
+    }
+
+    node.childs.append({QByteArray(), ns});
+    index = nsEnd;
+  }
+
+  flushRawRange();
+}
+
+void KeysTreeRenderer::renderNamespaceTrie(
+    QSharedPointer<Operations> operations,
+    QSharedPointer<NamespaceTrieNode> trie,
+    QSharedPointer<AbstractNamespaceItem> parent,
+    const RenderingSettigns &settings) {
+  if (!trie || !parent) return;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  auto rootItem = resolveRootItem(parent);
+
+  auto rows = createTrieRows(operations, *trie, parent, rootItem, settings);
+
+  // Nested namespaces are populated before they become visible in the model
+  // so only one insertion is reported per rendered level
+  parent->appendRows(rows);
+  parent->appendRawKeys(trie->rawKeys);
+
+  qDebug() << "Tree builded in: " << timer.elapsed() << " ms";
+}
+
+AbstractNamespaceItem::ChildRows KeysTreeRenderer::createTrieRows(
+    QSharedPointer<Operations> operations, const NamespaceTrieNode &node,
+    QSharedPointer<AbstractNamespaceItem> parent,
+    QSharedPointer<AbstractNamespaceItem> root,
+    const RenderingSettigns &settings) {
+  AbstractNamespaceItem::ChildRows rows;
+  rows.reserve(node.childs.size());
+
+  QWeakPointer<TreeItem> currentParent =
+      parent.staticCast<TreeItem>().toWeakRef();
+
+  bool indexKeys = root && root->type() == "database";
+
+  for (const auto &child : node.childs) {
+    if (child.ns) {
+      auto namespaceItem = QSharedPointer<NamespaceItem>(new NamespaceItem(
+          child.ns->fullPath, operations, currentParent, parent->model(),
+          settings.dbIndex, settings.filter));
+
+      namespaceItem->setExpanded(child.ns->expanded);
+
+      if (child.ns->expanded) {
+        namespaceItem->appendRows(
+            createTrieRows(operations, *child.ns, namespaceItem, root,
+                           settings),
+            false);
+      }
+
+      namespaceItem->appendRawKeys(child.ns->rawKeys);
+      rows.append(AbstractNamespaceItem::ChildRow{namespaceItem, QByteArray()});
+    } else {
+      if (indexKeys) {
+        root->appendKeyToIndex(child.key);
+      }
+
+      rows.append(AbstractNamespaceItem::ChildRow::key(child.key));
+    }
+  }
+
+  // Keys are sorted bytewise, rows follow the display name collation of
+  // insertRow() so live updates are placed next to rendered rows
+  parent->sortRows(rows);
+
+  return rows;
+}
@@ -5,11 +5,15 @@
 #include <QtConcurrent>
 #include <qredisclient/connection.h>
 
+#include "items/abstractnamespaceitem.h"
+#include "rawkeys.h"
+
 namespace ConnectionsTree {
 
     class Operations;
     class AbstractNamespaceItem;
     class Model;
+    class TreeItem;
 
     QSharedPointer<AbstractNamespaceItem> resolveRootItem(QSharedPointer<AbstractNamespaceItem> item);
 
@@ -23,7 +27,25 @@ namespace ConnectionsTree {
             uint renderLimit;            
             bool appendNewItems;
             bool checkPreRenderedItems;
-            bool shortKeysRendering;
+            bool namespacesOnTop;
+        };
+
+        /*
+         * Namespace trie built from the sorted keys list in a worker thread.
+         * Only expanded namespaces get child nodes, keys of collapsed
+         * namespaces and keys above the rendering limit are kept as raw keys.
+         */
+        struct NamespaceTrieNode {
+            struct Child {
+                QByteArray key;
+                QSharedPointer<NamespaceTrieNode> ns;
+            };
+
+            QByteArray fullPath;
+            bool expanded = false;
+            uint keysCount = 0;
+            QList<Child> childs;
+            RawKeys rawKeys;
         };
 
     public:
@@ -31,9 +53,36 @@ namespace ConnectionsTree {
                                RedisClient::Connection::RawKeysList keys,
                                QSharedPointer<AbstractNamespaceItem> parent,
                                RenderingSettigns settings,
-                               const QSet<QByteArray> &expandedNamespaces);                
+                               const QSet<QByteArray> &expandedNamespaces);
+
+        // NOTE: thread-safe, keys must be sorted
+        static QSharedPointer<NamespaceTrieNode> buildNamespaceTrie(
+                const RedisClient::Connection::RawKeysList &keys,
+                int prefixLength,
+                const RenderingSettigns &settings,
+                const QSet<QByteArray> &expandedNamespaces);
+
+        static void renderNamespaceTrie(QSharedPointer<Operations> operations,
+                                        QSharedPointer<NamespaceTrieNode> trie,
+                                        QSharedPointer<AbstractNamespaceItem> parent,
+                                        const RenderingSettigns &settings);
 
     private:
+        static void buildTrieLevel(NamespaceTrieNode &node,
+                                   const RedisClient::Connection::RawKeysList &keys,
+                                   const RawKeys &packedKeys,
+                                   int begin, int end, int prefixLength,
+                                   const QByteArray &separator,
+                                   const RenderingSettigns &settings,
+                                   const QSet<QByteArray> &expandedNamespaces);
+
+        static AbstractNamespaceItem::ChildRows createTrieRows(
+                QSharedPointer<Operations> operations,
+                const NamespaceTrieNode &node,
+                QSharedPointer<AbstractNamespaceItem> parent,
+                QSharedPointer<AbstractNamespaceItem> root,
+                const RenderingSettigns &settings);
+
         static void renderLazily(QSharedPointer<AbstractNamespaceItem> root,
                                  QSharedPointer<AbstractNamespaceItem> parent,
                                  const QByteArray &notProcessedKeyPart,
@@ -0,0 +1,88 @@
+#include "keyssnapshot.h"
+
+#include <algorithm>
+
+#include "keyssorting.h"
+
+using namespace ConnectionsTree;
+
+KeysSnapshot::KeysSnapshot(const RedisClient::Connection::RawKeysList &keys)
+    : m_keys(RawKeys::pack(keys)), m_valid(true) {}
+
+KeysSnapshot::Diff KeysSnapshot::diff(
+    const RedisClient::Connection::RawKeysList &keys) const {
+  Diff result;
+
+  auto newKey = keys.constBegin();
+
+  m_keys.forEach([&result, &newKey, &keys](const QByteArray &oldKey) {
+    while (newKey != keys.constEnd() && *newKey < oldKey) {
+      result.added.append(*newKey);
+      ++newKey;
+    }
+
+    if (newKey != keys.constEnd() && *newKey == oldKey) {
+      ++newKey;
+      return;
+    }
+
+    // Deep copy, key bytes are owned by the snapshot
+    result.removed.append(QByteArray(oldKey.constData(), oldKey.size()));
+  });
+
+  while (newKey != keys.constEnd()) {
+    result.added.append(*newKey);
+    ++newKey;
+  }
+
+  return result;
+}
+
+KeysSnapshot KeysSnapshot::apply(RedisClient::Connection::RawKeysList added,
+                                 RedisClient::Connection::RawKeysList removed,
+                                 Diff &applied) const {
+  normalize(added);
+  normalize(removed);
+
+  RedisClient::Connection::RawKeysList keys;
+  keys.reserve(m_keys.size() + added.size());
+
+  auto newKey = added.constBegin();
+  auto removedKey = removed.constBegin();
+
+  m_keys.forEach([&](const QByteArray &oldKey) {
+    while (newKey != added.constEnd() && *newKey < oldKey) {
+      keys.append(*newKey);
+      applied.added.append(*newKey);
+      ++newKey;
+    }
+
+    if (newKey != added.constEnd() && *newKey == oldKey) ++newKey;
+
+    while (removedKey != removed.constEnd() && *removedKey < oldKey) {
+      ++removedKey;
+    }
+
+    if (removedKey != removed.constEnd() && *removedKey == oldKey) {
+      applied.removed.append(*removedKey);
+      ++removedKey;
+      return;
+    }
+
+    // Raw key is copied when the new snapshot is packed
+    keys.append(oldKey);
+  });
+
+  while (newKey != added.constEnd()) {
+    keys.append(*newKey);
+    applied.added.append(*newKey);
+    ++newKey;
+  }
+
+  return KeysSnapshot(keys);
+}
+
+void KeysSnapshot::normalize(RedisClient::Connection::RawKeysList &keys) {
+  sortKeys(keys);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include "rawkeys.h"
+
+namespace ConnectionsTree {
+
+/*
+ * Sorted and de-duplicated list of keys loaded during the previous live
+ * update. Diff with the next list is calculated with one linear merge walk,
+ * so only added and removed keys are applied to the tree.
+ */
+class KeysSnapshot {
+ public:
+  struct Diff {
+    RedisClient::Connection::RawKeysList added;
+    RedisClient::Connection::RawKeysList removed;
+
+    int size() const { return added.size() + removed.size(); }
+
+    bool isEmpty() const { return added.isEmpty() && removed.isEmpty(); }
+  };
+
+ public:
+  KeysSnapshot() : m_valid(false) {}
+
+  // NOTE: keys must be sorted and unique
+  explicit KeysSnapshot(const RedisClient::Connection::RawKeysList& keys);
+
+  explicit KeysSnapshot(const RawKeys& keys) : m_keys(keys), m_valid(true) {}
+
+  bool isValid() const { return m_valid; }
+
+  int size() const { return m_keys.size(); }
+
+  RawKeys keys() const { return m_keys; }
+
+  qint64 usedMemory() const { return m_keys.usedMemory(); }
+
+  // NOTE: thread-safe, keys must be sorted and unique
+  Diff diff(const RedisClient::Connection::RawKeysList& keys) const;
+
+  // Applies keys reported by keyspace notifications with one merge walk,
+  // only actual changes are returned in the diff
+  // NOTE: thread-safe
+  KeysSnapshot apply(RedisClient::Connection::RawKeysList added,
+                     RedisClient::Connection::RawKeysList removed,
+                     Diff& applied) const;
+
+  // Sorts keys and drops duplicates returned by SCAN
+  static void normalize(RedisClient::Connection::RawKeysList& keys);
+
+ private:
+  RawKeys m_keys;
+  bool m_valid;
+};
+
+}  // namespace ConnectionsTree
@@ -0,0 +1,244 @@
+#include "keyssorting.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace ConnectionsTree;
+
+namespace {
+
+using KeysVector = std::vector<QByteArray>;
+
+// Ranges below this size are sorted with std::sort in one thread
+const size_t PARALLEL_SORT_THRESHOLD = 50000;
+
+// Deep common prefixes are handled by merge sort instead of radix passes
+const int MAX_RADIX_DEPTH = 32;
+
+// 0 - end of key, 1..256 - key bytes
+const int RADIX_BUCKETS = 257;
+
+struct Range {
+  size_t begin;
+  size_t end;
+};
+
+inline int radixBucket(const QByteArray &key, int depth) {
+  return depth < key.size() ? static_cast<uchar>(key.at(depth)) + 1 : 0;
+}
+
+class ParallelKeysSorter {
+ public:
+  ParallelKeysSorter(KeysVector &keys, std::function<bool()> isCanceled)
+      : m_keys(keys),
+        m_isCanceled(isCanceled),
+        m_threads(qMax(1, QThread::idealThreadCount())) {}
+
+  bool sort() {
+    sortRange({0, m_keys.size()}, 0);
+    return !canceled();
+  }
+
+ private:
+  bool canceled() const { return m_isCanceled && m_isCanceled(); }
+
+  QList<Range> splitRange(Range range, size_t parts) const {
+    QList<Range> result;
+    size_t size = range.end - range.begin;
+    size_t chunk = qMax<size_t>(1, (size + parts - 1) / parts);
+
+    for (size_t begin = range.begin; begin < range.end; begin += chunk) {
+      result.append({begin, qMin(range.end, begin + chunk)});
+    }
+    return result;
+  }
+
+  void sortRange(Range range, int depth) {
+    if (canceled()) return;
+
+    size_t size = range.end - range.begin;
+
+    if (size < PARALLEL_SORT_THRESHOLD) {
+      std::sort(m_keys.begin() + range.begin, m_keys.begin() + range.end);
+      return;
+    }
+
+    QList<Range> buckets;
+
+    while (depth < MAX_RADIX_DEPTH) {
+      buckets = radixPartition(range, depth);
+
+      if (canceled()) return;
+
+      // All keys share the same byte at this depth
+      if (buckets.size() == 1 && buckets.first().end - buckets.first().begin == size) {
+        depth++;
+        continue;
+      }
+      break;
+    }
+
+    if (depth >= MAX_RADIX_DEPTH) {
+      return mergeSort(range);
+    }
+
+    QList<Range> smallBuckets;
+    QList<Range> largeBuckets;
+
+    for (const auto &bucket : qAsConst(buckets)) {
+      if (bucket.end - bucket.begin >= PARALLEL_SORT_THRESHOLD) {
+        largeBuckets.append(bucket);
+      } else {
+        smallBuckets.append(bucket);
+      }
+    }
+
+    QtConcurrent::blockingMap(smallBuckets, [this](const Range &bucket) {
+      if (canceled()) return;
+      std::sort(m_keys.begin() + bucket.begin, m_keys.begin() + bucket.end);
+    });
+
+    // Large buckets are partitioned by the next byte using all threads
+    for (const auto &bucket : qAsConst(largeBuckets)) {
+      sortRange(bucket, depth + 1);
+    }
+  }
+
+  /*
+   * Moves keys of the range into buckets by the byte at the given depth.
+   * Returns ranges of buckets which still have to be sorted, keys which end
+   * at this depth are equal and don't need sorting.
+   */
+  QList<Range> radixPartition(Range range, int depth) {
+    auto chunks = splitRange(range, m_threads);
+
+    std::vector<std::array<size_t, RADIX_BUCKETS>> histograms(chunks.size());
+
+    QList<int> chunkIndexes;
+    for (int index = 0; index < chunks.size(); ++index) chunkIndexes.append(index);
+
+    QtConcurrent::blockingMap(
+        chunkIndexes, [this, &chunks, &histograms, depth](int chunkIndex) {
+          auto &histogram = histograms[chunkIndex];
+          histogram.fill(0);
+
+          const Range &chunk = chunks.at(chunkIndex);
+          for (size_t index = chunk.begin; index < chunk.end; ++index) {
+            histogram[radixBucket(m_keys[index], depth)]++;
+          }
+        });
+
+    std::array<size_t, RADIX_BUCKETS> bucketStart;
+    QList<Range> buckets;
+    size_t offset = range.begin;
+
+    for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+      bucketStart[bucket] = offset;
+
+      for (const auto &histogram : histograms) offset += histogram[bucket];
+
+      if (offset - bucketStart[bucket] == range.end - range.begin) {
+        // Nothing to move
+        return bucket == 0 ? QList<Range>() : QList<Range>{range};
+      }
+
+      if (bucket > 0 && offset - bucketStart[bucket] > 1) {
+        buckets.append({bucketStart[bucket], offset});
+      }
+    }
+
+    // Write positions of every chunk inside of every bucket
+    std::vector<std::array<size_t, RADIX_BUCKETS>> positions(chunks.size());
+    for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+      size_t position = bucketStart[bucket];
+
+      for (int chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+        positions[chunkIndex][bucket] = position;
+        position += histograms[chunkIndex][bucket];
+      }
+    }
+
+    KeysVector buffer(range.end - range.begin);
+
+    QtConcurrent::blockingMap(chunkIndexes, [this, &chunks, &positions, &buffer,
+                                             range, depth](int chunkIndex) {
+      auto &position = positions[chunkIndex];
+      const Range &chunk = chunks.at(chunkIndex);
+
+      for (size_t index = chunk.begin; index < chunk.end; ++index) {
+        int bucket = radixBucket(m_keys[index], depth);
+        buffer[position[bucket]++ - range.begin] = std::move(m_keys[index]);
+      }
+    });
+
+    std::move(buffer.begin(), buffer.end(), m_keys.begin() + range.begin);
+
+    return buckets;
+  }
+
+  void mergeSort(Range range) {
+    auto chunks = splitRange(range, m_threads);
+
+    QtConcurrent::blockingMap(chunks, [this](const Range &chunk) {
+      if (canceled()) return;
+      std::sort(m_keys.begin() + chunk.begin, m_keys.begin() + chunk.end);
+    });
+
+    while (chunks.size() > 1 && !canceled()) {
+      QList<QPair<Range, Range>> pairs;
+      QList<Range> merged;
+
+      for (int index = 0; index + 1 < chunks.size(); index += 2) {
+        pairs.append({chunks.at(index), chunks.at(index + 1)});
+        merged.append({chunks.at(index).begin, chunks.at(index + 1).end});
+      }
+
+      if (chunks.size() % 2 == 1) merged.append(chunks.last());
+
+      QtConcurrent::blockingMap(pairs, [this](const QPair<Range, Range> &pair) {
+        KeysVector buffer;
+        buffer.reserve(pair.second.end - pair.first.begin);
+
+        auto first = m_keys.begin();
+        std::merge(std::make_move_iterator(first + pair.first.begin),
+                   std::make_move_iterator(first + pair.first.end),
+                   std::make_move_iterator(first + pair.second.begin),
+                   std::make_move_iterator(first + pair.second.end),
+                   std::back_inserter(buffer));
+        std::move(buffer.begin(), buffer.end(), first + pair.first.begin);
+      });
+
+      chunks = merged;
+    }
+  }
+
+ private:
+  KeysVector &m_keys;
+  std::function<bool()> m_isCanceled;
+  size_t m_threads;
+};
+
+}  // namespace
+
+bool ConnectionsTree::sortKeys(RedisClient::Connection::RawKeysList &keys,
+                               std::function<bool()> isCanceled) {
+  if (static_cast<size_t>(keys.size()) < PARALLEL_SORT_THRESHOLD) {
+    std::sort(keys.begin(), keys.end());
+    return !(isCanceled && isCanceled());
+  }
+
+  KeysVector sortedKeys;
+  sortedKeys.reserve(keys.size());
+  std::move(keys.begin(), keys.end(), std::back_inserter(sortedKeys));
+  keys.clear();
+
+  bool result = ParallelKeysSorter(sortedKeys, isCanceled).sort();
+
+  keys.reserve(static_cast<int>(sortedKeys.size()));
+  std::move(sortedKeys.begin(), sortedKeys.end(), std::back_inserter(keys));
+
+  return result;
+}
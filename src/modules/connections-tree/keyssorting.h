@@ -0,0 +1,19 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include <functional>
+
+namespace ConnectionsTree {
+
+/*
+ * Sorts keys in byte order using threads of the global QThreadPool:
+ * MSD radix partitioning by leading bytes followed by parallel sorting
+ * of buckets. Buckets which cannot be split by radix partitioning are
+ * sorted in chunks and merged in parallel.
+ *
+ * Returns false if sorting was canceled, keys are left in unspecified order.
+ */
+bool sortKeys(RedisClient::Connection::RawKeysList& keys,
+              std::function<bool()> isCanceled = std::function<bool()>());
+
+}  // namespace ConnectionsTree
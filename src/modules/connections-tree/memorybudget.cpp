@@ -0,0 +1,62 @@
+#include "memorybudget.h"
+
+#include <QCoreApplication>
+#include <QSettings>
+#include <limits>
+
+using namespace ConnectionsTree;
+
+namespace {
+// Share of the budget which turns on the policy
+const double UNLOAD_COLLAPSED_KEYS_THRESHOLD = 0.7;
+const double NAMESPACES_SUMMARY_THRESHOLD = 0.85;
+const double STOP_LOADING_THRESHOLD = 1.0;
+
+const int DEFAULT_BUDGET_MB = 2048;
+}  // namespace
+
+MemoryBudget::MemoryBudget() {
+  QSettings settings;
+  m_limit = settings.value("app/treeMemoryBudget", DEFAULT_BUDGET_MB)
+                .toLongLong() *
+            1024 * 1024;
+}
+
+MemoryBudget::MemoryBudget(qint64 limit) : m_limit(limit) {}
+
+MemoryBudget::Policy MemoryBudget::policy(qint64 usedMemory) const {
+  if (!isEnabled()) return Policy::None;
+
+  double usage = static_cast<double>(usedMemory) / m_limit;
+
+  if (usage >= STOP_LOADING_THRESHOLD) return Policy::StopLoading;
+
+  if (usage >= NAMESPACES_SUMMARY_THRESHOLD) return Policy::NamespacesSummary;
+
+  if (usage >= UNLOAD_COLLAPSED_KEYS_THRESHOLD)
+    return Policy::UnloadCollapsedKeys;
+
+  return Policy::None;
+}
+
+qint64 MemoryBudget::available(qint64 usedMemory) const {
+  if (!isEnabled()) return std::numeric_limits<qint64>::max();
+
+  return qMax<qint64>(0, m_limit - usedMemory);
+}
+
+QString MemoryBudget::description(Policy policy) {
+  switch (policy) {
+    case Policy::UnloadCollapsedKeys:
+      return QCoreApplication::translate(
+          "RESP", "memory budget: keys of collapsed namespaces are unloaded");
+    case Policy::NamespacesSummary:
+      return QCoreApplication::translate(
+          "RESP", "memory budget: namespaced keys are counted on server");
+    case Policy::StopLoading:
+      return QCoreApplication::translate(
+          "RESP", "memory budget: keys loading is stopped");
+    default:
+      return QString();
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+
+namespace ConnectionsTree {
+
+/*
+ * Memory budget of the keys tree of one connection. Memory held by tree
+ * items, raw keys, keys index and live update snapshots is estimated by
+ * database items, budget picks the policy which keeps the tree below the
+ * configured limit instead of running out of memory during rendering.
+ */
+class MemoryBudget {
+ public:
+  // Policies are ordered by severity, each one includes previous ones
+  enum class Policy {
+    None,
+    // Rendered keys of collapsed namespaces are replaced with raw keys
+    UnloadCollapsedKeys,
+    // Keys are counted on the server instead of loading all key names
+    NamespacesSummary,
+    // Keys beyond the budget are not loaded
+    StopLoading,
+  };
+
+  // Estimated size of tree items, key names are counted separately.
+  // Rendered keys are flyweight rows, KeyItem objects are created only for
+  // rows accessed by the view.
+  static const qint64 KEY_ROW_BYTES = 24;
+  static const qint64 NAMESPACE_ITEM_BYTES = 400;
+
+ public:
+  // Uses app/treeMemoryBudget setting (in MB), 0 disables the budget
+  MemoryBudget();
+
+  explicit MemoryBudget(qint64 limit);
+
+  qint64 limit() const { return m_limit; }
+
+  bool isEnabled() const { return m_limit > 0; }
+
+  Policy policy(qint64 usedMemory) const;
+
+  // Memory left before keys loading is stopped
+  qint64 available(qint64 usedMemory) const;
+
+  static QString description(Policy policy);
+
+ private:
+  qint64 m_limit;
+};
+
+}  // namespace ConnectionsTree
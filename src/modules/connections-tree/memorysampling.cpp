@@ -0,0 +1,91 @@
+#include "memorysampling.h"
+
+#include <QRandomGenerator>
+#include <QtMath>
+
+using namespace ConnectionsTree;
+
+namespace {
+// z-score for 95% confidence level
+const double Z_SCORE = 1.96;
+
+// Expected coefficient of variation of key sizes
+const double EXPECTED_VARIATION = 1.0;
+}  // namespace
+
+int MemorySampling::sampleSize(int population, double relativeError) {
+  if (population <= 0) return 0;
+
+  double n0 = qPow(Z_SCORE * EXPECTED_VARIATION / relativeError, 2);
+  double n = n0 / (1.0 + (n0 - 1.0) / population);
+
+  int size = qCeil(n);
+
+  // Sampling doesn't pay off for small sets
+  if (size * 2 >= population) return population;
+
+  return size;
+}
+
+RedisClient::Connection::RawKeysList MemorySampling::sample(
+    const RawKeys &keys, int size) {
+  RedisClient::Connection::RawKeysList result;
+
+  if (size <= 0 || keys.isEmpty()) return result;
+
+  if (size >= keys.size()) return keys.toList();
+
+  result.reserve(size);
+
+  double step = static_cast<double>(keys.size()) / size;
+  double next = QRandomGenerator::global()->generateDouble() * step;
+  int index = 0;
+
+  keys.forEach([&result, &index, &next, step, size](const QByteArray &key) {
+    if (result.size() < size && index == static_cast<int>(next)) {
+      // Deep copy, key bytes are owned by the storage
+      result.append(QByteArray(key.constData(), key.size()));
+      next += step;
+    }
+    index++;
+  });
+
+  return result;
+}
+
+MemorySampling::Estimate MemorySampling::estimate(
+    const QVector<qlonglong> &sample, int population) {
+  int n = sample.size();
+
+  if (n == 0) return {0, 0};
+
+  double sum = 0;
+  for (auto value : sample) sum += value;
+
+  double mean = sum / n;
+
+  if (n >= population) return {static_cast<qlonglong>(sum), 0};
+
+  double variance = 0;
+  for (auto value : sample) variance += qPow(value - mean, 2);
+  variance = n > 1 ? variance / (n - 1) : 0;
+
+  double fpc = population > 1
+                   ? qSqrt(static_cast<double>(population - n) /
+                           (population - 1))
+                   : 0;
+
+  double margin = Z_SCORE * population * qSqrt(variance / n) * fpc;
+
+  return {qRound64(mean * population), qRound64(margin)};
+}
+
+qlonglong MemorySampling::combineMargins(const QVector<qlonglong> &margins) {
+  double sum = 0;
+
+  for (auto margin : margins) {
+    sum += static_cast<double>(margin) * margin;
+  }
+
+  return qRound64(qSqrt(sum));
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include <QVector>
+
+#include "rawkeys.h"
+
+namespace ConnectionsTree {
+
+/*
+ * Estimates memory used by a big set of keys from a sample of keys.
+ * Sample size is chosen for the target relative margin of error assuming
+ * that standard deviation of key sizes is close to their mean. Margin of
+ * the estimate is calculated from the sample variance with finite
+ * population correction.
+ */
+class MemorySampling {
+ public:
+  struct Estimate {
+    qlonglong total;
+    qlonglong margin;
+  };
+
+  // Sample size for 95% confidence level, returns population if the sample
+  // wouldn't be much smaller than the whole set
+  static int sampleSize(int population, double relativeError = 0.05);
+
+  // Systematic sample with random start: keys of all namespaces are
+  // represented proportionally because keys are sorted
+  static RedisClient::Connection::RawKeysList sample(const RawKeys& keys,
+                                                     int size);
+
+  static Estimate estimate(const QVector<qlonglong>& sample, int population);
+
+  // Margin of sum of independent estimates
+  static qlonglong combineMargins(const QVector<qlonglong>& margins);
+};
+
+}  // namespace ConnectionsTree
@@ -10,19 +10,29 @@
 using namespace ConnectionsTree;
 
 Model::Model(QObject *parent)
-    : QAbstractItemModel(parent),
-      m_rawPointers(new QHash<TreeItem *, QWeakPointer<TreeItem>>())
+    : QAbstractItemModel(parent)
 {
   qRegisterMetaType<QWeakPointer<TreeItem>>("QWeakPointer<TreeItem>");
   QObject::connect(this, &Model::itemChanged, this, &Model::onItemChanged);
 }
 
+Model::~Model() {
+  // Destroyed items release their handles
+  m_pendingChanges.clear();
+  m_treeItems.clear();
+}
+
 QVariant Model::data(const QModelIndex &index, int role) const {
-  const TreeItem *item = getItemFromIndex(index);
+  TreeItem *item = getItemFromIndex(index);
 
   if (item == nullptr) return QVariant();
 
-  if (role == itemMetaData) return item->metadata();
+  if (role == itemMetaData) {
+    // Views ask data only for visible rows
+    if (item->type() == "key") m_keysMetadata.request(item->getSelf().toStrongRef());
+
+    return item->metadata();
+  }
 
   return QVariant();
 }
@@ -60,8 +70,7 @@ QModelIndex Model::index(int row, int column, const QModelIndex &parent) const {
 
   if (!childItem) return QModelIndex();
 
-  m_rawPointers->insert(childItem.data(), childItem.toWeakRef());
-  return createIndex(row, column, childItem.data());
+  return createIndex(row, column, m_handles.acquire(childItem));
 }
 
 QModelIndex Model::parent(const QModelIndex &index) const {
@@ -77,9 +86,8 @@ QModelIndex Model::parent(const QModelIndex &index) const {
 
   if (!parentStrongRef) return QModelIndex();
 
-  m_rawPointers->insert(parentStrongRef.data(), parentItem);
   return createIndex(parentStrongRef->row(), 0,
-                     parentStrongRef.data());
+                     m_handles.acquire(parentStrongRef));
 }
 
 int Model::rowCount(const QModelIndex &parent) const {
@@ -115,8 +123,7 @@ QModelIndex Model::getIndexFromItem(QWeakPointer<TreeItem> item) {
     return index(sRef->row(), 0, QModelIndex());
   }
 
-  m_rawPointers->insert(sRef.data(), item);
-  return createIndex(sRef->row(), 0, (void *)sRef.data());
+  return createIndex(sRef->row(), 0, m_handles.acquire(sRef));
 }
 
 void Model::onItemChanged(QWeakPointer<TreeItem> item) {
@@ -168,8 +175,8 @@ void Model::beforeChildLoaded(QWeakPointer<TreeItem> item, int count)
 
     if (!treeItem) return;
 
-    beginInsertRows(index, treeItem->getAllChilds().size(),
-                    treeItem->getAllChilds().size() + count - 1);
+    beginInsertRows(index, treeItem->childCount(),
+                    treeItem->childCount() + count - 1);
 }
 
 void Model::childLoaded(QWeakPointer<TreeItem> item)
@@ -6,6 +6,8 @@
 #include <QSharedPointer>
 #include <QVariant>
 
+#include "itemhandles.h"
+#include "keysmetadata.h"
 #include "items/sortabletreeitem.h"
 
 namespace ConnectionsTree {
@@ -23,6 +25,8 @@ class Model : public QAbstractItemModel {
  public:
   explicit Model(QObject *parent = 0);
 
+  ~Model() override;
+
   QVariant data(const QModelIndex &index, int role) const override;
 
   QHash<int, QByteArray> roleNames() const override;
@@ -46,18 +50,17 @@ class Model : public QAbstractItemModel {
     if (!index.isValid()) return nullptr;
     if (index.model() != this) return nullptr;
 
-    TreeItem *item = static_cast<TreeItem *>(index.internalPointer());
-    if (!item || !m_rawPointers->contains(item)) return nullptr;
-
-    if (!m_rawPointers->value(item)) {
-      m_rawPointers->remove(item);
-      return nullptr;
-    }
-    return item;
+    return m_handles.resolve(index.internalId());
   }
 
   QModelIndex getIndexFromItem(QWeakPointer<TreeItem>);
 
+  const TreeItemHandles &itemHandles() const { return m_handles; }
+
+  void releaseItemHandle(quintptr handle) { m_handles.release(handle); }
+
+  KeysMetadataPrefetcher &keysMetadata() { return m_keysMetadata; }
+
   QSet<QByteArray> expandedNamespaces;
 
  signals:
@@ -117,7 +120,8 @@ class Model : public QAbstractItemModel {
 
  protected:
   QList<QSharedPointer<TreeItem>> m_treeItems;
-  QSharedPointer<QHash<TreeItem *, QWeakPointer<TreeItem>>> m_rawPointers; 
+  mutable TreeItemHandles m_handles;
+  mutable KeysMetadataPrefetcher m_keysMetadata;
   QHash<QSharedPointer<TreeItem>, QList<PendingIndexChange>> m_pendingChanges;
 };
 }  // namespace ConnectionsTree
@@ -9,6 +9,7 @@
 #include <functional>
 
 #include "exception.h"
+#include "rawkeys.h"
 #include "modules/common/callbackwithowner.h"
 
 namespace Console {
@@ -41,13 +42,57 @@ class Operations {
    * @param dbIndex
    * @param filter
    * @param callback
+   * @param progress - optional, called with amount of keys scanned on each
+   * cluster node
    */
   using LoadNamespaceItemsCallback =
       CallbackWithOwner<TreeItem, const RedisClient::Connection::RawKeysList&,
                         const QString&>;
 
-  virtual void loadNamespaceItems(uint dbIndex, const QString& filter,
-                                  QSharedPointer<LoadNamespaceItemsCallback>) = 0;
+  using ScanProgressCallback =
+      CallbackWithOwner<TreeItem, const QString&, qlonglong, bool>;
+
+  virtual void loadNamespaceItems(
+      uint dbIndex, const QString& filter,
+      QSharedPointer<LoadNamespaceItemsCallback>,
+      QSharedPointer<ScanProgressCallback> progress =
+          QSharedPointer<ScanProgressCallback>()) = 0;
+
+  /**
+   * @brief loadNamespaceItemsIncrementally
+   * Keys are passed to the callback batch by batch while SCAN is running,
+   * last batch is marked as finished. Cancel returned future to stop SCAN.
+   * @param dbIndex
+   * @param filter
+   * @param callback
+   */
+  using LoadNamespaceItemsBatchCallback =
+      CallbackWithOwner<TreeItem, const RedisClient::Connection::RawKeysList&,
+                        const QString&, bool>;
+
+  virtual QFuture<void> loadNamespaceItemsIncrementally(
+      uint dbIndex, const QString& filter,
+      QSharedPointer<LoadNamespaceItemsBatchCallback>) = 0;
+
+  /**
+   * @brief loadNamespacesSummary
+   * Keys are aggregated on the server side: only keys placed directly in the
+   * loaded namespace are returned, nested namespaces up to the given depth
+   * are returned with keys counters.
+   * @param dbIndex
+   * @param filter
+   * @param prefixLength - length of the loaded namespace prefix
+   * @param depth - amount of aggregated namespace levels
+   * @param callback
+   */
+  using NamespacesSummary = QMap<QByteArray, qlonglong>;
+  using LoadNamespacesSummaryCallback =
+      CallbackWithOwner<TreeItem, const RedisClient::Connection::RawKeysList&,
+                        const NamespacesSummary&, const QString&>;
+
+  virtual QFuture<void> loadNamespacesSummary(
+      uint dbIndex, const QString& filter, int prefixLength, int depth,
+      QSharedPointer<LoadNamespacesSummaryCallback>) = 0;
 
   /**
    * Cancel all operations & close connection
@@ -125,10 +170,89 @@ class Operations {
   using GetUsedMemoryCallback = CallbackWithOwner<TreeItem, qlonglong>;
 
   virtual void getUsedMemory(
-      const QList<QByteArray>& keys, int dbIndex,
+      const RawKeys& keys, int dbIndex,
       QSharedPointer<GetUsedMemoryCallback> result,
       QSharedPointer<GetUsedMemoryCallback> progress) = 0;
 
+  /**
+   * @brief getKeysMemory
+   * Returns memory used by each key, keys are usually a sample used to
+   * estimate memory of a namespace
+   */
+  using GetKeysMemoryCallback =
+      CallbackWithOwner<TreeItem, const QVector<qlonglong>&>;
+
+  virtual void getKeysMemory(const RedisClient::Connection::RawKeysList& keys,
+                             int dbIndex,
+                             QSharedPointer<GetKeysMemoryCallback> result) = 0;
+
+  struct KeyMetadata {
+    QByteArray type;
+    qlonglong ttl = -1;
+    QByteArray encoding;
+    qlonglong usedMemory = 0;
+  };
+
+  /**
+   * @brief getKeysMetadata
+   * Loads TYPE, PTTL, OBJECT ENCODING and MEMORY USAGE of keys with one
+   * pipelined request
+   */
+  using GetKeysMetadataCallback =
+      CallbackWithOwner<TreeItem, const QList<KeyMetadata>&>;
+
+  virtual void getKeysMetadata(
+      const RedisClient::Connection::RawKeysList& keys, int dbIndex,
+      QSharedPointer<GetKeysMetadataCallback> result) = 0;
+
+  /**
+   * @brief keysCachePath
+   * Path of on-disk snapshot of database keys, empty if keys loaded with
+   * the filter are not cached
+   */
+  virtual QString keysCachePath(uint dbIndex, const QString& filter) = 0;
+
+  /**
+   * @brief invalidateScanResults
+   * Drops cached SCAN results of the database, next loading of keys scans
+   * the server
+   */
+  virtual void invalidateScanResults(uint dbIndex) = 0;
+
+  /**
+   * @brief scanResultsMemory
+   * Memory used by cached SCAN results of all databases, it's counted in
+   * the memory budget of the connection
+   */
+  virtual qint64 scanResultsMemory() = 0;
+
+  /**
+   * @brief enableKeyspaceEvents
+   * Checks that notify-keyspace-events allows to track created and removed
+   * keys, if changeConfig is true missing flags are set with CONFIG SET
+   */
+  using EnableKeyspaceEventsCallback =
+      CallbackWithOwner<TreeItem, bool, const QString&>;
+
+  virtual void enableKeyspaceEvents(
+      bool changeConfig, QSharedPointer<EnableKeyspaceEventsCallback>) = 0;
+
+  /**
+   * @brief subscribeToKeyspaceEvents
+   * Subscribes to keyspace notifications of keys matching the filter on a
+   * dedicated connection. Created and removed keys are passed to the
+   * callback in batches, error is passed once if subscription is lost.
+   * Cancel returned future to unsubscribe.
+   */
+  using KeyspaceEventsCallback =
+      CallbackWithOwner<TreeItem, const RedisClient::Connection::RawKeysList&,
+                        const RedisClient::Connection::RawKeysList&,
+                        const QString&>;
+
+  virtual QFuture<void> subscribeToKeyspaceEvents(
+      uint dbIndex, const QString& filter,
+      QSharedPointer<KeyspaceEventsCallback>) = 0;
+
   virtual ~Operations() {}
 };
 }  // namespace ConnectionsTree
@@ -0,0 +1,216 @@
+#include "rawkeys.h"
+
+#include <cstring>
+
+using namespace ConnectionsTree;
+
+namespace {
+// Keep arena buffers far below QByteArray size limit
+const qint64 MAX_ARENA_SIZE = 64 * 1024 * 1024;
+}  // namespace
+
+KeysArena::KeysArena(const RedisClient::Connection::RawKeysList &keys,
+                     int from, int to) {
+  int dataSize = 0;
+
+  for (int index = from; index < to; ++index) {
+    dataSize += keys.at(index).size();
+  }
+
+  m_data.reserve(dataSize);
+  m_offsets.reserve(to - from + 1);
+  m_offsets.append(0);
+
+  for (int index = from; index < to; ++index) {
+    m_data.append(keys.at(index));
+    m_offsets.append(m_data.size());
+  }
+}
+
+KeysArena::KeysArena(const char *data, const qint32 *offsets, int count) {
+  m_offsets.resize(count + 1);
+  memcpy(m_offsets.data(), offsets, (count + 1) * sizeof(qint32));
+
+  m_data = QByteArray(data, m_offsets.last());
+}
+
+qint64 KeysArena::usedMemory() const {
+  return m_data.capacity() + m_offsets.capacity() * sizeof(int);
+}
+
+RawKeys::RawKeys(const RedisClient::Connection::RawKeysList &keys)
+    : m_size(0) {
+  if (keys.isEmpty()) return;
+
+  appendSlice({QSharedPointer<const KeysArena>(), keys, 0, keys.size()});
+}
+
+RawKeys::RawKeys(QSharedPointer<const KeysArena> arena) : m_size(0) {
+  if (!arena) return;
+
+  appendSlice({arena, RedisClient::Connection::RawKeysList(), 0,
+               arena->size()});
+}
+
+RawKeys RawKeys::pack(const RedisClient::Connection::RawKeysList &keys) {
+  RawKeys result;
+
+  int from = 0;
+  qint64 arenaSize = 0;
+
+  for (int index = 0; index < keys.size(); ++index) {
+    arenaSize += keys.at(index).size();
+
+    if (arenaSize >= MAX_ARENA_SIZE || index == keys.size() - 1) {
+      auto arena = QSharedPointer<const KeysArena>(
+          new KeysArena(keys, from, index + 1));
+      result.appendSlice({arena, RedisClient::Connection::RawKeysList(), 0,
+                          arena->size()});
+      from = index + 1;
+      arenaSize = 0;
+    }
+  }
+
+  return result;
+}
+
+void RawKeys::clear() {
+  m_slices.clear();
+  m_size = 0;
+}
+
+void RawKeys::append(const QByteArray &key) {
+  if (!m_slices.isEmpty()) {
+    Slice &last = m_slices.last();
+
+    if (!last.arena && last.to == last.keys.size()) {
+      last.keys.append(key);
+      last.to++;
+      m_size++;
+      return;
+    }
+  }
+
+  appendSlice({QSharedPointer<const KeysArena>(),
+               RedisClient::Connection::RawKeysList{key}, 0, 1});
+}
+
+void RawKeys::append(const RawKeys &keys) {
+  for (const auto &slice : keys.m_slices) {
+    appendSlice(slice);
+  }
+}
+
+RawKeys RawKeys::mid(int pos, int length) const {
+  RawKeys result;
+
+  if (length < 0 || pos + length > m_size) length = m_size - pos;
+
+  int sliceStart = 0;
+
+  for (const auto &slice : m_slices) {
+    if (length <= 0) break;
+
+    int sliceSize = slice.to - slice.from;
+
+    if (pos < sliceStart + sliceSize) {
+      int from = slice.from + qMax(0, pos - sliceStart);
+      int to = qMin(slice.to, from + length);
+
+      result.appendSlice({slice.arena, slice.keys, from, to});
+
+      length -= to - from;
+      pos = sliceStart + sliceSize;
+    }
+
+    sliceStart += sliceSize;
+  }
+
+  return result;
+}
+
+int RawKeys::countWithPrefix(int pos, const QByteArray &prefix) const {
+  int result = 0;
+  int sliceStart = 0;
+
+  for (const auto &slice : m_slices) {
+    int sliceSize = slice.to - slice.from;
+
+    if (pos >= sliceStart + sliceSize) {
+      sliceStart += sliceSize;
+      continue;
+    }
+
+    for (int index = slice.from + qMax(0, pos - sliceStart); index < slice.to;
+         ++index) {
+      QByteArray key =
+          slice.arena ? slice.arena->rawAt(index) : slice.keys.at(index);
+
+      if (!key.startsWith(prefix)) return result;
+
+      result++;
+    }
+
+    sliceStart += sliceSize;
+  }
+
+  return result;
+}
+
+RedisClient::Connection::RawKeysList RawKeys::toList() const {
+  if (m_slices.size() == 1 && !m_slices.first().arena &&
+      m_slices.first().from == 0 &&
+      m_slices.first().to == m_slices.first().keys.size()) {
+    return m_slices.first().keys;
+  }
+
+  RedisClient::Connection::RawKeysList result;
+  result.reserve(m_size);
+
+  for (const auto &slice : m_slices) {
+    for (int index = slice.from; index < slice.to; ++index) {
+      if (slice.arena) {
+        result.append(slice.arena->at(index));
+      } else {
+        result.append(slice.keys.at(index));
+      }
+    }
+  }
+
+  return result;
+}
+
+qint64 RawKeys::usedMemory() const {
+  qint64 result = 0;
+
+  for (const auto &slice : m_slices) {
+    if (slice.arena) {
+      result += slice.arena->usedMemory() * (slice.to - slice.from) /
+                qMax(1, slice.arena->size());
+    } else {
+      for (int index = slice.from; index < slice.to; ++index) {
+        result += slice.keys.at(index).capacity() + sizeof(QByteArray);
+      }
+    }
+  }
+
+  return result;
+}
+
+void RawKeys::appendSlice(const Slice &slice) {
+  if (slice.to <= slice.from) return;
+
+  m_size += slice.to - slice.from;
+
+  if (!m_slices.isEmpty()) {
+    Slice &last = m_slices.last();
+
+    // Merge adjacent slices of the same arena
+    if (last.arena && last.arena == slice.arena && last.to == slice.from) {
+      last.to = slice.to;
+      return;
+    }
+  }
+
+  m_slices.append(slice);
+}
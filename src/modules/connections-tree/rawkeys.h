@@ -0,0 +1,115 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace ConnectionsTree {
+
+/*
+ * Immutable storage for a block of keys: key bytes are packed into one
+ * contiguous buffer and addressed by the offsets array.
+ */
+class KeysArena {
+ public:
+  KeysArena(const RedisClient::Connection::RawKeysList& keys, int from, int to);
+
+  // Copies count keys stored as offsets and packed key bytes
+  KeysArena(const char* data, const qint32* offsets, int count);
+
+  int size() const { return m_offsets.size() - 1; }
+
+  const char* keyData(int index) const {
+    return m_data.constData() + m_offsets.at(index);
+  }
+
+  int keySize(int index) const {
+    return m_offsets.at(index + 1) - m_offsets.at(index);
+  }
+
+  // NOTE: returned value doesn't own data and is valid while arena is alive
+  QByteArray rawAt(int index) const {
+    return QByteArray::fromRawData(keyData(index), keySize(index));
+  }
+
+  QByteArray at(int index) const {
+    return QByteArray(keyData(index), keySize(index));
+  }
+
+  qint64 usedMemory() const;
+
+ private:
+  QByteArray m_data;
+  QVector<int> m_offsets;
+};
+
+/*
+ * Ordered list of keys stored as slices of shared arenas. Copies and
+ * sub-ranges share key bytes, keys appended one by one are kept in a plain
+ * list until the storage is packed.
+ */
+class RawKeys {
+ public:
+  RawKeys() : m_size(0) {}
+
+  RawKeys(const RedisClient::Connection::RawKeysList& keys);
+
+  explicit RawKeys(QSharedPointer<const KeysArena> arena);
+
+  static RawKeys pack(const RedisClient::Connection::RawKeysList& keys);
+
+  int size() const { return m_size; }
+
+  bool isEmpty() const { return m_size == 0; }
+
+  bool empty() const { return isEmpty(); }
+
+  void clear();
+
+  void append(const QByteArray& key);
+
+  void append(const RawKeys& keys);
+
+  RawKeys mid(int pos, int length = -1) const;
+
+  // Number of consecutive keys starting from pos which have the prefix
+  int countWithPrefix(int pos, const QByteArray& prefix) const;
+
+  RedisClient::Connection::RawKeysList toList() const;
+
+  qint64 usedMemory() const;
+
+  /*
+   * Iterates over keys without copying key bytes. QByteArray passed to the
+   * callback is only valid inside of the callback.
+   */
+  template <typename Callback>
+  void forEach(Callback callback) const {
+    for (const auto& slice : m_slices) {
+      for (int index = slice.from; index < slice.to; ++index) {
+        if (slice.arena) {
+          callback(slice.arena->rawAt(index));
+        } else {
+          callback(slice.keys.at(index));
+        }
+      }
+    }
+  }
+
+ private:
+  struct Slice {
+    QSharedPointer<const KeysArena> arena;
+    RedisClient::Connection::RawKeysList keys;
+    int from;
+    int to;
+  };
+
+  void appendSlice(const Slice& slice);
+
+ private:
+  QVector<Slice> m_slices;
+  int m_size;
+};
+
+}  // namespace ConnectionsTree
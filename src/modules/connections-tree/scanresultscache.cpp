@@ -0,0 +1,149 @@
+#include "scanresultscache.h"
+
+#include <QMutexLocker>
+
+using namespace ConnectionsTree;
+
+ScanResultsCache::ScanResultsCache(qint64 maxMemory, qint64 maxAge)
+    : m_maxMemory(maxMemory), m_maxAge(maxAge) {}
+
+void ScanResultsCache::insert(uint dbIndex, const QString& pattern,
+                              const RedisClient::Connection::RawKeysList& keys,
+                              int priority) {
+  Entry entry{dbIndex, pattern, RawKeys::pack(keys), QElapsedTimer(),
+              priority};
+  entry.age.start();
+
+  if (entry.keys.usedMemory() > m_maxMemory) return;
+
+  GlobMatcher matcher(pattern.toUtf8());
+
+  QMutexLocker locker(&m_mutex);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->dbIndex == dbIndex &&
+        GlobMatcher(it->pattern.toUtf8()).isSubsetOf(matcher)) {
+      it = m_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  m_entries.append(entry);
+
+  removeExpired();
+  evict();
+}
+
+bool ScanResultsCache::contains(uint dbIndex, const QString& pattern) {
+  GlobMatcher matcher(pattern.toUtf8());
+
+  QMutexLocker locker(&m_mutex);
+  return findCovering(dbIndex, matcher) != nullptr;
+}
+
+bool ScanResultsCache::lookup(uint dbIndex, const QString& pattern,
+                              RedisClient::Connection::RawKeysList& keys) {
+  GlobMatcher matcher(pattern.toUtf8());
+  RawKeys cachedKeys;
+  bool exactPattern = false;
+
+  {
+    QMutexLocker locker(&m_mutex);
+
+    auto entry = findCovering(dbIndex, matcher);
+
+    if (!entry) return false;
+
+    // Packed keys are implicitly shared, filtering doesn't block the cache
+    cachedKeys = entry->keys;
+    exactPattern = entry->pattern == pattern;
+  }
+
+  keys = exactPattern ? cachedKeys.toList() : matcher.filter(cachedKeys);
+  return true;
+}
+
+void ScanResultsCache::invalidate(uint dbIndex) {
+  QMutexLocker locker(&m_mutex);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->dbIndex == dbIndex) {
+      it = m_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ScanResultsCache::clear() {
+  QMutexLocker locker(&m_mutex);
+  m_entries.clear();
+}
+
+qint64 ScanResultsCache::usedMemory() const {
+  QMutexLocker locker(&m_mutex);
+
+  qint64 result = 0;
+
+  for (const auto& entry : m_entries) {
+    result += entry.keys.usedMemory();
+  }
+
+  return result;
+}
+
+const ScanResultsCache::Entry* ScanResultsCache::findCovering(
+    uint dbIndex, const GlobMatcher& matcher) {
+  removeExpired();
+
+  const Entry* result = nullptr;
+
+  // The smallest result covering the pattern is filtered
+  for (const auto& entry : qAsConst(m_entries)) {
+    if (entry.dbIndex != dbIndex ||
+        !matcher.isSubsetOf(GlobMatcher(entry.pattern.toUtf8())))
+      continue;
+
+    if (!result || entry.keys.size() < result->keys.size()) result = &entry;
+  }
+
+  return result;
+}
+
+void ScanResultsCache::removeExpired() {
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->age.hasExpired(m_maxAge)) {
+      it = m_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ScanResultsCache::evict() {
+  qint64 used = 0;
+
+  for (const auto& entry : qAsConst(m_entries)) {
+    used += entry.keys.usedMemory();
+  }
+
+  while (used > m_maxMemory && !m_entries.isEmpty()) {
+    // Results of rarely used filters go first, then the oldest ones
+    int victim = 0;
+
+    for (int i = 1; i < m_entries.size(); i++) {
+      const auto& entry = m_entries.at(i);
+      const auto& current = m_entries.at(victim);
+
+      if (entry.priority < current.priority ||
+          (entry.priority == current.priority &&
+           entry.age.elapsed() > current.age.elapsed())) {
+        victim = i;
+      }
+    }
+
+    used -= m_entries.at(victim).keys.usedMemory();
+    m_entries.removeAt(victim);
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <qredisclient/connection.h>
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include "globmatcher.h"
+#include "rawkeys.h"
+
+namespace ConnectionsTree {
+
+/*
+ * Keys returned by SCAN with MATCH pattern for each database. Keys of a
+ * pattern which is a subset of a cached pattern are filtered from the cached
+ * result instead of scanning the server again.
+ *
+ * Results expire after maxAge, when the cache exceeds maxMemory results of
+ * rarely used filters are evicted first.
+ */
+class ScanResultsCache {
+ public:
+  static const qint64 DEFAULT_MAX_MEMORY = 256 * 1024 * 1024;
+  static const qint64 DEFAULT_MAX_AGE = 60000;
+
+ public:
+  ScanResultsCache(qint64 maxMemory = DEFAULT_MAX_MEMORY,
+                   qint64 maxAge = DEFAULT_MAX_AGE);
+
+  // Results of patterns covered by the new pattern are replaced.
+  // Priority is the usage count of the filter.
+  void insert(uint dbIndex, const QString& pattern,
+              const RedisClient::Connection::RawKeysList& keys,
+              int priority = 0);
+
+  // Fresh result covering the pattern is cached
+  bool contains(uint dbIndex, const QString& pattern);
+
+  // Returns false if there is no fresh result covering the pattern
+  // NOTE: thread-safe, keys are filtered in the calling thread
+  bool lookup(uint dbIndex, const QString& pattern,
+              RedisClient::Connection::RawKeysList& keys);
+
+  void invalidate(uint dbIndex);
+
+  void clear();
+
+  qint64 usedMemory() const;
+
+ private:
+  struct Entry {
+    uint dbIndex;
+    QString pattern;
+    RawKeys keys;
+    QElapsedTimer age;
+    int priority;
+  };
+
+  // NOTE: must be called with locked mutex
+  const Entry* findCovering(uint dbIndex, const GlobMatcher& matcher);
+
+  void removeExpired();
+  void evict();
+
+ private:
+  mutable QMutex m_mutex;
+  QList<Entry> m_entries;
+  qint64 m_maxMemory;
+  qint64 m_maxAge;
+};
+
+}  // namespace ConnectionsTree
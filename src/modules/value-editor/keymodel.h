@@ -16,6 +16,8 @@ class ModelSignals : public QObject {
  signals:
   void removed();
   void error(const QString&);
+  // Batch of MATCH filter scan is loaded, progress is in range [0, 1]
+  void matchesLoaded(double progress);
 };
 
 class Model : public QEnableSharedFromThis<Model> {
@@ -52,8 +54,12 @@ class Model : public QEnableSharedFromThis<Model> {
                         LoadRowsCallback c) = 0;  // async
 
   virtual void clearRowCache() = 0;
+  virtual qint64 rowsCacheMemory() = 0;
+  virtual qint64 rowsCacheMemoryLimit() = 0;  // 0 - unlimited
   virtual void removeRow(int, Callback) = 0;  // async
   virtual bool isRowLoaded(int) = 0;
+  // Model of a value which is loaded on demand, nullptr for loaded values
+  virtual QObject* getStreamedValue(int rowIndex) = 0;
   virtual bool isMultiRow() const = 0;
   virtual void loadRowsCount(Callback callback) = 0;
 
@@ -0,0 +1,217 @@
+#include "pagedtextmodel.h"
+#include <qredisclient/utils/text.h>
+#include <QDebug>
+#include <QPointer>
+#include <QRegExp>
+#include <QTimer>
+
+namespace {
+// Search position is encoded as row * SEARCH_ROW_STRIDE + position in row
+const qint64 SEARCH_ROW_STRIDE = Q_INT64_C(1) << 32;
+
+// Matches crossing the window border are found in the window they start
+const int SEARCH_OVERLAP = 1000;
+
+// Windows are loaded with continuation bytes of a UTF-8 character which
+// crosses the end border, the character is shown in the window it starts
+const int UTF8_TAIL_BYTES = 3;
+
+bool isUtf8Continuation(char c) {
+  return (static_cast<uchar>(c) & 0xC0) == 0x80;
+}
+}  // namespace
+
+ValueEditor::PagedTextModel::PagedTextModel(qint64 size, Loader loader,
+                                            uint chunkSize, int maxWindows)
+    : m_size(size),
+      m_loader(loader),
+      m_chunkSize(chunkSize),
+      m_maxWindows(qMax(maxWindows, 2)),
+      m_hex(false),
+      m_clock(0),
+      m_searchRegex(false),
+      m_searchGeneration(0) {}
+
+QHash<int, QByteArray> ValueEditor::PagedTextModel::roleNames() const {
+  QHash<int, QByteArray> roles;
+  roles[Qt::UserRole + 1] = "value";
+  return roles;
+}
+
+int ValueEditor::PagedTextModel::rowCount(const QModelIndex &) const {
+  return static_cast<int>((m_size + m_chunkSize - 1) / m_chunkSize);
+}
+
+QVariant ValueEditor::PagedTextModel::data(const QModelIndex &index,
+                                           int role) const {
+  if (!index.isValid() || index.row() >= rowCount() ||
+      role != Qt::UserRole + 1)
+    return QVariant();
+
+  int row = index.row();
+
+  if (m_windows.contains(row)) {
+    m_windows[row].lastAccess = ++m_clock;
+    return windowText(row);
+  }
+
+  if (!m_loadingWindows.contains(row)) {
+    auto self = const_cast<PagedTextModel *>(this);
+
+    m_loadingWindows.insert(row);
+
+    // Window is shown once it's loaded
+    self->loadWindow(row, [self, row](const QString &err) {
+      self->m_loadingWindows.remove(row);
+
+      if (!err.isEmpty()) emit self->error(err);
+    });
+  }
+
+  return QString();
+}
+
+qint64 ValueEditor::PagedTextModel::size() const { return m_size; }
+
+bool ValueEditor::PagedTextModel::hex() const { return m_hex; }
+
+void ValueEditor::PagedTextModel::setHex(bool v) {
+  if (m_hex == v) return;
+
+  m_hex = v;
+  emit hexChanged();
+
+  if (rowCount() > 0) emit dataChanged(index(0), index(rowCount() - 1));
+}
+
+void ValueEditor::PagedTextModel::cleanUp() {
+  beginResetModel();
+  m_windows.clear();
+  m_searchGeneration++;
+  endResetModel();
+}
+
+void ValueEditor::PagedTextModel::setTextChunk(uint, QString) {}
+
+void ValueEditor::PagedTextModel::searchText(QString p, qint64 from,
+                                             bool regex) {
+  if (from < 0) {
+    from = 0;
+  }
+
+  qDebug() << "Search params:" << p << from << regex;
+
+  m_searchPattern = p;
+  m_searchRegex = regex;
+
+  searchFromRow(from / SEARCH_ROW_STRIDE, from % SEARCH_ROW_STRIDE,
+                ++m_searchGeneration);
+}
+
+void ValueEditor::PagedTextModel::loadWindow(
+    int row, std::function<void(const QString &)> callback) {
+  if (m_windows.contains(row)) return callback(QString());
+
+  qint64 offset = static_cast<qint64>(row) * m_chunkSize;
+  QPointer<PagedTextModel> self(this);
+
+  m_loader(offset, qMin<qint64>(m_chunkSize + UTF8_TAIL_BYTES, m_size - offset),
+           [self, row, callback](const QString &err, const QByteArray &window) {
+             if (!self) return;
+
+             if (err.isEmpty()) self->storeWindow(row, window);
+
+             callback(err);
+           });
+}
+
+void ValueEditor::PagedTextModel::storeWindow(int row, const QByteArray &data) {
+  m_windows.insert(row, Window{data, ++m_clock});
+
+  while (m_windows.size() > m_maxWindows) {
+    auto oldest = m_windows.begin();
+
+    for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+      if (it.value().lastAccess < oldest.value().lastAccess) oldest = it;
+    }
+
+    m_windows.erase(oldest);
+  }
+
+  emit dataChanged(index(row), index(row));
+}
+
+QString ValueEditor::PagedTextModel::windowText(int row) const {
+  QByteArray data = m_windows.value(row).data;
+  int end = qMin<int>(m_chunkSize, data.size());
+
+  if (m_hex) return printableString(data.left(end));
+
+  // Leading continuation bytes are shown by the previous window
+  int begin = 0;
+
+  while (row > 0 && begin < qMin(UTF8_TAIL_BYTES, end) &&
+         isUtf8Continuation(data.at(begin)))
+    begin++;
+
+  while (end < data.size() && isUtf8Continuation(data.at(end))) end++;
+
+  return QString::fromUtf8(data.constData() + begin, end - begin);
+}
+
+void ValueEditor::PagedTextModel::searchFromRow(int row, int from,
+                                                int generation) {
+  if (generation != m_searchGeneration) return;
+
+  if (row >= rowCount()) {
+    emit searchFinished(QVariantList{-1, -1, -1, -1});
+    return;
+  }
+
+  auto search = [this, row, from, generation]() {
+    if (generation != m_searchGeneration) return;
+
+    QString text = windowText(row);
+    int rowLength = text.size();
+
+    if (m_windows.contains(row + 1))
+      text.append(windowText(row + 1).left(SEARCH_OVERLAP));
+
+    int res;
+    int length = 0;
+
+    if (m_searchRegex) {
+      auto rx = QRegExp(m_searchPattern);
+      res = text.indexOf(rx, from);
+      length = rx.matchedLength();
+    } else {
+      res = text.indexOf(m_searchPattern, from, Qt::CaseInsensitive);
+      length = m_searchPattern.size();
+    }
+
+    if (0 <= res && res < rowLength) {
+      emit searchFinished(QVariantList{
+          row, static_cast<qint64>(row) * SEARCH_ROW_STRIDE + res, res,
+          length});
+      return;
+    }
+
+    // Next window is searched in the next event loop iteration, so windows
+    // which are loaded already don't grow the stack
+    QTimer::singleShot(0, this, [this, row, generation]() {
+      searchFromRow(row + 1, 0, generation);
+    });
+  };
+
+  loadWindow(row, [this, row, search](const QString &err) {
+    if (!err.isEmpty()) {
+      emit error(err);
+      emit searchFinished(QVariantList{-1, -1, -1, -1});
+      return;
+    }
+
+    if (row + 1 >= rowCount()) return search();
+
+    loadWindow(row + 1, [search](const QString &) { search(); });
+  });
+}
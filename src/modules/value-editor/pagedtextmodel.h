@@ -0,0 +1,87 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVariantList>
+#include <functional>
+
+namespace ValueEditor {
+
+/*
+ * Read-only text of a value which is too large to be loaded at once. Each
+ * row is a window of chunkSize bytes, windows are requested from the loader
+ * when the view shows them. Only maxWindows recently used windows are kept
+ * in memory.
+ */
+class PagedTextModel : public QAbstractListModel {
+  Q_OBJECT
+
+  Q_PROPERTY(qint64 size READ size CONSTANT)
+  Q_PROPERTY(bool hex READ hex WRITE setHex NOTIFY hexChanged)
+
+ public:
+  typedef std::function<void(const QString& err, const QByteArray& window)>
+      WindowCallback;
+  typedef std::function<void(qint64 offset, qint64 size, WindowCallback)>
+      Loader;
+
+  PagedTextModel(qint64 size, Loader loader, uint chunkSize = 50000,
+                 int maxWindows = 20);
+
+  QHash<int, QByteArray> roleNames() const override;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  QVariant data(const QModelIndex& index, int role) const override;
+
+  qint64 size() const;
+
+  bool hex() const;
+  void setHex(bool v);
+
+ signals:
+  void hexChanged();
+  void searchFinished(QVariantList result);
+  void error(const QString& err);
+
+ public slots:
+  void cleanUp();
+
+  // NOTE: Streamed value is read-only
+  void setTextChunk(uint row, QString text);
+
+  // Windows are searched one by one, result is returned with
+  // searchFinished() in the format of LargeTextWrappingModel::searchText()
+  void searchText(QString p, qint64 from = 0, bool regex = false);
+
+ private:
+  struct Window {
+    QByteArray data;
+    quint64 lastAccess;
+  };
+
+  void loadWindow(int row, std::function<void(const QString&)> callback);
+
+  void storeWindow(int row, const QByteArray& data);
+
+  QString windowText(int row) const;
+
+  void searchFromRow(int row, int from, int generation);
+
+ private:
+  qint64 m_size;
+  Loader m_loader;
+  uint m_chunkSize;
+  int m_maxWindows;
+  bool m_hex;
+  mutable QHash<int, Window> m_windows;
+  mutable QSet<int> m_loadingWindows;
+  mutable quint64 m_clock;
+  QString m_searchPattern;
+  bool m_searchRegex;
+  int m_searchGeneration;
+};
+
+}  // namespace ValueEditor
@@ -5,6 +5,11 @@
 #include <QQmlEngine>
 #include <QSettings>
 
+namespace {
+// Pages loaded ahead of the frame shown by the view
+const int PREFETCH_PAGES = 2;
+}  // namespace
+
 ValueEditor::ValueViewModel::ValueViewModel(const QString& loadingTitle)
     : BaseListModel(),
       m_model(nullptr),
@@ -12,7 +17,12 @@ ValueEditor::ValueViewModel::ValueViewModel(const QString& loadingTitle)
       m_startFramePosition(0),
       m_lastLoadedRowFrameSize(0),
       m_singlePageMode(false),
-      m_tabTitle(loadingTitle)
+      m_tabTitle(loadingTitle),
+      m_prefetchDirection(1),
+      m_prefetchGeneration(0),
+      m_pageMemory(0),
+      m_pendingFrame(-1, 0),
+      m_matchProgress(1.0)
 {}
 
 int ValueEditor::ValueViewModel::rowCount(const QModelIndex& parent) const {
@@ -73,6 +83,12 @@ QSharedPointer<ValueEditor::Model> ValueEditor::ValueViewModel::model() {
 
 void ValueEditor::ValueViewModel::setModel(QSharedPointer<Model> model) {
   m_model = model;
+
+  if (m_model) {
+    connect(m_model->getConnector().data(), &ModelSignals::matchesLoaded,
+            this, &ValueViewModel::onMatchesLoaded);
+  }
+
   emit modelLoaded();
 }
 
@@ -170,8 +186,19 @@ void ValueEditor::ValueViewModel::reload() {
   }
 
   m_model->clearRowCache();
+  m_prefetchGeneration++;
+  emit rowsCacheMemoryChanged();
+
+  if (!m_model->filter("match").toString().isEmpty()) {
+    m_matchProgress = 0;
+    emit matchProgressChanged();
+  }
+
   m_model->loadRowsCount([this](const QString& err) {
-    if (err.size() > 0 || m_model->rowsCount() <= 0) {
+    // Nothing matched by MATCH filter is a valid result
+    bool isMatchFiltered = !m_model->filter("match").toString().isEmpty();
+
+    if (err.size() > 0 || (m_model->rowsCount() <= 0 && !isMatchFiltered)) {
       emit error(
           QCoreApplication::translate("RESP", "Cannot reload key value: %1")
               .arg(err));
@@ -214,22 +241,45 @@ void ValueEditor::ValueViewModel::loadRows(int start, int limit) {
   int rowsLeft = totalRowCount() - start;
   int loaded = (rowsLeft > limit) ? limit : rowsLeft;
 
+  updatePrefetchDirection(start);
+
+  // e.g. nothing matched by MATCH filter yet
+  if (loaded <= 0) {
+    m_startFramePosition = start;
+    m_lastLoadedRowFrameSize = 0;
+
+    emit layoutAboutToBeChanged();
+    emit rowsLoaded(start, 0);
+    emit layoutChanged();
+    return;
+  }
+
   // frame already loaded
-  if (m_model->isRowLoaded(start) && m_model->isRowLoaded(start + loaded - 1)) {
+  if (isFrameLoaded(start, start + loaded - 1)) {
     m_startFramePosition = start;
     m_lastLoadedRowFrameSize = loaded;
 
     emit layoutAboutToBeChanged();
     emit rowsLoaded(start, loaded);
     emit layoutChanged();
+
+    prefetchRows(start, limit);
+    return;
+  }
+
+  // Frame is loaded by prefetch already, it's shown once loading is finished
+  if (m_prefetchingFrames.contains(start)) {
+    m_pendingFrame = qMakePair(start, limit);
     return;
   }
 
   QString msg = QCoreApplication::translate("RESP", "Cannot load key value: %1");
+  qint64 memoryBefore = m_model->rowsCacheMemory();
 
   m_model->loadRows(
       start, limit,
-      [this, start, limit, msg](const QString& err, unsigned long rowsCount) {
+      [this, start, limit, msg, memoryBefore](const QString& err,
+                                              unsigned long rowsCount) {
         if (!err.isEmpty()) {
           emit error(msg.arg(err));
           return;
@@ -238,9 +288,99 @@ void ValueEditor::ValueViewModel::loadRows(int start, int limit) {
         m_lastLoadedRowFrameSize = rowsCount > limit ? limit : rowsCount;
         m_startFramePosition = start;
 
+        qint64 pageMemory = m_model->rowsCacheMemory() - memoryBefore;
+        if (pageMemory > 0) m_pageMemory = pageMemory;
+
         emit layoutAboutToBeChanged();
         emit rowsLoaded(start, m_lastLoadedRowFrameSize);
         emit layoutChanged();
+        emit rowsCacheMemoryChanged();
+
+        prefetchRows(start, limit);
+      });
+}
+
+void ValueEditor::ValueViewModel::updatePrefetchDirection(int start) {
+  if (start > m_startFramePosition) {
+    m_prefetchDirection = 1;
+  } else if (start < m_startFramePosition) {
+    m_prefetchDirection = -1;
+  }
+
+  // Pages queued for the previous frame are not loaded after a jump
+  m_prefetchGeneration++;
+}
+
+void ValueEditor::ValueViewModel::onMatchesLoaded(double progress) {
+  m_matchProgress = progress;
+  emit matchProgressChanged();
+
+  // Rows are reloaded by the view on row count change, so the view is
+  // refreshed only when new matches fit into the shown frame
+  bool frameUpdated =
+      m_lastLoadedRowFrameSize < pageSize() &&
+      totalRowCount() > m_startFramePosition + m_lastLoadedRowFrameSize;
+
+  if (frameUpdated || progress >= 1.0) emit totalRowCountChanged();
+}
+
+bool ValueEditor::ValueViewModel::isPrefetchWithinBudget() {
+  qint64 limit = m_model->rowsCacheMemoryLimit();
+
+  // Prefetched pages must not evict the frame shown by the view
+  return limit <= 0 || m_pageMemory * (PREFETCH_PAGES + 2) <= limit;
+}
+
+bool ValueEditor::ValueViewModel::isFrameLoaded(int first, int last) {
+  for (int row = first; row <= last; row++) {
+    if (!m_model->isRowLoaded(row)) return false;
+  }
+
+  return true;
+}
+
+void ValueEditor::ValueViewModel::prefetchRows(int start, int limit,
+                                               int page) {
+  if (!m_model || m_singlePageMode || limit <= 0 || page > PREFETCH_PAGES)
+    return;
+
+  if (!isPrefetchWithinBudget()) return;
+
+  // Without eviction pages before the frame are loaded already, unless the
+  // view jumped over them
+  if (m_prefetchDirection < 0 && m_model->rowsCacheMemoryLimit() <= 0) return;
+
+  int frameStart = start + m_prefetchDirection * limit * page;
+  int frameEnd = qMin(frameStart + limit, totalRowCount()) - 1;
+
+  if (frameStart < 0 || frameStart > frameEnd) return;
+
+  if (isFrameLoaded(frameStart, frameEnd)) {
+    return prefetchRows(start, limit, page + 1);
+  }
+
+  if (m_prefetchingFrames.contains(frameStart)) return;
+
+  m_prefetchingFrames.insert(frameStart);
+
+  int generation = m_prefetchGeneration;
+
+  m_model->loadRows(
+      frameStart, limit,
+      [this, start, limit, page, frameStart, generation](const QString& err,
+                                                         unsigned long) {
+        m_prefetchingFrames.remove(frameStart);
+        emit rowsCacheMemoryChanged();
+
+        if (m_pendingFrame.first == frameStart) {
+          auto frame = m_pendingFrame;
+          m_pendingFrame = qMakePair(-1, 0);
+          return loadRows(frame.first, frame.second);
+        }
+
+        if (!err.isEmpty() || generation != m_prefetchGeneration) return;
+
+        prefetchRows(start, limit, page + 1);
       });
 }
 
@@ -310,6 +450,16 @@ int ValueEditor::ValueViewModel::totalRowCount() {
   return m_model->rowsCount();
 }
 
+double ValueEditor::ValueViewModel::rowsCacheMemory() {
+  if (!m_model) return 0;
+
+  return m_model->rowsCacheMemory();
+}
+
+double ValueEditor::ValueViewModel::matchProgress() const {
+  return m_matchProgress;
+}
+
 int ValueEditor::ValueViewModel::pageSize() {
   QSettings settings;
 
@@ -341,6 +491,20 @@ QVariantMap ValueEditor::ValueViewModel::getRow(int rowIndex) {
   return res;
 }
 
+QObject* ValueEditor::ValueViewModel::getStreamedValue(int rowIndex) {
+  if (!m_model) {
+    qWarning() << "Model is not loaded";
+    return nullptr;
+  }
+
+  QObject* value = m_model->getStreamedValue(rowIndex);
+
+  // Value model is owned by the key model
+  if (value) QQmlEngine::setObjectOwnership(value, QQmlEngine::CppOwnership);
+
+  return value;
+}
+
 void ValueEditor::ValueViewModel::loadRowsCount() {
   if (!m_model) {
     qWarning() << "Model is not loaded";
@@ -374,5 +538,11 @@ void ValueEditor::ValueViewModel::setFilter(const QString& key, QVariant v)
       return;
     }
 
+    // Matches of a new pattern are shown from the first page
+    if (key == "match" && m_model->filter(key) != v) {
+      m_startFramePosition = 0;
+      m_lastLoadedRowFrameSize = 0;
+    }
+
     return m_model->setFilter(key, v);
 }
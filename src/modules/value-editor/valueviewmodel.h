@@ -1,6 +1,8 @@
 #pragma once
 #include <QAbstractListModel>
 #include <QJSValue>
+#include <QPair>
+#include <QSet>
 #include <QSharedPointer>
 #include <QVariantMap>
 #include "common/baselistmodel.h"
@@ -15,6 +17,11 @@ class ValueViewModel : public BaseListModel {
   Q_PROPERTY(bool singlePageMode READ singlePageMode WRITE setSinglePageMode NOTIFY singlePageModeChanged)
   Q_PROPERTY(int totalRowCount READ totalRowCount NOTIFY totalRowCountChanged)
   Q_PROPERTY(int pageSize READ pageSize NOTIFY pageSizeChanged)
+  Q_PROPERTY(double rowsCacheMemory READ rowsCacheMemory NOTIFY
+                 rowsCacheMemoryChanged)
+  Q_PROPERTY(int matchCount READ totalRowCount NOTIFY matchProgressChanged)
+  Q_PROPERTY(
+      double matchProgress READ matchProgress NOTIFY matchProgressChanged)
   Q_PROPERTY(
       QVariantList columnNames READ columnNames NOTIFY columnNamesChanged)
 
@@ -53,6 +60,7 @@ class ValueViewModel : public BaseListModel {
   Q_INVOKABLE void updateRow(int i, const QVariantMap& row);
   Q_INVOKABLE void deleteRow(int i);
   Q_INVOKABLE QVariantMap getRow(int i);
+  Q_INVOKABLE QObject* getStreamedValue(int i);
 
   // multi row operations
   Q_INVOKABLE void loadRowsCount();
@@ -70,6 +78,8 @@ class ValueViewModel : public BaseListModel {
 
   int totalRowCount();
   int pageSize();
+  double rowsCacheMemory();
+  double matchProgress() const;
   QVariantList columnNames();
 
  signals:
@@ -77,6 +87,8 @@ class ValueViewModel : public BaseListModel {
   void error(QString error);
   void totalRowCountChanged();
   void pageSizeChanged();
+  void rowsCacheMemoryChanged();
+  void matchProgressChanged();
   void columnNamesChanged();
   void keyRenamed();
   void keyRemoved();
@@ -86,6 +98,19 @@ class ValueViewModel : public BaseListModel {
   void tabClosed();
   void valueUpdated();
 
+ private:
+  // Loads pages following the frame in the navigation direction
+  void prefetchRows(int start, int limit, int page = 1);
+
+  void updatePrefetchDirection(int start);
+
+  bool isPrefetchWithinBudget();
+
+  // Evicted cache pages may leave gaps inside of the frame
+  bool isFrameLoaded(int first, int last);
+
+  void onMatchesLoaded(double progress);
+
  private:
   QSharedPointer<Model> m_model;
   QSharedPointer<RedisClient::Connection> m_connection;
@@ -93,6 +118,16 @@ class ValueViewModel : public BaseListModel {
   int m_lastLoadedRowFrameSize;
   bool m_singlePageMode;
   QString m_tabTitle;
+
+  // Read-ahead state
+  int m_prefetchDirection;
+  int m_prefetchGeneration;
+  qint64 m_pageMemory;
+  QSet<int> m_prefetchingFrames;
+  // Frame requested while it was prefetched
+  QPair<int, int> m_pendingFrame;
+
+  double m_matchProgress;
 };
 
 }  // namespace ValueEditor
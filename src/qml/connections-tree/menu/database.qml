@@ -95,7 +95,7 @@ RowLayout {
                                 'icon': PlatformUtils.getThemeIcon("console.svg"), 'event': 'console', "help": qsTranslate("RESP","Open Console"),
                                 "shortcut": "Ctrl+T",
                             },
-                            {'icon': PlatformUtils.getThemeIcon("memory_usage.svg"), "event": "analyze_memory_usage", "help": qsTranslate("RESP","Analyze Used Memory")},
+                            {'icon': PlatformUtils.getThemeIcon("memory_usage.svg"), "event": "analyze_memory_usage", "help": styleData.value["memory_estimated"]? qsTranslate("RESP","Calculate Exact Used Memory") : qsTranslate("RESP","Analyze Used Memory")},
                             {
                                 'icon': PlatformUtils.getThemeIcon("bulk_operations.svg"), 'callback': 'bulk_menu', "help": qsTranslate("RESP","Bulk Operations"),
                             },
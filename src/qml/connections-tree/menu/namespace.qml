@@ -29,7 +29,7 @@ InlineMenu {
                 {'icon': PlatformUtils.getThemeIcon("refresh.svg"), "event": "reload", "help": qsTranslate("RESP","Reload Namespace"), "shortcut": "Ctrl+R"},
                 {'icon': PlatformUtils.getThemeIcon("add.svg"), 'event': 'add_key', "help": qsTranslate("RESP","Add New Key")},
                 {'icon': PlatformUtils.getThemeIcon("copy.svg"), "callback": "copy", "help": qsTranslate("RESP","Copy Namespace Pattern"), "shortcut": "Ctrl+C"},
-                {'icon': PlatformUtils.getThemeIcon("memory_usage.svg"), "event": "analyze_memory_usage", "help": qsTranslate("RESP","Analyze Used Memory")},
+                {'icon': PlatformUtils.getThemeIcon("memory_usage.svg"), "event": "analyze_memory_usage", "help": styleData.value["memory_estimated"]? qsTranslate("RESP","Calculate Exact Used Memory") : qsTranslate("RESP","Analyze Used Memory")},
                 {'icon': PlatformUtils.getThemeIcon("delete.svg"), "event": "delete", "help": qsTranslate("RESP","Delete Namespace"), "shortcut": "D"},
             ]
         }
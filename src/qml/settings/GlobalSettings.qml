@@ -158,7 +158,7 @@ BetterDialog {
 
                     GridLayout {
                         columns: 2
-                        rows: 2
+                        rows: 4
                         flow: GridLayout.TopToBottom
                         rowSpacing: PlatformUtils.isScalingDisabled() ? 20 : 10
                         columnSpacing: PlatformUtils.isScalingDisabled() ? 20 : 15
@@ -212,6 +212,30 @@ BetterDialog {
                             value: 100
                             label: qsTranslate("RESP","Maximum amount of items per page")
                         }
+
+                        IntOption {
+                            id: valueEditorCacheMemory
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            min: 16
+                            max: 65536
+                            value: 256
+                            label: qsTranslate("RESP","Loaded rows memory limit per tab (MB)")
+                        }
+
+                        IntOption {
+                            id: valueEditorStreamingThreshold
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            min: 1
+                            max: 2048
+                            value: 16
+                            label: qsTranslate("RESP","Load larger strings in parts (MB)")
+                        }
                     }
 
                     SettingsGroupTitle {
@@ -221,7 +245,7 @@ BetterDialog {
 
                     GridLayout {
                         columns: 2
-                        rows: 4
+                        rows: 8
                         flow: GridLayout.TopToBottom
                         rowSpacing: PlatformUtils.isScalingDisabled() ? 20 : 10
                         columnSpacing: PlatformUtils.isScalingDisabled() ? 20 : 15
@@ -258,6 +282,27 @@ BetterDialog {
                             label: qsTranslate("RESP","Show only last part for namespaced keys")
                         }
 
+                        BoolOption {
+                            id: streamingKeysLoading
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            value: false
+                            label: qsTranslate("RESP","Render keys while SCAN is running")
+                        }
+
+                        BoolOption {
+                            id: namespacesSummaryLoading
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            value: false
+                            label: qsTranslate("RESP","Count namespaced keys on server")
+                            description: qsTranslate("RESP","(Requires EVAL command)")
+                        }
+
                         IntOption {
                             id: scanCommandLimit
 
@@ -291,7 +336,7 @@ BetterDialog {
                             min: 100
                             max: 100000
                             value: 1000
-                            label: qsTranslate("RESP","Live update maximum allowed keys")
+                            label: qsTranslate("RESP","Live update maximum changes applied incrementally")
                         }
 
                         IntOption {
@@ -305,6 +350,75 @@ BetterDialog {
                             value: 10
                             label: qsTranslate("RESP","Live update interval (in seconds)")
                         }
+
+                        BoolOption {
+                            id: liveUpdateKeyspaceEvents
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            value: true
+                            label: qsTranslate("RESP","Live update with keyspace notifications")
+                            description: qsTranslate("RESP","(Apply changes without rescanning keys)")
+                        }
+
+                        IntOption {
+                            id: namespacesSummaryDepth
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            min: 1
+                            max: 10
+                            value: 2
+                            label: qsTranslate("RESP","Namespace levels counted on server")
+                        }
+
+                        BoolOption {
+                            id: keysMetadataPrefetch
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            value: true
+                            label: qsTranslate("RESP","Show type and TTL of visible keys")
+                        }
+
+                        BoolOption {
+                            id: keysDiskCache
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            value: false
+                            label: qsTranslate("RESP","Cache loaded keys on disk")
+                            description: qsTranslate("RESP","(Render keys instantly on reconnect)")
+                        }
+
+                        IntOption {
+                            id: clusterScanParallelism
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            min: 1
+                            max: 64
+                            value: 8
+                            label: qsTranslate("RESP","Cluster nodes scanned concurrently")
+                        }
+
+                        IntOption {
+                            id: treeMemoryBudget
+
+                            Layout.fillWidth: true
+                            Layout.preferredHeight: 30
+
+                            min: 0
+                            max: 65536
+                            value: 2048
+                            label: qsTranslate("RESP","Keys tree memory budget per connection (MB)")
+                            description: qsTranslate("RESP","(0 - unlimited)")
+                        }
                     }
 
                     Item {
@@ -344,15 +458,25 @@ BetterDialog {
         property alias showNamespacesOnTop: nsOnTop.value
         property alias reopenNamespacesOnReload: nsReload.value        
         property alias namespacedKeysShortName: namespacedKeysShortName.value
+        property alias streamingKeysLoading: streamingKeysLoading.value
+        property alias namespacesSummaryLoading: namespacesSummaryLoading.value
+        property alias namespacesSummaryDepth: namespacesSummaryDepth.value
+        property alias keysMetadataPrefetch: keysMetadataPrefetch.value
+        property alias keysDiskCache: keysDiskCache.value
+        property alias clusterScanParallelism: clusterScanParallelism.value
+        property alias treeMemoryBudget: treeMemoryBudget.value
         property alias treeItemMaxChilds: childItemsLimit.value
         property alias liveUpdateKeysLimit: liveKeyLimit.value
         property alias liveUpdateInterval: liveUpdateInterval.value
+        property alias liveUpdateKeyspaceEvents: liveUpdateKeyspaceEvents.value
         property alias appFont: appFont.value
         property alias appFontSize: appFontSize.value
         property alias valueEditorFont: valueEditorFont.value
         property alias valueEditorFontSize: valueEditorFontSize.value
         property alias valueSizeLimit: valueSizeLimit.value
         property alias valueEditorPageSize: valueEditorPageSizeControl.value
+        property alias valueEditorCacheMemory: valueEditorCacheMemory.value
+        property alias valueEditorStreamingThreshold: valueEditorStreamingThreshold.value
         property alias locale: appLang.value
         property alias darkModeOn: darkModeLinux.value
         property alias darkMode: darkModeWindows.value
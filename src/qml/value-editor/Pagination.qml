@@ -44,6 +44,12 @@ ColumnLayout {
             Layout.columnSpan: 2
             text:  qsTranslate("RESP","Size: ") + keyRowsCount
         }
+
+        BetterLabel {
+            Layout.columnSpan: 2
+            visible: keyTab.keyModel && keyTab.keyModel.rowsCacheMemory > 0
+            text: qsTranslate("RESP","Cached: ") + (keyTab.keyModel ? qmlUtils.humanSize(keyTab.keyModel.rowsCacheMemory) : "")
+        }
     }
 
     RowLayout {        
@@ -454,7 +454,9 @@ Item {
 
                 source: keyModel && (keyType === "list" || keyType === "stream") ?
                             "./filters/" + String(keyType)[0].toUpperCase()
-                            + String(keyType).substring(1) +"Filters.qml"  : ""
+                            + String(keyType).substring(1) +"Filters.qml"
+                          : keyModel && (keyType === "hash" || keyType === "set" || keyType === "zset") ?
+                            "./filters/MatchFilters.qml" : ""
             }
 
         }
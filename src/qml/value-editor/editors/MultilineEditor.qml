@@ -29,6 +29,8 @@ Item
     property string lastSelectedFormatterSetting: "last_selected_" + root.formatterSettingsPrefix + "formatter"
     property string lastSelectedManualDecompression: "last_selected_" + root.formatterSettingsPrefix + "decompression"
     property string defaultFormatter: "auto"
+    property bool isStreamed: false
+    property double streamedSize: 0
 
     property var __formatterCombobox: formatterSelector
     property var __textView: textView
@@ -104,7 +106,46 @@ Item
         }
     }
 
+    // Value is too large to be loaded at once, windows of the value are
+    // loaded by the model when the view shows them
+    function loadStreamedValue(streamedModel, preview) {
+        root.value = preview
+        root.isStreamed = true
+        root.streamedSize = streamedModel.size
+        root.showFormatters = true
+        largeValueDialog.visible = false
+        binaryFlag.visible = qmlUtils.isBinaryString(preview)
+
+        if (binaryFlag.visible) {
+            formatterSelector._select("HEX")
+        } else {
+            formatterSelector.currentIndex = 0
+        }
+
+        textView.model = streamedModel
+        textView.readOnly = true
+        textView.textFormat = TextEdit.PlainText
+        textView.format = "plain"
+        _loadStreamedFormatter()
+        root.isEdited = false
+    }
+
+    function _loadStreamedFormatter() {
+        var formatterName = formatterSelector.model.get(formatterSelector.currentIndex)["name"]
+
+        if (formatterName !== "Plain Text" && formatterName !== "HEX") {
+            notification.showError(qsTranslate("RESP", "Only Plain Text and HEX formatters are available for large values"))
+            formatterName = binaryFlag.visible ? "HEX" : "Plain Text"
+            formatterSelector._select(formatterName)
+        }
+
+        textView.model.hex = formatterName === "HEX"
+    }
+
     function loadFormattedValue(val) {
+        if (root.isStreamed) {
+            return _loadStreamedFormatter()
+        }
 
         var guessFormatter = false;
 
@@ -333,6 +374,8 @@ Item
 
         textView.model = null
         root.value = ""
+        root.isStreamed = false
+        root.streamedSize = 0
         root.isEdited = false
         root.valueCompression = -1
         binaryFlag.visible = false
@@ -358,7 +401,7 @@ Item
 
             BetterLabel { text: root.fieldLabel }
             TextEdit {                
-                text: qsTranslate("RESP", "Size: ") + qmlUtils.humanSize(qmlUtils.binaryStringLength(value));
+                text: qsTranslate("RESP", "Size: ") + qmlUtils.humanSize(root.isStreamed ? root.streamedSize : qmlUtils.binaryStringLength(value));
                 readOnly: true;
                 selectByMouse: true
                 color: "#ccc"
@@ -416,7 +459,8 @@ Item
 
                 visible: {
                     console.log("keyType:", keyType)
-                    return binaryFlag.visible && keyType != "hyperloglog" && qmlUtils.binaryStringLength(root.value) <= appSettings.valueSizeLimit
+                    return binaryFlag.visible && keyType != "hyperloglog" && !root.isStreamed
+                            && qmlUtils.binaryStringLength(root.value) <= appSettings.valueSizeLimit
                             || root.valueCompression > 0
                 }
 
@@ -544,7 +588,7 @@ Item
                         Layout.alignment: Qt.AlignHCenter
 
                         tooltip: qsTranslate("RESP","Copy to Clipboard")
-                        enabled: root.value !== ""
+                        enabled: root.value !== "" && !root.isStreamed
 
                         onClicked: copyValue()
 
@@ -566,7 +610,7 @@ Item
                         imgWidth: imgBtnWidth
                         imgHeight: imgBtnHeight
 
-                        enabled: root.value !== "" && root.showFormatters
+                        enabled: root.value !== "" && root.showFormatters && !root.isStreamed
 
                         shortcutText: qmlUtils.standardKeyToString(StandardKey.SaveAs)
                     }
@@ -584,7 +628,7 @@ Item
                         imgWidth: imgBtnWidth
                         imgHeight: imgBtnHeight
 
-                        enabled: root.value !== ""
+                        enabled: root.value !== "" && !root.isStreamed
                     }
                 }
 
@@ -644,7 +688,7 @@ Item
                             PropertyChanges {
                                 target: saveBtn
                                 iconSource: PlatformUtils.getThemeIcon("save.svg")
-                                enabled: !showOnlyRWformatters && root.value !== "" && valueEditor.item.isEdited() && keyType != "stream"
+                                enabled: !showOnlyRWformatters && root.value !== "" && valueEditor.item.isEdited() && keyType != "stream" && !root.isStreamed
                             }
                         },
                         State {
@@ -740,10 +784,22 @@ Item
                     function performSearch() {
                         noResults.visible = false;
 
+                        // Windows of streamed value are searched asynchronously
+                        if (root.isStreamed) {
+                            textView.model.searchText(searchField.text,
+                                                      searchToolbar.lastSearchResultPosition,
+                                                      searchRegexInText.checked)
+                            return
+                        }
+
                         var result = textView.model.searchText(searchField.text,
                                                                searchToolbar.lastSearchResultPosition,
                                                                searchRegexInText.checked)                        
 
+                        showSearchResult(result)
+                    }
+
+                    function showSearchResult(result) {
                         if (result[0] >= 0) {
                             textView.currentIndex = result[0];
                             searchToolbar.lastSearchResultPosition = result[1] + result[3];
@@ -760,6 +816,18 @@ Item
                     }
                 }
 
+                Connections {
+                    target: root.isStreamed ? textView.model : null
+
+                    function onSearchFinished(result) {
+                        submitSearchButton.showSearchResult(result)
+                    }
+
+                    function onError(error) {
+                        notification.showError(error)
+                    }
+                }
+
                 BetterCheckbox {
                     id: searchRegexInText
                     objectName: "rdm_value_editor_search_regex_checkbox"
@@ -866,6 +934,10 @@ Item
                                 highlightJSON: textView.format === "json"
 
                                 onTextChanged: {
+                                    // Windows of streamed value are loaded while scrolling
+                                    if (root.isStreamed)
+                                        return
+
                                     root.isEdited = true
                                     textView.model && textView.model.setTextChunk(index, textAreaPart.text)
                                 }
@@ -55,6 +55,12 @@ AbstractEditor {
             return
 
         active = true
+
+        if (rowValue['streamedSize'] > 0) {
+            textEditor.loadStreamedValue(keyTab.keyModel.getStreamedValue(0), rowValue['value'])
+            return
+        }
+
         textEditor.loadFormattedValue(rowValue['value'])
     }
 
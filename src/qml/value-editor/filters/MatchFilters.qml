@@ -0,0 +1,72 @@
+import QtQuick 2.13
+import QtQuick.Layouts 1.1
+import "./../../common"
+import "../../common/platformutils.js" as PlatformUtils
+
+RowLayout {
+    id: matchFilter
+    objectName: "rdm_match_filter"
+
+    property string appliedPattern: ""
+
+    function setMatchFilter() {
+        matchFilter.appliedPattern = matchPatternField.text
+        keyTab.keyModel.setFilter("match", matchFilter.appliedPattern)
+
+        table.currentStart = 0
+        reloadValue()
+
+        matchPatternField.isEdited = false
+    }
+
+    BetterLabel {
+        text: qsTranslate("RESP", "Match pattern:")
+    }
+
+    BetterTextField {
+        id: matchPatternField
+        objectName: "rdm_match_filter_pattern_field"
+
+        property bool isEdited: false
+
+        Layout.fillWidth: true
+        placeholderText: qsTranslate("RESP", "Glob-style pattern, e.g. user:*")
+        tooltip: qsTranslate("RESP", "Elements are filtered by the server, leave empty to show all elements")
+
+        onTextEdited: {
+            isEdited = true
+        }
+
+        onAccepted: {
+            matchFilter.setMatchFilter()
+        }
+    }
+
+    BetterButton {
+        objectName: "rdm_match_filter_apply_btn"
+        implicitWidth: 30
+        iconSource: PlatformUtils.getThemeIcon("filter.svg")
+        tooltip: qsTranslate("RESP","Apply filter")
+        enabled: matchPatternField.isEdited
+
+        onClicked: {
+            matchFilter.setMatchFilter()
+        }
+    }
+
+    BetterLabel {
+        objectName: "rdm_match_filter_progress"
+        visible: matchFilter.appliedPattern !== "" && keyTab.keyModel
+        text: {
+            if (!keyTab.keyModel)
+                return ""
+
+            if (keyTab.keyModel.matchProgress < 1.0)
+                return qsTranslate("RESP", "Matches: %1 (%2% scanned)")
+                        .arg(keyTab.keyModel.matchCount)
+                        .arg(Math.floor(keyTab.keyModel.matchProgress * 100))
+
+            return qsTranslate("RESP", "Matches: %1").arg(keyTab.keyModel.matchCount)
+        }
+    }
+}
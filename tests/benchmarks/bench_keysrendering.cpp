@@ -0,0 +1,76 @@
+#include "bench_keysrendering.h"
+
+#include <QTest>
+#include <QtCore>
+
+#include "benchutils.h"
+#include "connections-tree/items/databaseitem.h"
+#include "connections-tree/keysrendering.h"
+#include "connections-tree/model.h"
+#include "mocks.h"
+
+using namespace ConnectionsTree;
+using BenchUtils::Keyspace;
+
+namespace {
+
+template <typename T>
+void fakeDeleter(T *) {}
+
+KeysTreeRenderer::RenderingSettigns renderingSettings() {
+  return KeysTreeRenderer::RenderingSettigns{
+      QRegExp("*", Qt::CaseSensitive, QRegExp::Wildcard),
+      ":", 0, 1000, true, false, false};
+}
+
+}  // namespace
+
+BenchKeysRendering::BenchKeysRendering(QObject *parent) : QObject(parent) {}
+
+void BenchKeysRendering::benchRenderKeys_data() {
+  BenchUtils::addKeyspaceRows();
+}
+
+void BenchKeysRendering::benchRenderKeys() {
+  QFETCH(Keyspace, keyspace);
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSet<QByteArray> expandedNamespaces{"ns1", "ns1:ns1"};
+
+  QBENCHMARK {
+    QSharedPointer<DatabaseItem> db(new DatabaseItem(
+        0, keyspace.keysCount, ptr, QWeakPointer<TreeItem>(), model));
+
+    KeysTreeRenderer::renderKeys(ptr, keys, db, renderingSettings(),
+                                 expandedNamespaces);
+  }
+}
+
+void BenchKeysRendering::benchRenderNamespaceTrie_data() {
+  BenchUtils::addKeyspaceRows();
+}
+
+void BenchKeysRendering::benchRenderNamespaceTrie() {
+  QFETCH(Keyspace, keyspace);
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSet<QByteArray> expandedNamespaces{"ns1", "ns1:ns1"};
+
+  QBENCHMARK {
+    QSharedPointer<DatabaseItem> db(new DatabaseItem(
+        0, keyspace.keysCount, ptr, QWeakPointer<TreeItem>(), model));
+
+    auto trie = KeysTreeRenderer::buildNamespaceTrie(
+        keys, 0, renderingSettings(), expandedNamespaces);
+
+    KeysTreeRenderer::renderNamespaceTrie(ptr, trie, db, renderingSettings());
+  }
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <QObject>
+
+class BenchKeysRendering : public QObject {
+  Q_OBJECT
+ public:
+  explicit BenchKeysRendering(QObject *parent = 0);
+
+ private slots:
+  void benchRenderKeys_data();
+  void benchRenderKeys();
+  void benchRenderNamespaceTrie_data();
+  void benchRenderNamespaceTrie();
+};
@@ -0,0 +1,60 @@
+#include "bench_keyssorting.h"
+
+#include <QTest>
+#include <QtCore>
+#include <algorithm>
+#include <random>
+
+#include "connections-tree/keyssorting.h"
+
+namespace {
+
+QList<QByteArray> generateShuffledKeys(int count) {
+  QList<QByteArray> keys;
+  keys.reserve(count);
+
+  for (int i = 0; i < count; i++) {
+    keys.append(QString("ns%1:user:%2:session:%3")
+                    .arg(i % 100)
+                    .arg(i / 100)
+                    .arg(i % 7)
+                    .toUtf8());
+  }
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+void addBenchmarkRows() {
+  QTest::addColumn<int>("keysCount");
+
+  QTest::newRow("100k keys") << 100000;
+  QTest::newRow("1M keys") << 1000000;
+  QTest::newRow("10M keys") << 10000000;
+}
+
+}  // namespace
+
+BenchKeysSorting::BenchKeysSorting(QObject *parent) : QObject(parent) {}
+
+void BenchKeysSorting::benchStdSort_data() { addBenchmarkRows(); }
+
+void BenchKeysSorting::benchStdSort() {
+  QFETCH(int, keysCount);
+
+  auto keys = generateShuffledKeys(keysCount);
+
+  QBENCHMARK_ONCE { std::sort(keys.begin(), keys.end()); }
+}
+
+void BenchKeysSorting::benchParallelSort_data() { addBenchmarkRows(); }
+
+void BenchKeysSorting::benchParallelSort() {
+  QFETCH(int, keysCount);
+
+  auto keys = generateShuffledKeys(keysCount);
+
+  QBENCHMARK_ONCE { ConnectionsTree::sortKeys(keys); }
+
+  QVERIFY(std::is_sorted(keys.begin(), keys.end()));
+}
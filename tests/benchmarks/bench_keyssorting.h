@@ -0,0 +1,14 @@
+#pragma once
+#include <QObject>
+
+class BenchKeysSorting : public QObject {
+  Q_OBJECT
+ public:
+  explicit BenchKeysSorting(QObject *parent = 0);
+
+ private slots:
+  void benchStdSort_data();
+  void benchStdSort();
+  void benchParallelSort_data();
+  void benchParallelSort();
+};
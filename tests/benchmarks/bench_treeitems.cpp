@@ -0,0 +1,226 @@
+#include "bench_treeitems.h"
+
+#include <QTest>
+#include <QtCore>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "benchutils.h"
+#include "connections-tree/keysrendering.h"
+#include "mocks.h"
+
+using namespace ConnectionsTree;
+using BenchUtils::Keyspace;
+
+namespace {
+
+template <typename T>
+void fakeDeleter(T *) {}
+
+// Amount of "Load more" pages rendered by benchFetchMore
+const int FETCH_MORE_PAGES = 10;
+
+KeysTreeRenderer::RenderingSettigns renderingSettings(
+    uint renderLimit, bool appendNewItems = true) {
+  return KeysTreeRenderer::RenderingSettigns{
+      QRegExp("*", Qt::CaseSensitive, QRegExp::Wildcard),
+      ":", 0, renderLimit, appendNewItems, false, false};
+}
+
+// Bytes allocated with malloc, -1 if allocator statistics are unavailable
+qint64 allocatedBytes() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  return static_cast<qint64>(mallinfo2().uordblks);
+#elif defined(__GLIBC__)
+  return static_cast<qint64>(static_cast<unsigned int>(mallinfo().uordblks));
+#else
+  return -1;
+#endif
+}
+
+int visitIndexes(Model &model, const QModelIndex &parent) {
+  int visited = 0;
+  int rows = model.rowCount(parent);
+
+  for (int row = 0; row < rows; row++) {
+    visited += 1 + visitIndexes(model, model.index(row, 0, parent));
+  }
+
+  return visited;
+}
+
+}  // namespace
+
+BenchTreeItems::BenchTreeItems(QObject *parent) : QObject(parent) {}
+
+void BenchTreeItems::benchFetchMore_data() { BenchUtils::addKeyspaceRows(); }
+
+void BenchTreeItems::benchFetchMore() {
+  QFETCH(Keyspace, keyspace);
+
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  BenchUtils::Tree tree(ptr, keyspace.keysCount);
+  auto db = tree.db();
+
+  db->appendRawKeys(RawKeys(keyspace.generate()));
+
+  int changes = 0;
+  QObject::connect(&tree.model(), &Model::itemChanged,
+                   [&changes](QWeakPointer<TreeItem>) { changes++; });
+
+  QBENCHMARK_ONCE {
+    for (int page = 0; page < FETCH_MORE_PAGES; page++) {
+      changes = 0;
+
+      // Item is changed once before rendering and once it's finished
+      db->fetchMore();
+      QVERIFY(BenchUtils::waitFor([&changes]() { return changes >= 2; }));
+    }
+  }
+}
+
+void BenchTreeItems::benchRemoveObsoleteKeys_data() {
+  BenchUtils::addKeyspaceRows();
+}
+
+void BenchTreeItems::benchRemoveObsoleteKeys() {
+  QFETCH(Keyspace, keyspace);
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  BenchUtils::Tree tree(ptr, keyspace.keysCount);
+
+  // All keys are rendered to remove key items from every level
+  KeysTreeRenderer::renderKeys(ptr, keys, tree.db(),
+                               renderingSettings(keyspace.keysCount),
+                               BenchUtils::namespaces(keys, keyspace.depth));
+
+  auto index = tree.db()->getKeysIndex();
+  QList<QByteArray> obsoleteKeys;
+  int pos = 0;
+
+  for (auto it = index.begin(); it != index.end(); ++it, ++pos) {
+    if (pos % 10 == 0) obsoleteKeys.append(it.key());
+  }
+
+  QBENCHMARK_ONCE { tree.db()->removeObsoleteKeys(obsoleteKeys); }
+
+  QCOMPARE(tree.db()->getKeysIndex().size(),
+           index.size() - obsoleteKeys.size());
+  QCOMPARE(BenchUtils::collectKeyItems(tree.db()).size(),
+           index.size() - obsoleteKeys.size());
+}
+
+void BenchTreeItems::benchKeyMemory_data() {
+  QTest::addColumn<Keyspace>("keyspace");
+  QTest::addColumn<bool>("materialize");
+
+  QTest::newRow("100k keys, flat, rows") << Keyspace{100000, 0, 0, 0} << false;
+  QTest::newRow("100k keys, flat, key items")
+      << Keyspace{100000, 0, 0, 0} << true;
+  QTest::newRow("100k keys, depth 2, rows")
+      << Keyspace{100000, 2, 10, 100} << false;
+  QTest::newRow("100k keys, depth 2, key items")
+      << Keyspace{100000, 2, 10, 100} << true;
+}
+
+void BenchTreeItems::benchKeyMemory() {
+  QFETCH(Keyspace, keyspace);
+  QFETCH(bool, materialize);
+
+  if (allocatedBytes() < 0) QSKIP("Allocator statistics are not available");
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  BenchUtils::Tree tree(ptr, keyspace.keysCount);
+  auto expanded = BenchUtils::namespaces(keys, keyspace.depth);
+
+  // Key names are allocated before, only tree structures are measured
+  qint64 before = allocatedBytes();
+
+  KeysTreeRenderer::renderKeys(ptr, keys, tree.db(),
+                               renderingSettings(keyspace.keysCount),
+                               expanded);
+
+  // Key items are created when the view accesses rows
+  if (materialize) {
+    QCOMPARE(BenchUtils::collectKeyItems(tree.db()).size(), keys.size());
+  }
+
+  qint64 bytesPerKey = (allocatedBytes() - before) / keys.size();
+
+  QTest::setBenchmarkResult(bytesPerKey, QTest::BytesAllocated);
+}
+
+void BenchTreeItems::benchModelIndex_data() { BenchUtils::addKeyspaceRows(); }
+
+void BenchTreeItems::benchModelIndex() {
+  QFETCH(Keyspace, keyspace);
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  BenchUtils::Tree tree(ptr, keyspace.keysCount);
+
+  // Top-level namespaces are expanded like in the view
+  KeysTreeRenderer::renderKeys(ptr, keys, tree.db(), renderingSettings(1000),
+                               BenchUtils::namespaces(keys, 1));
+
+  QModelIndex dbIndex = tree.dbIndex();
+  QVERIFY(dbIndex.isValid());
+
+  int visited = 0;
+
+  QBENCHMARK { visited = visitIndexes(tree.model(), dbIndex); }
+
+  QVERIFY(visited > 0);
+}
+
+void BenchTreeItems::benchInsertChild_data() {
+  QTest::addColumn<Keyspace>("keyspace");
+
+  // Each insertion shifts the list of child items, so keyspaces are smaller
+  QTest::newRow("20k keys, flat") << Keyspace{20000, 0, 0, 0};
+  QTest::newRow("20k keys, depth 1") << Keyspace{20000, 1, 10, 100};
+}
+
+void BenchTreeItems::benchInsertChild() {
+  QFETCH(Keyspace, keyspace);
+
+  auto keys = keyspace.generate();
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  BenchUtils::Tree tree(ptr, keyspace.keysCount);
+
+  QList<QByteArray> renderedKeys;
+  QList<QByteArray> insertedKeys;
+
+  for (int i = 0; i < keys.size(); i++) {
+    (i % 2 ? insertedKeys : renderedKeys).append(keys.at(i));
+  }
+
+  auto expanded = BenchUtils::namespaces(keys, keyspace.depth);
+
+  KeysTreeRenderer::renderKeys(ptr, renderedKeys, tree.db(),
+                               renderingSettings(keyspace.keysCount),
+                               expanded);
+
+  // Live update inserts new keys into sorted child items one by one
+  QBENCHMARK_ONCE {
+    KeysTreeRenderer::renderKeys(ptr, insertedKeys, tree.db(),
+                                 renderingSettings(keyspace.keysCount, false),
+                                 expanded);
+  }
+
+  QCOMPARE(BenchUtils::collectKeyItems(tree.db()).size(), keys.size());
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <QObject>
+
+class BenchTreeItems : public QObject {
+  Q_OBJECT
+ public:
+  explicit BenchTreeItems(QObject *parent = 0);
+
+ private slots:
+  void benchFetchMore_data();
+  void benchFetchMore();
+  void benchRemoveObsoleteKeys_data();
+  void benchRemoveObsoleteKeys();
+  void benchKeyMemory_data();
+  void benchKeyMemory();
+  void benchModelIndex_data();
+  void benchModelIndex();
+  void benchInsertChild_data();
+  void benchInsertChild();
+};
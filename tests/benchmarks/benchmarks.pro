@@ -0,0 +1,70 @@
+QT       += core gui network concurrent widgets quick testlib
+
+TARGET = benchmarks
+TEMPLATE = app
+
+CONFIG += release c++17
+CONFIG-=app_bundle
+
+PROJECT_ROOT = $$PWD/../..//
+SRC_DIR = $$PROJECT_ROOT/src//
+CONNECTIONS_TREE_SRC_DIR = $$SRC_DIR/modules/connections-tree/
+CONNECTIONS_TREE_TESTS_DIR = $$PWD/../unit_tests/testcases/connections-tree/
+
+HEADERS += \
+    $$files($$PWD/bench_*.h) \
+    $$PWD/benchutils.h \
+    $$files($$SRC_DIR/modules/common/*.h) \
+    $$files($$CONNECTIONS_TREE_SRC_DIR/items/*.h) \
+    $$CONNECTIONS_TREE_SRC_DIR/operations.h \
+    $$CONNECTIONS_TREE_SRC_DIR/utils.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysrendering.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysindex.h \
+    $$CONNECTIONS_TREE_SRC_DIR/globmatcher.h \
+    $$CONNECTIONS_TREE_SRC_DIR/scanresultscache.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssorting.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssnapshot.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysmetadata.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysdiskcache.h \
+    $$CONNECTIONS_TREE_SRC_DIR/rawkeys.h \
+    $$CONNECTIONS_TREE_SRC_DIR/itemhandles.h \
+    $$CONNECTIONS_TREE_SRC_DIR/memorysampling.h \
+    $$CONNECTIONS_TREE_SRC_DIR/memorybudget.h \
+    $$CONNECTIONS_TREE_SRC_DIR/model.h \
+    $$CONNECTIONS_TREE_TESTS_DIR/mocks.h \
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$files($$PWD/bench_*.cpp) \
+    $$PWD/benchutils.cpp \
+    $$files($$SRC_DIR/modules/common/*.cpp) \
+    $$files($$CONNECTIONS_TREE_SRC_DIR/items/*.cpp) \
+    $$CONNECTIONS_TREE_SRC_DIR/utils.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysrendering.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysindex.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/globmatcher.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/scanresultscache.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssorting.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssnapshot.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysmetadata.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysdiskcache.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/rawkeys.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/itemhandles.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/memorysampling.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/memorybudget.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/model.cpp \
+    $$CONNECTIONS_TREE_TESTS_DIR/mocks.cpp \
+
+INCLUDEPATH += $$SRC_DIR/modules/ \
+    $$SRC_DIR/ \
+    $$PWD/ \
+    $$CONNECTIONS_TREE_TESTS_DIR \
+    $$PROJECT_ROOT/3rdparty/fakeit/single_header/qtest/
+
+include($$PROJECT_ROOT/3rdparty/3rdparty.pri)
+
+DESTDIR = $$PROJECT_ROOT/bin/tests
+
+OBJECTS_DIR = $$DESTDIR/bench_obj
+MOC_DIR = $$DESTDIR/bench_obj
+RCC_DIR = $$DESTDIR/bench_obj
@@ -0,0 +1,147 @@
+#include "benchutils.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTest>
+#include <algorithm>
+
+#include "connections-tree/items/sortabletreeitem.h"
+
+using namespace ConnectionsTree;
+
+QList<QByteArray> BenchUtils::Keyspace::generate(bool sorted) const {
+  QList<QByteArray> keys;
+  keys.reserve(keysCount);
+
+  for (int i = 0; i < keysCount; i++) {
+    QByteArray key;
+
+    if (i % 100 < namespacedPercent) {
+      int nsId = i;
+
+      for (int level = 0; level < depth; level++) {
+        key.append("ns");
+        key.append(QByteArray::number(nsId % fanout));
+        key.append(':');
+        nsId /= fanout;
+      }
+    }
+
+    key.append("key");
+    key.append(QByteArray::number(i));
+    keys.append(key);
+  }
+
+  if (sorted) std::sort(keys.begin(), keys.end());
+
+  return keys;
+}
+
+QSet<QByteArray> BenchUtils::namespaces(const QList<QByteArray> &keys,
+                                        int maxDepth) {
+  QSet<QByteArray> result;
+
+  for (const auto &key : keys) {
+    int pos = -1;
+
+    for (int level = 0; level < maxDepth; level++) {
+      pos = key.indexOf(':', pos + 1);
+
+      if (pos < 0) break;
+
+      result.insert(key.left(pos));
+    }
+  }
+
+  return result;
+}
+
+void BenchUtils::addKeyspaceRows() {
+  QTest::addColumn<Keyspace>("keyspace");
+
+  QTest::newRow("100k keys, flat") << Keyspace{100000, 0, 0, 0};
+  QTest::newRow("100k keys, depth 1") << Keyspace{100000, 1, 100, 100};
+  QTest::newRow("100k keys, depth 4") << Keyspace{100000, 4, 10, 100};
+  QTest::newRow("100k keys, depth 2, 10% namespaced")
+      << Keyspace{100000, 2, 10, 10};
+  QTest::newRow("1M keys, depth 3") << Keyspace{1000000, 3, 20, 100};
+}
+
+class BenchUtils::Tree::BenchModel : public Model {
+ public:
+  void addItem(QSharedPointer<SortableTreeItem> item) { addRootItem(item); }
+};
+
+class BenchUtils::Tree::RootItem : public SortableTreeItem {
+ public:
+  explicit RootItem(Model &m) : SortableTreeItem(m) {}
+
+  QString getDisplayName() const override { return "benchmark"; }
+
+  QString type() const override { return "benchmark"; }
+
+  QList<QSharedPointer<TreeItem>> getAllChilds() const override {
+    return m_childs;
+  }
+
+  uint childCount(bool) const override { return m_childs.size(); }
+
+  QSharedPointer<TreeItem> child(uint row) override {
+    return m_childs.value(row);
+  }
+
+  QWeakPointer<TreeItem> parent() const override {
+    return QWeakPointer<TreeItem>();
+  }
+
+  void unload() override { m_childs.clear(); }
+
+  QList<QSharedPointer<TreeItem>> m_childs;
+};
+
+BenchUtils::Tree::Tree(QSharedPointer<Operations> operations, int keysCount)
+    : m_model(new BenchModel()), m_root(new RootItem(*m_model)) {
+  m_root->m_childs.append(QSharedPointer<DatabaseItem>(new DatabaseItem(
+      0, keysCount, operations, m_root.toWeakRef(), *m_model)));
+  m_model->addItem(m_root);
+}
+
+BenchUtils::Tree::~Tree() { m_root->unload(); }
+
+Model &BenchUtils::Tree::model() { return *m_model; }
+
+QSharedPointer<DatabaseItem> BenchUtils::Tree::db() const {
+  return m_root->m_childs.first().staticCast<DatabaseItem>();
+}
+
+QModelIndex BenchUtils::Tree::dbIndex() {
+  return m_model->index(0, 0, m_model->index(0, 0, QModelIndex()));
+}
+
+bool BenchUtils::waitFor(std::function<bool()> condition, int timeout) {
+  QElapsedTimer timer;
+  timer.start();
+
+  while (!condition()) {
+    if (timer.elapsed() > timeout) return false;
+
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+  }
+
+  return true;
+}
+
+QList<QWeakPointer<KeyItem>> BenchUtils::collectKeyItems(
+    QSharedPointer<TreeItem> item) {
+  QList<QWeakPointer<KeyItem>> result;
+
+  for (const auto &child : item->getAllChilds()) {
+    if (child->type() == "key") {
+      result.append(child.staticCast<KeyItem>().toWeakRef());
+    } else {
+      result.append(collectKeyItems(child));
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <QList>
+#include <QSet>
+#include <QSharedPointer>
+#include <functional>
+
+#include "connections-tree/items/databaseitem.h"
+#include "connections-tree/items/keyitem.h"
+#include "connections-tree/model.h"
+#include "connections-tree/operations.h"
+
+namespace BenchUtils {
+
+/*
+ * Synthetic keyspace: namespacedPercent of keys are placed in namespaces
+ * nested up to depth levels with fanout child namespaces on each level,
+ * the rest of keys have no separators.
+ */
+struct Keyspace {
+  int keysCount;
+  int depth;
+  int fanout;
+  int namespacedPercent;
+
+  QList<QByteArray> generate(bool sorted = true) const;
+};
+
+// Namespaces of keys nested up to maxDepth levels, used to expand them
+QSet<QByteArray> namespaces(const QList<QByteArray>& keys, int maxDepth);
+
+// Adds "keyspace" column with keyspaces of varying size, depth and
+// separator density
+void addKeyspaceRows();
+
+/*
+ * Model with the database item attached to a root item, so items have
+ * model indexes and owners of async callbacks are alive.
+ */
+class Tree {
+ public:
+  Tree(QSharedPointer<ConnectionsTree::Operations> operations, int keysCount);
+
+  ~Tree();
+
+  ConnectionsTree::Model& model();
+
+  QSharedPointer<ConnectionsTree::DatabaseItem> db() const;
+
+  QModelIndex dbIndex();
+
+ private:
+  class BenchModel;
+  class RootItem;
+
+  QScopedPointer<BenchModel> m_model;
+  QSharedPointer<RootItem> m_root;
+};
+
+// Processes events until the condition is met or timeout is reached
+bool waitFor(std::function<bool()> condition, int timeout = 60000);
+
+// Key items rendered in the subtree, flyweight rows are materialized
+QList<QWeakPointer<ConnectionsTree::KeyItem>> collectKeyItems(
+    QSharedPointer<ConnectionsTree::TreeItem> item);
+
+}  // namespace BenchUtils
+
+Q_DECLARE_METATYPE(BenchUtils::Keyspace)
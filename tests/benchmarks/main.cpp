@@ -0,0 +1,126 @@
+#include <QApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTest>
+
+#include <qredisclient/redisclient.h>
+#include "bench_keysrendering.h"
+#include "bench_keyssorting.h"
+#include "bench_treeitems.h"
+
+namespace {
+
+/*
+ * With "-resultsdir <dir>" results of each benchmark class are saved to
+ * <dir>/<class>.csv and merged into <dir>/benchmarks.json, so results of
+ * different releases can be compared.
+ */
+QString takeResultsDir(QStringList &args) {
+  int pos = args.indexOf("-resultsdir");
+
+  if (pos < 0 || pos + 1 >= args.size()) return QString();
+
+  QString dir = args.at(pos + 1);
+  args.removeAt(pos + 1);
+  args.removeAt(pos);
+
+  return dir;
+}
+
+int runBenchmark(QObject *benchmark, QStringList args,
+                 const QString &resultsDir) {
+  QScopedPointer<QObject> cleanup(benchmark);
+
+  if (!resultsDir.isEmpty()) {
+    args << "-o"
+         << QString("%1/%2.csv,csv")
+                .arg(resultsDir)
+                .arg(benchmark->metaObject()->className());
+  }
+
+  return QTest::qExec(benchmark, args);
+}
+
+// "function","tag","metric",value_per_iteration,total,iterations
+QJsonArray parseCsvResults(const QString &suite, const QString &path) {
+  QJsonArray results;
+  QFile file(path);
+
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return results;
+
+  QRegularExpression line(
+      "^\"([^\"]*)\",\"([^\"]*)\",\"([^\"]*)\",([^,]+),([^,]+),(\\d+)$");
+
+  while (!file.atEnd()) {
+    auto match = line.match(QString::fromUtf8(file.readLine()).trimmed());
+
+    if (!match.hasMatch()) continue;
+
+    results.append(QJsonObject{{"suite", suite},
+                               {"benchmark", match.captured(1)},
+                               {"tag", match.captured(2)},
+                               {"metric", match.captured(3)},
+                               {"value", match.captured(4).toDouble()},
+                               {"iterations", match.captured(6).toInt()}});
+  }
+
+  return results;
+}
+
+void saveJsonResults(const QString &resultsDir, const QStringList &suites) {
+  QJsonArray results;
+
+  for (const auto &suite : suites) {
+    const auto suiteResults = parseCsvResults(
+        suite, QString("%1/%2.csv").arg(resultsDir).arg(suite));
+
+    for (const auto &result : suiteResults) results.append(result);
+  }
+
+  QJsonObject report{
+      {"date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+      {"qt", QString(qVersion())},
+      {"results", results}};
+
+  QFile file(QString("%1/benchmarks.json").arg(resultsDir));
+
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning() << "Cannot save benchmark results to" << file.fileName();
+    return;
+  }
+
+  file.write(QJsonDocument(report).toJson());
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  QApplication app(argc, argv);
+
+  initRedisClient();
+
+  QStringList args = app.arguments();
+  QString resultsDir = takeResultsDir(args);
+
+  if (!resultsDir.isEmpty()) QDir().mkpath(resultsDir);
+
+  int allBenchmarksResult = 0
+                            // connections-tree module
+                            + runBenchmark(new BenchKeysRendering, args, resultsDir)
+                            + runBenchmark(new BenchKeysSorting, args, resultsDir)
+                            + runBenchmark(new BenchTreeItems, args, resultsDir)
+                            ;
+
+  if (!resultsDir.isEmpty()) {
+    saveJsonResults(resultsDir, {"BenchKeysRendering", "BenchKeysSorting",
+                                 "BenchTreeItems"});
+  }
+
+  return (allBenchmarksResult != 0) ? 1 : 0;
+}
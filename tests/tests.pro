@@ -1,3 +1,4 @@
 TEMPLATE = subdirs
 SUBDIRS = unit_tests \
           qml_tests \
+          benchmarks \
@@ -9,10 +9,22 @@
 #include "testcases/app/test_keymodels.h"
 #include "testcases/app/test_treeoperations.h"
 #include "testcases/app/test_apputils.h"
+#include "testcases/connections-tree/test_abstractnamespaceitem.h"
 #include "testcases/connections-tree/test_databaseitem.h"
+#include "testcases/connections-tree/test_globmatcher.h"
+#include "testcases/connections-tree/test_keysdiskcache.h"
+#include "testcases/connections-tree/test_keysmetadata.h"
+#include "testcases/connections-tree/test_keyssnapshot.h"
+#include "testcases/connections-tree/test_keyssorting.h"
+#include "testcases/connections-tree/test_memorybudget.h"
+#include "testcases/connections-tree/test_memorysampling.h"
 #include "testcases/connections-tree/test_model.h"
+#include "testcases/connections-tree/test_rawkeys.h"
+#include "testcases/connections-tree/test_scanresultscache.h"
 #include "testcases/connections-tree/test_serveritem.h"
 #include "testcases/console/test_consolemodel.h"
+#include "testcases/value-editor/test_pagedtextmodel.h"
+#include "testcases/value-editor/test_valueviewmodel.h"
 
 int main(int argc, char *argv[]) {
   QApplication app(argc, argv);
@@ -24,12 +36,27 @@ int main(int argc, char *argv[]) {
 #ifndef Q_OS_WIN
                        + QTest::qExec(new TestServerItem, argc, argv)
                        + QTest::qExec(new TestDatabaseItem, argc, argv)
+                       + QTest::qExec(new TestAbstractNamespaceItem, argc, argv)
+                       + QTest::qExec(new TestKeysMetadataPrefetcher, argc,
+                                      argv)
 #endif
                        + QTest::qExec(new TestModel, argc, argv)
+                       + QTest::qExec(new TestRawKeys, argc, argv)
+                       + QTest::qExec(new TestKeysSorting, argc, argv)
+                       + QTest::qExec(new TestKeysSnapshot, argc, argv)
+                       + QTest::qExec(new TestMemorySampling, argc, argv)
+                       + QTest::qExec(new TestKeysDiskCache, argc, argv)
+                       + QTest::qExec(new TestMemoryBudget, argc, argv)
+                       + QTest::qExec(new TestGlobMatcher, argc, argv)
+                       + QTest::qExec(new TestScanResultsCache, argc, argv)
 
                        // console module
                        + QTest::qExec(new TestConsoleOperations, argc, argv)
 
+                       // value-editor module
+                       + QTest::qExec(new TestValueViewModel, argc, argv)
+                       + QTest::qExec(new TestPagedTextModel, argc, argv)
+
                        // app
                        + QTest::qExec(new TestConnectionsManager, argc, argv)
                        + QTest::qExec(new TestConfigManager, argc, argv)
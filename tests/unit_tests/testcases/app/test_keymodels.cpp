@@ -151,6 +151,7 @@ void TestKeyModels::testValueLoading_data() {
   QTest::newRow("Valid string model")
       << (QStringList() << "+string\r\n"
                         << ":-1\r\n"
+                        << ":17\r\n"
                         << "$17\r\n__nice_test_data!\r\n")
       << 0 << Qt::UserRole + 1 << (unsigned long)1 << false
       << "__nice_test_data!" << (QStringList() << "value");
@@ -249,6 +250,7 @@ void TestKeyModels::testKeyModelModifyRows_data() {
   QTest::newRow("Valid string model")
       << (QStringList() << "+string\r\n"
                         << ":-1\r\n"
+                        << ":17\r\n"
                         << "$17\r\n__nice_test_data!\r\n"
                         << "+OK\r\n")
       << stringRow << Qt::UserRole + 1;
@@ -306,6 +308,166 @@ void TestKeyModels::testKeyModelModifyRows_data() {
       << hashRow << Qt::UserRole + 3;
 }
 
+void TestKeyModels::testRowCache() {
+  // given
+  auto rows = [](RowIndex start) {
+    QList<QByteArray> result;
+    for (RowIndex i = start; i < start + 256; i++)
+      result.append(QByteArray("row") + QByteArray::number(i));
+    return result;
+  };
+
+  // Two pages fit the limit
+  PagedRowCache<QByteArray> cache(25000);
+
+  // when
+  cache.addLoadedRange({0, 255}, rows(0));
+  cache.addLoadedRange({256, 511}, rows(256));
+  cache.getRow(0);
+  cache.addLoadedRange({512, 767}, rows(512));
+
+  // then
+  QCOMPARE(cache.isRowLoaded(0), true);
+  QCOMPARE(cache.isRowLoaded(300), false);
+  QCOMPARE(cache.getRow(600), QByteArray("row600"));
+  QCOMPARE(cache.getRow(-1), QByteArray());
+  QCOMPARE(cache.size(), 512ull);
+  QVERIFY(cache.usedMemory() <= 25000);
+
+  // when
+  cache.removeAt(0);
+
+  // then
+  QCOMPARE(cache.getRow(0), QByteArray("row1"));
+  QCOMPARE(cache.isRowLoaded(255), false);
+  QCOMPARE(cache.getRow(511), QByteArray("row512"));
+  QCOMPARE(cache.isValid(), false);
+
+  // when
+  // Memory reserved by an index of the rows takes the place of one page
+  cache.setReservedMemory(10000);
+  cache.addLoadedRange({0, 255}, rows(0));
+  cache.addLoadedRange({256, 511}, rows(256));
+
+  // then
+  QCOMPARE(cache.isRowLoaded(0), false);
+  QCOMPARE(cache.isRowLoaded(256), true);
+  QVERIFY(cache.usedMemory() + 10000 <= 25000);
+}
+
+void TestKeyModels::testScanCheckpoints() {
+  // given
+  auto dummyConnection = getRealConnectionWithDummyTransporter(
+      QStringList() << "+hash\r\n"
+                    << ":-1\r\n"
+                    << ":2\r\n"
+                    << "*2\r\n$1\r\n5\r\n*2\r\n$3\r\nfoo\r\n$1\r\n1\r\n"
+                    << "*2\r\n$1\r\n0\r\n*2\r\n$3\r\nbar\r\n$1\r\n2\r\n"
+                    << "*2\r\n$1\r\n0\r\n*2\r\n$3\r\nbar\r\n$1\r\n2\r\n");
+  QSharedPointer<ValueEditor::Model> keyModel = getKeyModel(dummyConnection);
+  QVERIFY(keyModel.isNull() == false);
+  int keyRole = keyModel->getRoles().key("key");
+  unsigned long loadedRows = 0;
+
+  // when
+  keyModel->loadRowsCount([keyModel, &loadedRows](QString) {
+    keyModel->loadRows(1, 1, [&loadedRows](const QString&, unsigned long rows) {
+      loadedRows = rows;
+    });
+  });
+  wait(500);
+
+  // then
+  QCOMPARE(loadedRows, 1ul);
+  QCOMPARE(keyModel->isRowLoaded(0), true);
+  QCOMPARE(keyModel->getData(1, keyRole).toString(), QString("bar"));
+
+  // when
+  loadedRows = 0;
+  keyModel->clearRowCache();
+  keyModel->loadRows(1, 1, [&loadedRows](const QString&, unsigned long rows) {
+    loadedRows = rows;
+  });
+  wait(500);
+
+  // then
+  // Page is loaded from the checkpoint without scanning previous rows
+  QCOMPARE(loadedRows, 1ul);
+  QCOMPARE(keyModel->isRowLoaded(0), false);
+  QCOMPARE(keyModel->getData(1, keyRole).toString(), QString("bar"));
+}
+
+void TestKeyModels::testMatchFilter() {
+  // given
+  auto dummyConnection = getRealConnectionWithDummyTransporter(
+      QStringList() << "+hash\r\n"
+                    << ":-1\r\n"
+                    << ":4\r\n"
+                    << "*2\r\n$1\r\n5\r\n*2\r\n$3\r\nfoo\r\n$1\r\n1\r\n"
+                    << "*2\r\n$1\r\n0\r\n*4\r\n$3\r\nfoo\r\n$1\r\n1\r\n"
+                       "$3\r\nfiz\r\n$1\r\n2\r\n"
+                    << "*2\r\n$1\r\n0\r\n*4\r\n$3\r\nfoo\r\n$1\r\n1\r\n"
+                       "$3\r\nfiz\r\n$1\r\n2\r\n");
+  QSharedPointer<ValueEditor::Model> keyModel = getKeyModel(dummyConnection);
+  QVERIFY(keyModel.isNull() == false);
+  int keyRole = keyModel->getRoles().key("key");
+  double progress = 0;
+  QObject::connect(keyModel->getConnector().data(),
+                   &ValueEditor::ModelSignals::matchesLoaded,
+                   [&progress](double p) { progress = p; });
+
+  // when
+  keyModel->setFilter("match", "f*");
+  keyModel->loadRowsCount([](QString) {});
+  wait(500);
+
+  // then
+  // Element returned by SCAN twice is shown once
+  QCOMPARE(progress, 1.0);
+  QCOMPARE(keyModel->rowsCount(), 2ul);
+  QCOMPARE(keyModel->getData(0, keyRole).toString(), QString("foo"));
+  QCOMPARE(keyModel->getData(1, keyRole).toString(), QString("fiz"));
+  QVERIFY(keyModel->rowsCacheMemory() > 0);
+
+  // when
+  // Evicted row is reloaded from the checkpoint of the second batch
+  keyModel->clearRowCache();
+  keyModel->loadRows(1, 1, [](const QString&, unsigned long) {});
+  wait(500);
+
+  // then
+  // Duplicate is skipped on reload too, so the row keeps its position
+  QCOMPARE(keyModel->isRowLoaded(0), false);
+  QCOMPARE(keyModel->getData(1, keyRole).toString(), QString("fiz"));
+}
+
+void TestKeyModels::testStringStreaming() {
+  // given
+  auto dummyConnection = getRealConnectionWithDummyTransporter(
+      QStringList() << "+string\r\n"
+                    << ":-1\r\n"
+                    << ":300000000\r\n"
+                    << "$3\r\nfoo\r\n");
+  QSharedPointer<ValueEditor::Model> keyModel = getKeyModel(dummyConnection);
+  QVERIFY(keyModel.isNull() == false);
+  int valueRole = keyModel->getRoles().key("value");
+  int sizeRole = keyModel->getRoles().key("streamedSize");
+
+  // when
+  keyModel->loadRows(0, 1, [](const QString&, unsigned long) {});
+  wait(500);
+
+  // then
+  // Only the first window is loaded instead of the whole value
+  QCOMPARE(keyModel->getData(0, valueRole).toString(), QString("foo"));
+  QCOMPARE(keyModel->getData(0, sizeRole).toLongLong(), 300000000ll);
+
+  auto streamedValue =
+      qobject_cast<QAbstractItemModel*>(keyModel->getStreamedValue(0));
+  QVERIFY(streamedValue != nullptr);
+  QCOMPARE(streamedValue->rowCount(), 6000);
+}
+
 QSharedPointer<ValueEditor::Model> TestKeyModels::getKeyModel(
     QSharedPointer<RedisClient::Connection> connection) {
   QSharedPointer<ValueEditor::Model> actualResult;
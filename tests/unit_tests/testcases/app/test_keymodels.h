@@ -19,6 +19,14 @@ private slots:
     void testKeyModelModifyRows();
     void testKeyModelModifyRows_data();
 
+    void testRowCache();
+
+    void testScanCheckpoints();
+
+    void testMatchFilter();
+
+    void testStringStreaming();
+
 private:
     QSharedPointer<ValueEditor::Model> getKeyModel(QSharedPointer<RedisClient::Connection> connection);
 };
@@ -3,6 +3,7 @@
 #include <fakeit.hpp>
 
 #include "app/events.h"
+#include "common/clusterkeysloader.h"
 #include "connections-tree/items/databaseitem.h"
 #include "connections-tree/model.h"
 #include "models/connectionconf.h"
@@ -119,6 +120,107 @@ void TestTreeOperations::testLoadNamespaceItems_data() {
       << (QStringList() << "+OK\r\n");
 }
 
+void TestTreeOperations::testLoadNamespaceItemsIncrementally() {
+  // given
+  auto events = QSharedPointer<Events>(new Events());
+  auto connection = getFakeConnection();
+  connection->setFakeResponses(
+      QStringList() << "*2\r\n$2\r\n17\r\n*1\r\n$4\r\ntest\r\n"
+                    << "*2\r\n$1\r\n0\r\n*1\r\n$5\r\ntest2\r\n");
+
+  QSharedPointer<TreeOperations> operations(
+      new TreeOperations(getDummyConfig(), events));
+  operations->setConnection(connection);
+
+  // Fake callback
+  QList<RedisClient::Connection::RawKeysList> batches;
+  bool finished = false;
+  Mock<TreeItem> fake;
+  TreeItem& owner = fake.get();
+  auto fakeOwner = QSharedPointer<TreeItem>(&owner, fakeDeleter<TreeItem>);
+
+  auto callback = QSharedPointer<Operations::LoadNamespaceItemsBatchCallback>(
+      new Operations::LoadNamespaceItemsBatchCallback(
+          fakeOwner, [&batches, &finished](
+                         const RedisClient::Connection::RawKeysList& r,
+                         const QString&, bool lastBatch) {
+            batches.append(r);
+            finished = lastBatch;
+          }));
+
+  // when
+  operations->loadNamespaceItemsIncrementally(0, QString("*"), callback);
+
+  // then
+  wait(5);
+  QCOMPARE(batches.size(), 2);
+  QCOMPARE(batches.first(), RedisClient::Connection::RawKeysList{"test"});
+  QCOMPARE(batches.last(), RedisClient::Connection::RawKeysList{"test2"});
+  QCOMPARE(finished, true);
+  QCOMPARE(connection->runCommandCalled, 2u);
+  QCOMPARE(connection->executedCommands[1].getPartAsString(1), QString("17"));
+}
+
+void TestTreeOperations::testClusterKeysMerge() {
+  // given
+  QList<RedisClient::Connection::RawKeysList> nodesKeys{
+      {"a", "c", "e"}, {}, {"b", "c", "f"}, {"d"}};
+
+  // when
+  auto keys = ClusterKeysLoader::merge(nodesKeys);
+
+  // then
+  QCOMPARE(keys, RedisClient::Connection::RawKeysList(
+                     {"a", "b", "c", "d", "e", "f"}));
+}
+
+void TestTreeOperations::testLoadNamespacesSummary() {
+  // given
+  auto events = QSharedPointer<Events>(new Events());
+  auto connection = getFakeConnection();
+  connection->setFakeResponses(
+      QStringList()
+      << "*3\r\n$2\r\n42\r\n*1\r\n$4\r\ntest\r\n"
+         "*4\r\n$2\r\nns\r\n:2\r\n$5\r\nns:ns\r\n:1\r\n"
+      << "*3\r\n$1\r\n0\r\n*0\r\n*2\r\n$2\r\nns\r\n:3\r\n");
+
+  QSharedPointer<TreeOperations> operations(
+      new TreeOperations(getDummyConfig(), events));
+  operations->setConnection(connection);
+
+  // Fake callback
+  RedisClient::Connection::RawKeysList keys;
+  Operations::NamespacesSummary summary;
+  QString error;
+  Mock<TreeItem> fake;
+  TreeItem& owner = fake.get();
+  auto fakeOwner = QSharedPointer<TreeItem>(&owner, fakeDeleter<TreeItem>);
+
+  auto callback = QSharedPointer<Operations::LoadNamespacesSummaryCallback>(
+      new Operations::LoadNamespacesSummaryCallback(
+          fakeOwner, [&keys, &summary, &error](
+                         const RedisClient::Connection::RawKeysList& k,
+                         const Operations::NamespacesSummary& s,
+                         const QString& err) {
+            keys = k;
+            summary = s;
+            error = err;
+          }));
+
+  // when
+  operations->loadNamespacesSummary(0, QString("*"), 0, 2, callback);
+
+  // then
+  wait(5);
+  QCOMPARE(error, QString());
+  QCOMPARE(keys, RedisClient::Connection::RawKeysList{"test"});
+  QCOMPARE(summary.value("ns"), 5ll);
+  QCOMPARE(summary.value("ns:ns"), 1ll);
+  QCOMPARE(connection->runCommandCalled, 2u);
+  QCOMPARE(connection->executedCommands[1].getPartAsString(0), QString("EVAL"));
+  QCOMPARE(connection->executedCommands[1].getPartAsString(3), QString("42"));
+}
+
 void TestTreeOperations::testFlushDb() {
   // given
   auto events = QSharedPointer<Events>(new Events());
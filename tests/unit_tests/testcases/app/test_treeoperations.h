@@ -14,6 +14,12 @@ private slots:
     void testLoadNamespaceItems();
     void testLoadNamespaceItems_data();
 
+    void testLoadNamespaceItemsIncrementally();
+
+    void testClusterKeysMerge();
+
+    void testLoadNamespacesSummary();
+
     void testFlushDb();
     void testFlushDbCommandError();
 };
@@ -8,6 +8,17 @@ HEADERS  += \
     $$CONNECTIONS_TREE_SRC_DIR/operations.h \
     $$CONNECTIONS_TREE_SRC_DIR/utils.h \
     $$CONNECTIONS_TREE_SRC_DIR/keysrendering.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysindex.h \
+    $$CONNECTIONS_TREE_SRC_DIR/globmatcher.h \
+    $$CONNECTIONS_TREE_SRC_DIR/scanresultscache.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssorting.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssnapshot.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysmetadata.h \
+    $$CONNECTIONS_TREE_SRC_DIR/keysdiskcache.h \
+    $$CONNECTIONS_TREE_SRC_DIR/rawkeys.h \
+    $$CONNECTIONS_TREE_SRC_DIR/itemhandles.h \
+    $$CONNECTIONS_TREE_SRC_DIR/memorysampling.h \
+    $$CONNECTIONS_TREE_SRC_DIR/memorybudget.h \
     $$CONNECTIONS_TREE_SRC_DIR/model.h \
 
 SOURCES += \
@@ -16,4 +27,15 @@ SOURCES += \
     $$files($$CONNECTIONS_TREE_SRC_DIR/items/*.cpp) \
     $$CONNECTIONS_TREE_SRC_DIR/utils.cpp \
     $$CONNECTIONS_TREE_SRC_DIR/keysrendering.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysindex.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/globmatcher.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/scanresultscache.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssorting.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keyssnapshot.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysmetadata.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/keysdiskcache.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/rawkeys.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/itemhandles.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/memorysampling.cpp \
+    $$CONNECTIONS_TREE_SRC_DIR/memorybudget.cpp \
     $$CONNECTIONS_TREE_SRC_DIR/model.cpp \
@@ -11,6 +11,8 @@ Mock<ConnectionsTree::Operations> getOperations() {
   When(Method(operations, mode)).AlwaysReturn("default");
   When(Method(operations, disconnect)).Return();
   When(Method(operations, notifyDbWasUnloaded)).Return();
+  When(Method(operations, invalidateScanResults)).AlwaysReturn();
+  When(Method(operations, scanResultsMemory)).AlwaysReturn(0);
   return operations;
 }
 
@@ -39,7 +41,9 @@ Mock<ConnectionsTree::Operations> getOperationsWithDbAndKeys(
               uint, const QString &,
               QSharedPointer<
                   ConnectionsTree::Operations::LoadNamespaceItemsCallback>
-                  cb) -> void { cb->rawCallback()(keys, err); });
+                  cb,
+              QSharedPointer<ConnectionsTree::Operations::ScanProgressCallback>)
+              -> void { cb->rawCallback()(keys, err); });
 
   return op;
 }
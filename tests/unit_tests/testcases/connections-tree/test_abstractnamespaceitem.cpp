@@ -0,0 +1,132 @@
+#include "test_abstractnamespaceitem.h"
+
+#include <QTest>
+#include <algorithm>
+
+#include "connections-tree/items/databaseitem.h"
+#include "connections-tree/items/namespaceitem.h"
+#include "connections-tree/keysrendering.h"
+#include "connections-tree/model.h"
+#include "mocks.h"
+
+using namespace ConnectionsTree;
+
+void TestAbstractNamespaceItem::testCollationOrder() {
+  // given
+  // Mixed case, Latin-1, a BMP character above surrogates and an emoji:
+  // bytewise UTF-8 order differs from the QString order for the last two
+  RedisClient::Connection::RawKeysList keys{
+      "b",  "B",           "a",           "A",           "\xc3\xa4",
+      "Z",  "\xc3\xa9",    "\xef\xbd\xa1", "\xf0\x9f\x98\x80", "a1",
+      "a_", "\xc3\x84"};
+
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<DatabaseItem> inserted(
+      new DatabaseItem(0, keys.size(), ptr, QWeakPointer<TreeItem>(), model));
+  QSharedPointer<DatabaseItem> rendered(
+      new DatabaseItem(0, keys.size(), ptr, QWeakPointer<TreeItem>(), model));
+
+  KeysTreeRenderer::RenderingSettigns settings{
+      QRegExp("*", Qt::CaseSensitive, QRegExp::Wildcard), ":", 0, 1000, true,
+      false, false};
+
+  // when
+  for (const auto& key : keys) inserted->insertKey(key);
+
+  auto sortedKeys = keys;
+  std::sort(sortedKeys.begin(), sortedKeys.end());
+  KeysTreeRenderer::renderNamespaceTrie(
+      ptr,
+      KeysTreeRenderer::buildNamespaceTrie(sortedKeys, 0, settings,
+                                           QSet<QByteArray>()),
+      rendered, settings);
+
+  // then
+  QStringList insertedNames;
+  QStringList renderedNames;
+
+  for (int row = 0; row < keys.size(); row++) {
+    insertedNames.append(inserted->child(row)->getDisplayName());
+    renderedNames.append(rendered->child(row)->getDisplayName());
+  }
+
+  QStringList expected = insertedNames;
+  std::sort(expected.begin(), expected.end());
+
+  QCOMPARE(insertedNames, expected);
+  QCOMPARE(renderedNames, expected);
+  QVERIFY(insertedNames.indexOf("A") < insertedNames.indexOf("a"));
+  QVERIFY(insertedNames.indexOf("Z") < insertedNames.indexOf("a"));
+}
+
+void TestAbstractNamespaceItem::testMaterializeFlyweightRow() {
+  // given
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<DatabaseItem> db(
+      new DatabaseItem(0, 3, ptr, QWeakPointer<TreeItem>(), model));
+  QSharedPointer<NamespaceItem> ns(
+      new NamespaceItem("ns", ptr, db.toWeakRef(), model, 0));
+  db->appendNamespace(ns);
+
+  ns->insertKey("ns:b");
+  ns->insertKey("ns:c");
+  ns->insertKey("ns:a");
+
+  // when
+  auto key = ns->child(1);
+
+  // then
+  QVERIFY(key);
+  QCOMPARE(key->type(), QString("key"));
+  QCOMPARE(key->getFullPath(), QByteArray("ns:b"));
+  QCOMPARE(key->row(), 1);
+  QVERIFY(key->parent().toStrongRef() == ns);
+  QVERIFY(ns->child(1) == key);
+  QCOMPARE(ns->indexOfChild(key.data()), 1);
+  QCOMPARE(ns->child(2)->getFullPath(), QByteArray("ns:c"));
+  QCOMPARE(ns->child(2)->row(), 2);
+}
+
+void TestAbstractNamespaceItem::testFlyweightCountersAndRemoval() {
+  // given
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<DatabaseItem> db(
+      new DatabaseItem(0, 4, ptr, QWeakPointer<TreeItem>(), model));
+  QSharedPointer<NamespaceItem> ns(
+      new NamespaceItem("ns", ptr, db.toWeakRef(), model, 0));
+  db->appendNamespace(ns);
+
+  // Rows are never accessed, so they stay flyweight
+  for (const auto& key :
+       RedisClient::Connection::RawKeysList{"ns:1", "ns:2", "ns:3", "ns:4"}) {
+    ns->appendKey(key, false);
+    db->appendKeyToIndex(key);
+  }
+
+  // then
+  QCOMPARE(ns->keysCount(), (uint)4);
+  QCOMPARE(db->keysCount(), (uint)4);
+  QCOMPARE(db->namespacesCount(), (uint)1);
+
+  // when
+  ns->removeObsoleteKeys({"ns:2", "ns:4", "ns:missing"});
+
+  // then
+  QCOMPARE(ns->childCount(), (uint)2);
+  QCOMPARE(ns->keysCount(), (uint)2);
+  QCOMPARE(db->keysCount(), (uint)2);
+  QCOMPARE(ns->keyRow("ns:1"), 0);
+  QCOMPARE(ns->keyRow("ns:3"), 1);
+  QCOMPARE(ns->keyRow("ns:2"), -1);
+  QCOMPARE(db->getKeysIndex().size(), 2);
+  QCOMPARE(ns->child(1)->getFullPath(), QByteArray("ns:3"));
+}
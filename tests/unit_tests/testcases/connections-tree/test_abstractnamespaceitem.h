@@ -0,0 +1,11 @@
+#pragma once
+#include <QObject>
+
+class TestAbstractNamespaceItem : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testCollationOrder();
+  void testMaterializeFlyweightRow();
+  void testFlyweightCountersAndRemoval();
+};
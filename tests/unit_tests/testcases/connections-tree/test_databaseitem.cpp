@@ -7,6 +7,7 @@
 
 #include <respbasetestcase.h>
 #include "connections-tree/items/databaseitem.h"
+#include "connections-tree/items/namespaceitem.h"
 #include "connections-tree/items/serveritem.h"
 #include "connections-tree/model.h"
 #include "mocks.h"
@@ -54,4 +55,114 @@ void TestDatabaseItem::testLoadKeys() {
   QCOMPARE(item->getAllChilds().isEmpty(), false);
   QCOMPARE(item->isEnabled(), true);
   QCOMPARE(item->isLocked(), false);
+
+  auto db = item.dynamicCast<DatabaseItem>();
+  QVERIFY(db);
+  QCOMPARE(db->namespacesCount(), (uint)2);
+  QVERIFY(db->rawKeysCount() > 0);
+  QVERIFY(db->rawKeysCount() < db->keysCount());
+
+  // Key items are created on access and reused afterwards
+  QSharedPointer<TreeItem> key;
+  for (const auto& child : item->getAllChilds()) {
+    if (child->type() == "key") {
+      key = child;
+      break;
+    }
+  }
+  QVERIFY(key);
+  QVERIFY(item->child(key->row()) == key);
+  QVERIFY(key->parent().toStrongRef() == item);
+}
+
+namespace {
+// Live update steps are triggered by the test instead of the timer
+class LiveUpdateDatabaseItem : public DatabaseItem {
+ public:
+  using DatabaseItem::DatabaseItem;
+  using DatabaseItem::performLiveUpdate;
+  using TreeItem::lock;
+};
+}  // namespace
+
+void TestDatabaseItem::testKeysCountErrorDuringVerify() {
+  // given
+  QList<QSharedPointer<Operations::GetDatabasesCallback>> dbCallbacks;
+
+  auto operations = getOperations();
+  When(Method(operations, getDatabases))
+      .AlwaysDo([&dbCallbacks](
+                    QSharedPointer<Operations::GetDatabasesCallback> cb)
+                    -> QFuture<void> {
+        dbCallbacks.append(cb);
+        return QFuture<void>();
+      });
+  When(Method(operations, loadNamespaceItems))
+      .AlwaysDo(
+          [](uint, const QString&,
+             QSharedPointer<Operations::LoadNamespaceItemsCallback> cb,
+             QSharedPointer<Operations::ScanProgressCallback>) -> void {
+            cb->rawCallback()(RedisClient::Connection::RawKeysList(),
+                              "Cannot scan keys");
+          });
+  When(Method(operations, enableKeyspaceEvents))
+      .AlwaysDo(
+          [](bool,
+             QSharedPointer<Operations::EnableKeyspaceEventsCallback> cb)
+              -> void { cb->rawCallback()(true, QString()); });
+  When(Method(operations, subscribeToKeyspaceEvents))
+      .AlwaysReturn(QFuture<void>());
+
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<LiveUpdateDatabaseItem> db(new LiveUpdateDatabaseItem(
+      0, 10, ptr, QWeakPointer<TreeItem>(), model));
+
+  // Subscription rescans keys once, failed SCAN releases the lock
+  db->setMetadata("live_update", true);
+  QCOMPARE(db->isLocked(), false);
+
+  // when
+  // Notifications are verified, meanwhile keys are loaded again
+  db->performLiveUpdate();
+  db->lock();
+  dbCallbacks.last()->rawCallback()(Operations::DbMapping(),
+                                    "Connection error");
+
+  // then
+  QCOMPARE(dbCallbacks.size(), 2);
+  QCOMPARE(db->isLocked(), true);
+}
+
+namespace {
+class UnloadableNamespaceItem : public NamespaceItem {
+ public:
+  using NamespaceItem::NamespaceItem;
+  using NamespaceItem::clear;
+};
+}  // namespace
+
+void TestDatabaseItem::testUnloadNamespaceKeepsSiblingKeys() {
+  // given
+  auto operations = getOperations();
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<DatabaseItem> db(
+      new DatabaseItem(0, 2, ptr, QWeakPointer<TreeItem>(), model));
+  QSharedPointer<UnloadableNamespaceItem> ns(
+      new UnloadableNamespaceItem("user", ptr, db.toWeakRef(), model, 0));
+
+  db->appendNamespace(ns);
+  db->appendKeyToIndex("user:1");
+  db->appendKeyToIndex("username:1");
+
+  // when
+  ns->clear();
+
+  // then
+  QCOMPARE(db->getKeysIndex().contains("username:1"), true);
+  QCOMPARE(db->getKeysIndex().contains("user:1"), false);
+  QCOMPARE(db->getKeysIndex().size(), 1);
 }
@@ -8,4 +8,6 @@ class TestDatabaseItem : public QObject {
 
  private slots:
   void testLoadKeys();  
+  void testKeysCountErrorDuringVerify();
+  void testUnloadNamespaceKeepsSiblingKeys();
 };
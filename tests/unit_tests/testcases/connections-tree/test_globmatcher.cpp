@@ -0,0 +1,29 @@
+#include "test_globmatcher.h"
+
+#include <QTest>
+
+#include "connections-tree/globmatcher.h"
+#include "connections-tree/rawkeys.h"
+
+using namespace ConnectionsTree;
+
+void TestGlobMatcher::testMatch() {
+  // given
+  RedisClient::Connection::RawKeysList keys;
+  for (int i = 0; i < 120000; i++) keys.append("user:" + QByteArray::number(i));
+  keys.append("user:[42]");
+
+  // when
+  auto filtered = GlobMatcher("user:4?2*").filter(RawKeys(keys));
+
+  // then
+  QCOMPARE(filtered.size(), 10 + 100 + 1000);
+  QCOMPARE(filtered.first(), QByteArray("user:402"));
+  QCOMPARE(GlobMatcher("user:*").prefix(), QByteArray("user:"));
+  QVERIFY(GlobMatcher("**").isMatchAll());
+  QVERIFY(GlobMatcher("user:\\[42]").match("user:[42]"));
+  QVERIFY(GlobMatcher("*:[^a-z]*[0-9]").match("user:42"));
+  QVERIFY(!GlobMatcher("*:[a-z]*").match("user:42"));
+  QVERIFY(GlobMatcher("*er*er*").match("user:order"));
+  QVERIFY(!GlobMatcher("*er*er*x").match("user:order"));
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <QObject>
+
+class TestGlobMatcher : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testMatch();
+};
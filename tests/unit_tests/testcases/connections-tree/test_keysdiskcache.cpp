@@ -0,0 +1,41 @@
+#include "test_keysdiskcache.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "connections-tree/keysdiskcache.h"
+
+using namespace ConnectionsTree;
+
+void TestKeysDiskCache::testSaveAndLoad() {
+  // given
+  QTemporaryDir cacheDir;
+  QString path = cacheDir.filePath("test-db0.keys");
+  RedisClient::Connection::RawKeysList keys{"a:1", "a:2", "b", "c:1"};
+
+  // when
+  bool saved = KeysDiskCache::save(path, RawKeys(keys));
+  auto snapshot = KeysDiskCache::load(path);
+
+  QFile corruptedFile(path);
+  corruptedFile.open(QIODevice::Append);
+  corruptedFile.write("d");
+  corruptedFile.close();
+
+  // then
+  QCOMPARE(saved, true);
+  QCOMPARE(snapshot.isValid(), true);
+  QCOMPARE(snapshot.keys().toList(), keys);
+  QCOMPARE(snapshot.diff({"a:1", "b", "c:1", "d"}).size(), 2);
+  QCOMPARE(KeysDiskCache::load(path).isValid(), false);
+  QCOMPARE(KeysDiskCache::load(cacheDir.filePath("missing")).isValid(), false);
+
+  // when
+  // Loaded snapshot doesn't keep the file open
+  KeysDiskCache::remove(path);
+
+  // then
+  QCOMPARE(QFile::exists(path), false);
+  QCOMPARE(snapshot.keys().toList(), keys);
+}
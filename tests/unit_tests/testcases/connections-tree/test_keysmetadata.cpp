@@ -0,0 +1,95 @@
+#include "test_keysmetadata.h"
+
+#include <QSettings>
+#include <QTest>
+
+#include "connections-tree/items/databaseitem.h"
+#include "connections-tree/items/keyitem.h"
+#include "connections-tree/keysmetadata.h"
+#include "connections-tree/model.h"
+#include "mocks.h"
+
+using namespace ConnectionsTree;
+
+void TestKeysMetadataPrefetcher::testPrefetch() {
+  // given
+  auto operations = getOperations();
+  QList<RedisClient::Connection::RawKeysList> requests;
+
+  When(Method(operations, getKeysMetadata))
+      .AlwaysDo(
+          [&requests](
+              const RedisClient::Connection::RawKeysList& keys, int,
+              QSharedPointer<Operations::GetKeysMetadataCallback> cb) {
+            requests.append(keys);
+
+            QList<Operations::KeyMetadata> metadata;
+            for (int i = 0; i < keys.size(); i++) {
+              Operations::KeyMetadata m;
+              m.type = "string";
+              m.ttl = i == 0 ? 500 : 1500;
+              metadata.append(m);
+            }
+            cb->rawCallback()(metadata);
+          });
+
+  auto ptr = QSharedPointer<Operations>(&operations.get(),
+                                        fakeDeleter<Operations>);
+  Model model;
+  QSharedPointer<DatabaseItem> db(
+      new DatabaseItem(0, 250, ptr, QWeakPointer<TreeItem>(), model));
+
+  for (int i = 0; i < 250; i++) {
+    db->appendKey(QByteArray("key:") + QByteArray::number(i), false);
+  }
+
+  KeysMetadataPrefetcher prefetcher;
+
+  // when
+  for (int i = 0; i < 250; i++) prefetcher.request(db->child(i));
+  prefetcher.request(db->child(249));
+  QTest::qWait(150);
+
+  // then - one batch with the most recently requested keys
+  QCOMPARE(requests.size(), 1);
+  QCOMPARE(requests.first().size(), 200);
+  QCOMPARE(requests.first().first(), QByteArray("key:50"));
+  QCOMPARE(db->child(0).staticCast<KeyItem>()->keyMetadataGeneration(),
+           (uint)0);
+  QVERIFY(db->child(50)->getDisplayName().contains("TTL: 500ms"));
+  QVERIFY(db->child(51)->getDisplayName().contains("TTL: 2s"));
+
+  // when - requests are rate limited
+  prefetcher.request(db->child(0));
+  QTest::qWait(150);
+
+  // then
+  QCOMPARE(requests.size(), 1);
+  QTest::qWait(500);
+  QCOMPARE(requests.size(), 2);
+  QCOMPARE(requests.last(), (RedisClient::Connection::RawKeysList{"key:0"}));
+
+  // when - invalidated metadata of visible keys is reloaded
+  prefetcher.invalidate();
+  QTest::qWait(600);
+
+  // then
+  QCOMPARE(prefetcher.generation(), (uint)2);
+  QCOMPARE(requests.size(), 3);
+  QCOMPARE(requests.last(), (RedisClient::Connection::RawKeysList{"key:0"}));
+  QCOMPARE(db->child(0).staticCast<KeyItem>()->keyMetadataGeneration(),
+           (uint)2);
+
+  // when - key requested while prefetching is disabled isn't skipped later
+  QSettings settings;
+  settings.setValue("app/keysMetadataPrefetch", false);
+  prefetcher.request(db->child(1));
+  QTest::qWait(600);
+  settings.remove("app/keysMetadataPrefetch");
+  prefetcher.request(db->child(1));
+  QTest::qWait(600);
+
+  // then
+  QCOMPARE(requests.size(), 4);
+  QCOMPARE(requests.last(), (RedisClient::Connection::RawKeysList{"key:1"}));
+}
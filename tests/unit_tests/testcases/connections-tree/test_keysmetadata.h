@@ -0,0 +1,9 @@
+#pragma once
+#include <QObject>
+
+class TestKeysMetadataPrefetcher : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testPrefetch();
+};
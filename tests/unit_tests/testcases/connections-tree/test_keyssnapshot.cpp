@@ -0,0 +1,48 @@
+#include "test_keyssnapshot.h"
+
+#include <QTest>
+
+#include "common/keyspacenotifications.h"
+#include "connections-tree/keyssnapshot.h"
+
+using namespace ConnectionsTree;
+
+void TestKeysSnapshot::testDiff() {
+  // given
+  RedisClient::Connection::RawKeysList oldKeys{"a:1", "a:2", "b", "c:1", "d"};
+  RedisClient::Connection::RawKeysList newKeys{"d", "a:2", "c:2", "a:0", "d",
+                                               "b", "e"};
+  KeysSnapshot::normalize(newKeys);
+  KeysSnapshot snapshot(oldKeys);
+
+  // when
+  auto diff = snapshot.diff(newKeys);
+
+  // then
+  QCOMPARE(newKeys.size(), 6);
+  QCOMPARE(diff.added,
+           (RedisClient::Connection::RawKeysList{"a:0", "c:2", "e"}));
+  QCOMPARE(diff.removed, (RedisClient::Connection::RawKeysList{"a:1", "c:1"}));
+  QCOMPARE(KeysSnapshot(newKeys).diff(newKeys).isEmpty(), true);
+}
+
+void TestKeysSnapshot::testApplyEvents() {
+  // given
+  KeysSnapshot snapshot(RedisClient::Connection::RawKeysList{"a", "b", "d"});
+  KeysSnapshot::Diff applied;
+
+  // when
+  auto next = snapshot.apply({"e", "b", "c", "e"}, {"a", "x"}, applied);
+
+  // then
+  QCOMPARE(next.keys().toList(),
+           (RedisClient::Connection::RawKeysList{"b", "c", "d", "e"}));
+  QCOMPARE(applied.added, (RedisClient::Connection::RawKeysList{"c", "e"}));
+  QCOMPARE(applied.removed, (RedisClient::Connection::RawKeysList{"a"}));
+  QCOMPARE(KeyspaceNotificationsListener::keyExistsAfter("expired"), false);
+  QCOMPARE(KeyspaceNotificationsListener::keyExistsAfter("hset"), true);
+  QCOMPARE(KeyspaceNotificationsListener::isEnabled("Ex"), false);
+  QCOMPARE(KeyspaceNotificationsListener::isEnabled(
+               KeyspaceNotificationsListener::requiredFlags("Ex")),
+           true);
+}
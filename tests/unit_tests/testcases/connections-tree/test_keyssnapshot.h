@@ -0,0 +1,10 @@
+#pragma once
+#include <QObject>
+
+class TestKeysSnapshot : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testDiff();
+  void testApplyEvents();
+};
@@ -0,0 +1,96 @@
+#include "test_keyssorting.h"
+
+#include <QTest>
+#include <algorithm>
+
+#include "connections-tree/keyssorting.h"
+
+using namespace ConnectionsTree;
+
+namespace {
+// Enough keys to use radix partitioning instead of a single std::sort
+const int KEYS_COUNT = 120000;
+
+RedisClient::Connection::RawKeysList sortedCopy(
+    RedisClient::Connection::RawKeysList keys) {
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+}  // namespace
+
+void TestKeysSorting::testSortMixedSegments() {
+  // given
+  RedisClient::Connection::RawKeysList keys;
+  for (int i = KEYS_COUNT; i > 0; i--) {
+    keys.append("user:" + QByteArray::number(i % 1000) + ":session:" +
+                QByteArray::number(i));
+
+    if (i % 10 == 0) keys.append("user:" + QByteArray::number(i % 1000));
+    if (i % 100 == 0) keys.append(QByteArray::number(i) + ":cart");
+  }
+  keys.append(RedisClient::Connection::RawKeysList{"user", "user:", "User:1",
+                                                  "user:10", "user:9",
+                                                  "user:9"});
+
+  // Common prefix is longer than the radix depth limit
+  QByteArray longPrefix(40, 'p');
+  for (int i = 0; i < KEYS_COUNT; i++) {
+    keys.append(longPrefix + QByteArray::number((i * 7919) % KEYS_COUNT));
+  }
+
+  auto expected = sortedCopy(keys);
+
+  // when
+  bool result = sortKeys(keys);
+
+  // then
+  QCOMPARE(result, true);
+  QCOMPARE(keys.size(), expected.size());
+  QVERIFY(keys == expected);
+  QVERIFY(keys.indexOf("user:10") < keys.indexOf("user:9"));
+  QVERIFY(keys.indexOf("User:1") < keys.indexOf("user"));
+}
+
+void TestKeysSorting::testSortBinaryKeys() {
+  // given
+  RedisClient::Connection::RawKeysList keys;
+  quint32 seed = 42;
+  for (int i = 0; i < KEYS_COUNT; i++) {
+    QByteArray key;
+    int size = i % 17;
+
+    for (int pos = 0; pos < size; pos++) {
+      seed = seed * 1103515245 + 12345;
+      // Few distinct leading bytes to get large radix buckets
+      key.append(static_cast<char>(pos == 0 ? (seed >> 16) % 3 : seed >> 16));
+    }
+    keys.append(key);
+  }
+  keys.append(RedisClient::Connection::RawKeysList{
+      QByteArray(), QByteArray(1, '\0'), QByteArray(2, '\0'),
+      QByteArray("\xff\xff", 2), QByteArray("\x7f\x80", 2)});
+
+  auto expected = sortedCopy(keys);
+
+  // when
+  bool result = sortKeys(keys);
+
+  // then
+  QCOMPARE(result, true);
+  QVERIFY(keys == expected);
+  QCOMPARE(keys.first(), QByteArray());
+  QCOMPARE(keys.last(), QByteArray("\xff\xff", 2));
+}
+
+void TestKeysSorting::testSortCanceled() {
+  // given
+  RedisClient::Connection::RawKeysList keys;
+  for (int i = 0; i < KEYS_COUNT; i++) keys.append(QByteArray::number(i));
+
+  // when
+  bool result = sortKeys(keys, []() { return true; });
+
+  // then - keys are kept
+  QCOMPARE(result, false);
+  QCOMPARE(keys.size(), KEYS_COUNT);
+}
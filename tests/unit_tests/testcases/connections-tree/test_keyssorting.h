@@ -0,0 +1,11 @@
+#pragma once
+#include <QObject>
+
+class TestKeysSorting : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testSortMixedSegments();
+  void testSortBinaryKeys();
+  void testSortCanceled();
+};
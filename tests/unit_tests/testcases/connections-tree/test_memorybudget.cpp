@@ -0,0 +1,31 @@
+#include "test_memorybudget.h"
+
+#include <QTest>
+
+#include "connections-tree/keysindex.h"
+#include "connections-tree/memorybudget.h"
+
+using namespace ConnectionsTree;
+
+void TestMemoryBudget::testPolicy() {
+  // given
+  MemoryBudget budget(1000);
+  KeysIndex index;
+  KeysIndex expectedIndex;
+  expectedIndex.insert("ns:bc");
+
+  // when
+  index.insert("ns:a");
+  index.insert("ns:a");
+  index.insert("ns:bc");
+  index.removePrefix("ns:a");
+
+  // then
+  QCOMPARE(budget.policy(100), MemoryBudget::Policy::None);
+  QCOMPARE(budget.policy(700), MemoryBudget::Policy::UnloadCollapsedKeys);
+  QCOMPARE(budget.policy(900), MemoryBudget::Policy::NamespacesSummary);
+  QCOMPARE(budget.policy(1200), MemoryBudget::Policy::StopLoading);
+  QCOMPARE(budget.available(1200), qint64(0));
+  QCOMPARE(MemoryBudget(0).policy(1200), MemoryBudget::Policy::None);
+  QCOMPARE(index.usedMemory(), expectedIndex.usedMemory());
+}
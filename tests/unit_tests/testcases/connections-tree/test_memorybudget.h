@@ -0,0 +1,9 @@
+#pragma once
+#include <QObject>
+
+class TestMemoryBudget : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testPolicy();
+};
@@ -0,0 +1,31 @@
+#include "test_memorysampling.h"
+
+#include <QTest>
+
+#include "connections-tree/memorysampling.h"
+#include "connections-tree/rawkeys.h"
+
+using namespace ConnectionsTree;
+
+void TestMemorySampling::testEstimate() {
+  // given
+  RedisClient::Connection::RawKeysList keys;
+  for (int i = 0; i < 100000; i++) keys.append(QByteArray::number(i));
+
+  // when
+  int sampleSize = MemorySampling::sampleSize(keys.size());
+  auto sample = MemorySampling::sample(RawKeys(keys), sampleSize);
+
+  QVector<qlonglong> sampleMemory;
+  for (const auto& key : qAsConst(sample)) sampleMemory.append(key.toLongLong() % 100);
+
+  auto estimate = MemorySampling::estimate(sampleMemory, keys.size());
+
+  // then
+  QCOMPARE(MemorySampling::sampleSize(1000), 1000);
+  QVERIFY(sampleSize < 2000);
+  QCOMPARE(sample.size(), sampleSize);
+  QVERIFY(estimate.margin > 0);
+  QVERIFY(qAbs(estimate.total - 4950000) <= estimate.margin * 2);
+  QCOMPARE(MemorySampling::combineMargins({3, 4}), 5);
+}
@@ -2,6 +2,52 @@
 #include "connections-tree/model.h"
 
 #include <QAbstractItemModelTester>
+#include <QtTest>
+
+using namespace ConnectionsTree;
+
+namespace {
+class DummyItem : public SortableTreeItem {
+ public:
+  DummyItem(Model &m, QWeakPointer<TreeItem> parent = QWeakPointer<TreeItem>())
+      : SortableTreeItem(m), m_parent(parent) {}
+
+  QString getDisplayName() const override { return "dummy"; }
+
+  QString type() const override { return "dummy"; }
+
+  QList<QSharedPointer<TreeItem>> getAllChilds() const override {
+    return m_childs;
+  }
+
+  uint childCount(bool) const override { return m_childs.size(); }
+
+  QSharedPointer<TreeItem> child(uint row) override {
+    return m_childs.value(row);
+  }
+
+  QWeakPointer<TreeItem> parent() const override { return m_parent; }
+
+  void unload() override { m_childs.clear(); }
+
+  void load(QSharedPointer<TreeItem> self, int count) {
+    for (int row = 0; row < count; ++row) {
+      auto item = QSharedPointer<DummyItem>(new DummyItem(m_model, self));
+      item->setRow(row);
+      m_childs.append(item);
+    }
+  }
+
+ private:
+  QWeakPointer<TreeItem> m_parent;
+  QList<QSharedPointer<TreeItem>> m_childs;
+};
+
+class DummyModel : public Model {
+ public:
+  void addItem(QSharedPointer<SortableTreeItem> item) { addRootItem(item); }
+};
+}  // namespace
 
 void TestModel::testLoadImplementation() {
   // Given
@@ -17,3 +63,39 @@ void TestModel::testLoadImplementation() {
   // No assertions
   Q_UNUSED(test);
 }
+
+void TestModel::testItemHandles() {
+  // Given
+  DummyModel model;
+  auto root = QSharedPointer<DummyItem>(new DummyItem(model));
+  model.addItem(root);
+
+  QModelIndex rootIndex = model.index(0, 0, QModelIndex());
+
+  const int childs = 10000;
+  const int cycles = 20;
+
+  for (int cycle = 0; cycle < cycles; ++cycle) {
+    // When
+    root->load(root, childs);
+
+    for (int row = 0; row < childs; ++row) {
+      QModelIndex index = model.index(row, 0, rootIndex);
+      QVERIFY(model.getItemFromIndex(index));
+      QCOMPARE(model.parent(index), rootIndex);
+    }
+
+    // Repeated calls reuse registered handles
+    QCOMPARE(model.index(1, 0, rootIndex).internalId(),
+             model.index(1, 0, rootIndex).internalId());
+
+    QModelIndex staleIndex = model.index(0, 0, rootIndex);
+    root->unload();
+
+    // Then
+    QVERIFY(model.getItemFromIndex(staleIndex) == nullptr);
+    QCOMPARE(model.itemHandles().size(), 1);
+    // Slots of destroyed items are released and reused without sweeps
+    QVERIFY(model.itemHandles().capacity() <= childs + 1);
+  }
+}
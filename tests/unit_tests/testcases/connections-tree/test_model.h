@@ -6,5 +6,6 @@ class TestModel : public QObject
     Q_OBJECT
 private slots:
     void testLoadImplementation();
+    void testItemHandles();
 };
 
@@ -0,0 +1,103 @@
+#include "test_rawkeys.h"
+
+#include <QTest>
+
+#include "connections-tree/rawkeys.h"
+
+using namespace ConnectionsTree;
+
+namespace {
+RedisClient::Connection::RawKeysList collect(const RawKeys& keys) {
+  RedisClient::Connection::RawKeysList result;
+  keys.forEach([&result](const QByteArray& key) { result.append(key); });
+  return result;
+}
+}  // namespace
+
+void TestRawKeys::testPack() {
+  // given
+  RedisClient::Connection::RawKeysList keys{"a", "", "bb:1", "ccc:2:3"};
+
+  // when
+  auto packed = RawKeys::pack(keys);
+
+  // then
+  QCOMPARE(packed.size(), 4);
+  QCOMPARE(packed.toList(), keys);
+  QCOMPARE(collect(packed), keys);
+  QCOMPARE(packed.mid(1, 2).toList(),
+           (RedisClient::Connection::RawKeysList{"", "bb:1"}));
+  QVERIFY(packed.usedMemory() > 0);
+  QCOMPARE(RawKeys::pack({}).isEmpty(), true);
+}
+
+void TestRawKeys::testSlicesOutliveSource() {
+  // given
+  RawKeys slice;
+
+  {
+    RedisClient::Connection::RawKeysList keys;
+    for (int i = 0; i < 10; i++) keys.append("key:" + QByteArray::number(i));
+
+    auto packed = RawKeys::pack(keys);
+
+    // when
+    slice = packed.mid(3, 4);
+  }
+
+  // then - source list and packed keys are destroyed
+  QCOMPARE(slice.size(), 4);
+  QCOMPARE(collect(slice), (RedisClient::Connection::RawKeysList{
+                               "key:3", "key:4", "key:5", "key:6"}));
+  QCOMPARE(slice.mid(3).toList(),
+           (RedisClient::Connection::RawKeysList{"key:6"}));
+}
+
+void TestRawKeys::testCountWithPrefix() {
+  // given
+  RedisClient::Connection::RawKeysList source{"a",    "ns:1", "ns:2",
+                                              "ns:3", "ns:4"};
+  RawKeys keys(QSharedPointer<const KeysArena>(new KeysArena(source, 0, 3)));
+  keys.append(
+      RawKeys(QSharedPointer<const KeysArena>(new KeysArena(source, 3, 5))));
+  keys.append(RawKeys(RedisClient::Connection::RawKeysList{"ns:5", "b"}));
+
+  // when - arenas are [a ns:1 ns:2] [ns:3 ns:4], then plain list [ns:5 b]
+  auto tail = keys.mid(2, 4);
+
+  // then
+  QCOMPARE(keys.size(), 7);
+  QCOMPARE(keys.countWithPrefix(0, "ns:"), 0);
+  QCOMPARE(keys.countWithPrefix(1, "ns:"), 5);
+  QCOMPARE(keys.countWithPrefix(2, "ns:"), 4);
+  QCOMPARE(keys.countWithPrefix(3, "ns:"), 3);
+  QCOMPARE(keys.countWithPrefix(5, "ns:"), 1);
+  QCOMPARE(keys.countWithPrefix(6, "ns:"), 0);
+  QCOMPARE(keys.countWithPrefix(7, "ns:"), 0);
+  QCOMPARE(tail.countWithPrefix(0, "ns:"), 4);
+  QCOMPARE(tail.toList(), (RedisClient::Connection::RawKeysList{
+                              "ns:2", "ns:3", "ns:4", "ns:5"}));
+}
+
+void TestRawKeys::testArenaCopiesBuffer() {
+  // given
+  QSharedPointer<const KeysArena> arena;
+
+  {
+    RedisClient::Connection::RawKeysList keys{"key:0", "", "key:2"};
+    QByteArray data = keys.join();
+    QVector<qint32> offsets{0};
+    for (const auto& key : qAsConst(keys))
+      offsets.append(offsets.last() + key.size());
+
+    // when - arena is built from a mapped file which is closed afterwards
+    arena = QSharedPointer<const KeysArena>(
+        new KeysArena(data.constData(), offsets.constData(), keys.size()));
+    data.fill('x');
+  }
+
+  // then
+  QCOMPARE(arena->size(), 3);
+  QCOMPARE(RawKeys(arena).toList(),
+           (RedisClient::Connection::RawKeysList{"key:0", "", "key:2"}));
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <QObject>
+
+class TestRawKeys : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testPack();
+  void testSlicesOutliveSource();
+  void testCountWithPrefix();
+  void testArenaCopiesBuffer();
+};
@@ -0,0 +1,33 @@
+#include "test_scanresultscache.h"
+
+#include <QTest>
+
+#include "connections-tree/globmatcher.h"
+#include "connections-tree/scanresultscache.h"
+
+using namespace ConnectionsTree;
+
+void TestScanResultsCache::testLookup() {
+  // given
+  ScanResultsCache cache;
+  RedisClient::Connection::RawKeysList keys{"user:1", "user:42", "user:420",
+                                            "user:5"};
+  RedisClient::Connection::RawKeysList filtered;
+
+  // when
+  cache.insert(0, "user:*", keys);
+  bool refined = cache.lookup(0, "user:42*", filtered);
+  bool wider = cache.contains(0, "*");
+  bool otherDb = cache.contains(1, "user:42*");
+  cache.invalidate(0);
+
+  // then
+  QCOMPARE(refined, true);
+  QCOMPARE(filtered, RedisClient::Connection::RawKeysList({"user:42", "user:420"}));
+  QCOMPARE(wider, false);
+  QCOMPARE(otherDb, false);
+  QCOMPARE(cache.contains(0, "user:42*"), false);
+  QVERIFY(GlobMatcher("user:42").isSubsetOf(GlobMatcher("user:4*")));
+  QVERIFY(!GlobMatcher("user:4*").isSubsetOf(GlobMatcher("user:42*")));
+  QVERIFY(!GlobMatcher("user:*").isSubsetOf(GlobMatcher("*:1")));
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <QObject>
+
+class TestScanResultsCache : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testLookup();
+};
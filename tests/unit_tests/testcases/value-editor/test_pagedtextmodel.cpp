@@ -0,0 +1,32 @@
+#include "test_pagedtextmodel.h"
+#include <QSignalSpy>
+#include <QtTest/QtTest>
+#include "value-editor/pagedtextmodel.h"
+
+void TestPagedTextModel::testMultibyteCharacterOnWindowBorder() {
+  // given
+  // Two-byte character starts at the last byte of the first window
+  QByteArray value("ab\xc3\xa9" "cd");
+  ValueEditor::PagedTextModel model(
+      value.size(),
+      [value](qint64 offset, qint64 size,
+              ValueEditor::PagedTextModel::WindowCallback c) {
+        c(QString(), value.mid(offset, size));
+      },
+      3);
+  QSignalSpy spy(&model, SIGNAL(searchFinished(QVariantList)));
+  int role = Qt::UserRole + 1;
+
+  // when
+  model.data(model.index(0), role);
+  model.data(model.index(1), role);
+  model.searchText(QString::fromUtf8("\xc3\xa9"));
+
+  // then
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.data(model.index(0), role).toString(),
+           QString::fromUtf8("ab\xc3\xa9"));
+  QCOMPARE(model.data(model.index(1), role).toString(), QString("cd"));
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.takeFirst().at(0).toList().at(2).toInt(), 2);
+}
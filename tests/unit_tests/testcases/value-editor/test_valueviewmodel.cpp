@@ -0,0 +1,230 @@
+#include "test_valueviewmodel.h"
+#include <QSignalSpy>
+#include <QtTest/QtTest>
+#include "value-editor/valueviewmodel.h"
+
+namespace {
+
+// Multi-row key with a row cache which is filled by the test, so requests
+// of the view model are completed in the order chosen by the test
+class FakeModel : public ValueEditor::Model {
+ public:
+  static const qint64 ROW_MEMORY = 100;
+
+  struct Request {
+    int start;
+    unsigned long count;
+    LoadRowsCallback callback;
+  };
+
+  FakeModel(unsigned long rowsCount, qint64 memoryLimit)
+      : m_rowsCount(rowsCount),
+        m_memoryLimit(memoryLimit),
+        m_notifier(new ValueEditor::ModelSignals()) {}
+
+  QString getKeyName() override { return "fake"; }
+  QString getKeyTitle(int) override { return "fake"; }
+  QString type() override { return "list"; }
+  long long getTTL() override { return -1; }
+  QStringList getColumnNames() override { return {"rowNumber", "value"}; }
+
+  QHash<int, QByteArray> getRoles() override {
+    return {{Qt::UserRole + 1, "rowNumber"}, {Qt::UserRole + 2, "value"}};
+  }
+
+  QVariant getData(int rowIndex, int) override {
+    return m_loaded.contains(rowIndex) ? QVariant(rowIndex) : QVariant();
+  }
+
+  void setKeyName(const QByteArray&, Callback c) override { c(QString()); }
+  void setTTL(const long long, Callback c) override { c(QString()); }
+  void persistKey(Callback c) override { c(QString()); }
+  void removeKey(Callback c) override { c(QString()); }
+  void addRow(const QVariantMap&, Callback c) override { c(QString()); }
+
+  void updateRow(int, const QVariantMap&, Callback c) override {
+    c(QString());
+  }
+
+  unsigned long rowsCount() override { return m_rowsCount; }
+
+  QVariant filter(const QString&) const override { return QVariant(); }
+  void setFilter(const QString&, QVariant) override {}
+
+  void loadRows(QVariant rowStart, unsigned long count,
+                LoadRowsCallback c) override {
+    requests.append(Request{rowStart.toInt(), count, c});
+  }
+
+  void clearRowCache() override { m_loaded.clear(); }
+
+  qint64 rowsCacheMemory() override { return m_loaded.size() * ROW_MEMORY; }
+
+  qint64 rowsCacheMemoryLimit() override { return m_memoryLimit; }
+
+  void removeRow(int, Callback c) override { c(QString()); }
+
+  bool isRowLoaded(int row) override { return m_loaded.contains(row); }
+
+  QObject* getStreamedValue(int) override { return nullptr; }
+  bool isMultiRow() const override { return true; }
+  void loadRowsCount(Callback c) override { c(QString()); }
+
+  QSharedPointer<ValueEditor::ModelSignals> getConnector() const override {
+    return m_notifier;
+  }
+
+  QSharedPointer<RedisClient::Connection> getConnection() const override {
+    return QSharedPointer<RedisClient::Connection>();
+  }
+
+  unsigned int dbIndex() const override { return 0; }
+  QString getDefaultFormatter() const override { return "auto"; }
+
+  // Loads rows of the oldest request and calls its callback
+  void completeRequest(int index = 0) {
+    Request r = requests.takeAt(index);
+    int end = qMin<int>(r.start + r.count, m_rowsCount);
+
+    for (int row = r.start; row < end; row++) m_loaded.insert(row);
+
+    completed.append(r.start);
+    r.callback(QString(), end - r.start);
+  }
+
+  void completeAll() {
+    while (!requests.isEmpty()) completeRequest();
+  }
+
+  void evictRows(int first, int last) {
+    for (int row = first; row <= last; row++) m_loaded.remove(row);
+  }
+
+  QList<int> requestedStarts() const {
+    QList<int> result;
+    for (const auto& r : requests) result.append(r.start);
+    return result;
+  }
+
+ public:
+  QList<Request> requests;
+  QList<int> completed;
+
+ private:
+  unsigned long m_rowsCount;
+  qint64 m_memoryLimit;
+  QSet<int> m_loaded;
+  QSharedPointer<ValueEditor::ModelSignals> m_notifier;
+};
+
+}  // namespace
+
+void TestValueViewModel::testPrefetchForward() {
+  // given
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, 0));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+
+  // when
+  viewModel.loadRows(0, 100);
+  model->completeAll();
+
+  // then
+  QCOMPARE(model->completed, (QList<int>{0, 100, 200}));
+  QVERIFY(!viewModel.isRowLoaded(300));
+}
+
+void TestValueViewModel::testPrefetchBackward() {
+  // given
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, 1024 * 1024));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+
+  viewModel.loadRows(500, 100);
+  model->completeAll();
+  model->completed.clear();
+
+  // when
+  viewModel.loadRows(400, 100);
+  model->completeAll();
+
+  // then
+  QCOMPARE(model->completed, (QList<int>{400, 300, 200}));
+}
+
+void TestValueViewModel::testPrefetchCancelledOnJump() {
+  // given
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, 0));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+
+  viewModel.loadRows(0, 100);
+  model->completeRequest();
+  QCOMPARE(model->requestedStarts(), (QList<int>{100}));
+
+  // when
+  viewModel.loadRows(700, 100);
+  model->completeAll();
+
+  // then
+  QCOMPARE(model->completed, (QList<int>{0, 100, 700, 800, 900}));
+}
+
+void TestValueViewModel::testPendingFrameHandoff() {
+  // given
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, 0));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+  QSignalSpy spy(&viewModel, SIGNAL(rowsLoaded(int,int)));
+
+  viewModel.loadRows(0, 100);
+  model->completeRequest();
+  spy.clear();
+
+  // when
+  viewModel.loadRows(100, 100);
+
+  // then
+  QCOMPARE(model->requestedStarts(), (QList<int>{100}));
+  QCOMPARE(spy.count(), 0);
+
+  model->completeRequest();
+
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(spy.takeFirst(), (QList<QVariant>{100, 100}));
+  QCOMPARE(model->requestedStarts(), (QList<int>{200}));
+}
+
+void TestValueViewModel::testPrefetchBudget() {
+  // given
+  // Frame and prefetched pages don't fit into the cache together
+  qint64 pageMemory = 100 * FakeModel::ROW_MEMORY;
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, pageMemory * 3));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+
+  // when
+  viewModel.loadRows(0, 100);
+  model->completeAll();
+
+  // then
+  QCOMPARE(model->completed, (QList<int>{0}));
+}
+
+void TestValueViewModel::testFrameWithEvictedPage() {
+  // given
+  auto model = QSharedPointer<FakeModel>(new FakeModel(1000, 0));
+  ValueEditor::ValueViewModel viewModel("test");
+  viewModel.setModel(model);
+
+  viewModel.loadRows(0, 500);
+  model->completeAll();
+  model->completed.clear();
+
+  // when
+  model->evictRows(256, 300);
+  viewModel.loadRows(0, 500);
+
+  // then
+  QCOMPARE(model->requestedStarts(), (QList<int>{0}));
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <QObject>
+
+class TestValueViewModel : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testPrefetchForward();
+  void testPrefetchBackward();
+  void testPrefetchCancelledOnJump();
+  void testPendingFrameHandoff();
+  void testPrefetchBudget();
+  void testFrameWithEvictedPage();
+};
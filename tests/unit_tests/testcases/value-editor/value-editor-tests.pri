@@ -2,7 +2,9 @@
 VALUEEDITOR_SRC_DIR = $$PWD/../../../../src/modules/value-editor/
 
 HEADERS  += \        
+    $$files($$PWD/test_*.h) \
     $$files($$VALUEEDITOR_SRC_DIR/*.h) \
 
 SOURCES += \    
+    $$files($$PWD/test_*.cpp) \
     $$files($$VALUEEDITOR_SRC_DIR/*.cpp) \